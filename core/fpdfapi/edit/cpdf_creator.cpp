@@ -9,6 +9,7 @@
 #include <algorithm>
 
 #include "core/fpdfapi/parser/cpdf_array.h"
+#include "core/fpdfapi/parser/cpdf_cross_ref_table.h"
 #include "core/fpdfapi/parser/cpdf_crypto_handler.h"
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
 #include "core/fpdfapi/parser/cpdf_document.h"
@@ -127,12 +128,21 @@ ByteString GenerateFileID(uint32_t dwSeed1, uint32_t dwSeed2) {
   return ByteString(pdfium::as_bytes<uint32_t>(buffer));
 }
 
-bool OutputIndex(IFX_ArchiveStream* archive, FX_FILESIZE offset) {
-  return archive->WriteByte(static_cast<uint8_t>(offset >> 24)) &&
-         archive->WriteByte(static_cast<uint8_t>(offset >> 16)) &&
-         archive->WriteByte(static_cast<uint8_t>(offset >> 8)) &&
-         archive->WriteByte(static_cast<uint8_t>(offset)) &&
-         archive->WriteByte(0);
+// Writes a cross-reference stream entry with a 4-byte offset and a
+// |gennum_size|-byte generation number.
+bool OutputIndex(IFX_ArchiveStream* archive,
+                 FX_FILESIZE offset,
+                 uint32_t gennum,
+                 uint32_t gennum_size) {
+  if (!archive->WriteByte(static_cast<uint8_t>(offset >> 24)) ||
+      !archive->WriteByte(static_cast<uint8_t>(offset >> 16)) ||
+      !archive->WriteByte(static_cast<uint8_t>(offset >> 8)) ||
+      !archive->WriteByte(static_cast<uint8_t>(offset))) {
+    return false;
+  }
+  if (gennum_size > 1 && !archive->WriteByte(static_cast<uint8_t>(gennum >> 8)))
+    return false;
+  return archive->WriteByte(static_cast<uint8_t>(gennum));
 }
 
 }  // namespace
@@ -148,13 +158,24 @@ CPDF_Creator::CPDF_Creator(CPDF_Document* pDoc,
 
 CPDF_Creator::~CPDF_Creator() = default;
 
-bool CPDF_Creator::WriteIndirectObj(uint32_t objnum, const CPDF_Object* pObj) {
-  if (!m_Archive->WriteDWord(objnum) || !m_Archive->WriteString(" 0 obj\r\n"))
+bool CPDF_Creator::WriteIndirectObj(uint32_t objnum,
+                                    uint32_t gennum,
+                                    const CPDF_Object* pObj) {
+  if (!m_Archive->WriteDWord(objnum) || !m_Archive->WriteString(" ") ||
+      !m_Archive->WriteDWord(gennum) || !m_Archive->WriteString(" obj\r\n")) {
     return false;
+  }
+
+  if (gennum)
+    m_ObjectGenNums[objnum] = gennum;
+  else
+    m_ObjectGenNums.erase(objnum);
 
   std::unique_ptr<CPDF_Encryptor> encryptor;
-  if (GetCryptoHandler() && pObj != m_pEncryptDict)
-    encryptor = std::make_unique<CPDF_Encryptor>(GetCryptoHandler(), objnum);
+  if (GetCryptoHandler() && pObj != m_pEncryptDict) {
+    encryptor =
+        std::make_unique<CPDF_Encryptor>(GetCryptoHandler(), objnum, gennum);
+  }
 
   if (!pObj->WriteTo(m_Archive.get(), encryptor.get()))
     return false;
@@ -162,6 +183,11 @@ bool CPDF_Creator::WriteIndirectObj(uint32_t objnum, const CPDF_Object* pObj) {
   return m_Archive->WriteString("\r\nendobj\r\n");
 }
 
+uint32_t CPDF_Creator::GetObjectGenNum(uint32_t objnum) const {
+  auto it = m_ObjectGenNums.find(objnum);
+  return it != m_ObjectGenNums.end() ? it->second : 0;
+}
+
 bool CPDF_Creator::WriteOldIndirectObject(uint32_t objnum) {
   if (m_pParser->IsObjectFreeOrNull(objnum))
     return true;
@@ -174,7 +200,7 @@ bool CPDF_Creator::WriteOldIndirectObject(uint32_t objnum) {
     m_ObjectOffsets.erase(objnum);
     return true;
   }
-  if (!WriteIndirectObj(pObj->GetObjNum(), pObj))
+  if (!WriteIndirectObj(pObj->GetObjNum(), pObj->GetGenNum(), pObj))
     return false;
   if (!bExistInMap)
     m_pDocument->DeleteIndirectObject(objnum);
@@ -201,19 +227,27 @@ bool CPDF_Creator::WriteNewObjs() {
       continue;
 
     m_ObjectOffsets[objnum] = m_Archive->CurrentOffset();
-    if (!WriteIndirectObj(pObj->GetObjNum(), pObj))
+    if (!WriteIndirectObj(pObj->GetObjNum(), pObj->GetGenNum(), pObj))
       return false;
   }
   return true;
 }
 
 void CPDF_Creator::InitNewObjNumOffsets() {
+  if (m_IsIncremental) {
+    // Only objects changed since loading go into the appended section, so
+    // this costs time in proportion to the edits, not to the document.
+    for (uint32_t objnum : m_pDocument->GetDirtyObjNums()) {
+      if (m_pDocument->GetIndirectObject(objnum))
+        m_NewObjNumArray.push_back(objnum);
+    }
+    return;
+  }
+
   for (const auto& pair : *m_pDocument) {
     const uint32_t objnum = pair.first;
-    if (m_IsIncremental ||
-        pair.second->GetObjNum() == CPDF_Object::kInvalidObjNum) {
+    if (pair.second->GetObjNum() == CPDF_Object::kInvalidObjNum)
       continue;
-    }
     if (m_pParser && m_pParser->IsValidObjectNumber(objnum) &&
         !m_pParser->IsObjectFree(objnum)) {
       continue;
@@ -278,6 +312,10 @@ CPDF_Creator::Stage CPDF_Creator::WriteDoc_Stage1() {
           continue;
 
         m_ObjectOffsets[num] = m_pParser->GetObjectPositionOrZero(num);
+        const CPDF_CrossRefTable::ObjectInfo* info =
+            m_pParser->GetCrossRefTable()->GetObjectInfo(num);
+        if (info && info->gennum)
+          m_ObjectGenNums[num] = info->gennum;
       }
     }
     m_iStage = Stage::kInitWriteObjs20;
@@ -317,7 +355,7 @@ CPDF_Creator::Stage CPDF_Creator::WriteDoc_Stage2() {
     if (m_pEncryptDict && m_pEncryptDict->IsInline()) {
       m_dwLastObjNum += 1;
       FX_FILESIZE saveOffset = m_Archive->CurrentOffset();
-      if (!WriteIndirectObj(m_dwLastObjNum, m_pEncryptDict.Get()))
+      if (!WriteIndirectObj(m_dwLastObjNum, 0, m_pEncryptDict.Get()))
         return Stage::kInvalid;
 
       m_ObjectOffsets[m_dwLastObjNum] = saveOffset;
@@ -382,7 +420,9 @@ CPDF_Creator::Stage CPDF_Creator::WriteDoc_Stage3() {
         return Stage::kInvalid;
 
       while (i < j) {
-        str = ByteString::Format("%010d 00000 n\r\n", m_ObjectOffsets[i++]);
+        str = ByteString::Format("%010d %05u n\r\n", m_ObjectOffsets[i],
+                                 GetObjectGenNum(i));
+        ++i;
         if (!m_Archive->WriteString(str.AsStringView()))
           return Stage::kInvalid;
       }
@@ -417,7 +457,8 @@ CPDF_Creator::Stage CPDF_Creator::WriteDoc_Stage3() {
 
       while (i < j) {
         objnum = m_NewObjNumArray[i++];
-        str = ByteString::Format("%010d 00000 n\r\n", m_ObjectOffsets[objnum]);
+        str = ByteString::Format("%010d %05u n\r\n", m_ObjectOffsets[objnum],
+                                 GetObjectGenNum(objnum));
         if (!m_Archive->WriteString(str.AsStringView()))
           return Stage::kInvalid;
       }
@@ -514,8 +555,16 @@ CPDF_Creator::Stage CPDF_Creator::WriteDoc_Stage4() {
     if (!m_Archive->WriteString(">>"))
       return Stage::kInvalid;
   } else {
-    if (!m_Archive->WriteString("/W[0 4 1]/Index["))
+    uint32_t max_gennum = 0;
+    for (const auto& it : m_ObjectGenNums)
+      max_gennum = std::max(max_gennum, it.second);
+    const uint32_t gennum_size = max_gennum > 0xFF ? 2 : 1;
+    const uint32_t entry_size = 4 + gennum_size;
+    if (!m_Archive->WriteString("/W[0 4 ") ||
+        !m_Archive->WriteDWord(gennum_size) ||
+        !m_Archive->WriteString("]/Index[")) {
       return Stage::kInvalid;
+    }
     if (m_IsIncremental && m_pParser && m_pParser->GetLastXRefOffset() == 0) {
       uint32_t i = 0;
       for (i = 0; i < m_dwLastObjNum; i++) {
@@ -525,7 +574,7 @@ CPDF_Creator::Stage CPDF_Creator::WriteDoc_Stage4() {
           return Stage::kInvalid;
       }
       if (!m_Archive->WriteString("]/Length ") ||
-          !m_Archive->WriteDWord(m_dwLastObjNum * 5) ||
+          !m_Archive->WriteDWord(m_dwLastObjNum * entry_size) ||
           !m_Archive->WriteString(">>stream\r\n")) {
         return Stage::kInvalid;
       }
@@ -533,8 +582,10 @@ CPDF_Creator::Stage CPDF_Creator::WriteDoc_Stage4() {
         auto it = m_ObjectOffsets.find(i);
         if (it == m_ObjectOffsets.end())
           continue;
-        if (!OutputIndex(m_Archive.get(), it->second))
+        if (!OutputIndex(m_Archive.get(), it->second, GetObjectGenNum(i),
+                         gennum_size)) {
           return Stage::kInvalid;
+        }
       }
     } else {
       size_t count = m_NewObjNumArray.size();
@@ -546,13 +597,16 @@ CPDF_Creator::Stage CPDF_Creator::WriteDoc_Stage4() {
         }
       }
       if (!m_Archive->WriteString("]/Length ") ||
-          !m_Archive->WriteDWord(count * 5) ||
+          !m_Archive->WriteDWord(count * entry_size) ||
           !m_Archive->WriteString(">>stream\r\n")) {
         return Stage::kInvalid;
       }
       for (i = 0; i < count; ++i) {
-        if (!OutputIndex(m_Archive.get(), m_ObjectOffsets[m_NewObjNumArray[i]]))
+        const uint32_t objnum = m_NewObjNumArray[i];
+        if (!OutputIndex(m_Archive.get(), m_ObjectOffsets[objnum],
+                         GetObjectGenNum(objnum), gennum_size)) {
           return Stage::kInvalid;
+        }
       }
     }
     if (!m_Archive->WriteString("\r\nendstream"))
@@ -581,6 +635,7 @@ bool CPDF_Creator::Create(uint32_t flags) {
   m_iStage = Stage::kInit0;
   m_dwLastObjNum = m_pDocument->GetLastObjNum();
   m_ObjectOffsets.clear();
+  m_ObjectGenNums.clear();
   m_NewObjNumArray.clear();
 
   InitID();
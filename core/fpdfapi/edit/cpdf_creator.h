@@ -68,7 +68,10 @@ class CPDF_Creator {
   bool WriteOldIndirectObject(uint32_t objnum);
   bool WriteOldObjs();
   bool WriteNewObjs();
-  bool WriteIndirectObj(uint32_t objnum, const CPDF_Object* pObj);
+  bool WriteIndirectObj(uint32_t objnum,
+                        uint32_t gennum,
+                        const CPDF_Object* pObj);
+  uint32_t GetObjectGenNum(uint32_t objnum) const;
 
   CPDF_CryptoHandler* GetCryptoHandler();
 
@@ -85,6 +88,8 @@ class CPDF_Creator {
   uint32_t m_CurObjNum = 0;
   FX_FILESIZE m_XrefStart = 0;
   std::map<uint32_t, FX_FILESIZE> m_ObjectOffsets;
+  // Generation numbers of the objects in |m_ObjectOffsets|, if not 0.
+  std::map<uint32_t, uint32_t> m_ObjectGenNums;
   std::vector<uint32_t> m_NewObjNumArray;  // Sorted, ascending.
   RetainPtr<CPDF_Array> m_pIDArray;
   int32_t m_FileVersion = 0;
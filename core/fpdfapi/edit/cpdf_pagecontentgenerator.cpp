@@ -118,7 +118,7 @@ CPDF_PageContentGenerator::GenerateModifiedStreams() {
     empty_streams.erase(stream_index);
     current_content_marks[stream_index] = ProcessContentMarks(
         buf, pPageObj.Get(), current_content_marks[stream_index]);
-    ProcessPageObject(buf, pPageObj.Get());
+    ProcessPageObjectOrReuse(buf, pPageObj.Get());
   }
 
   // Finish dirty streams.
@@ -161,10 +161,12 @@ void CPDF_PageContentGenerator::UpdateContentStreams(
     DCHECK(old_stream);
 
     // If buf is now empty, remove the stream instead of setting the data.
-    if (buf->tellp() <= 0)
+    if (buf->tellp() <= 0) {
       page_content_manager.ScheduleRemoveStreamByIndex(stream_index);
-    else
+    } else {
       old_stream->SetDataFromStringstreamAndRemoveFilter(buf);
+      m_pDocument->MarkIndirectObjectDirty(old_stream->GetObjNum());
+    }
   }
 
   page_content_manager.ExecuteScheduledRemovals();
@@ -195,6 +197,11 @@ ByteString CPDF_PageContentGenerator::RealizeResource(
   }
   pResList->SetNewFor<CPDF_Reference>(name, m_pDocument.Get(),
                                       pResource->GetObjNum());
+  // Direct dictionaries are part of the object that holds them.
+  m_pDocument->MarkIndirectObjectDirty(pResList->GetObjNum());
+  m_pDocument->MarkIndirectObjectDirty(
+      m_pObjHolder->GetResources()->GetObjNum());
+  m_pDocument->MarkIndirectObjectDirty(m_pObjHolder->GetDict()->GetObjNum());
   return name;
 }
 
@@ -297,6 +304,28 @@ void CPDF_PageContentGenerator::ProcessPageObject(std::ostringstream* buf,
   pPageObj->SetDirty(false);
 }
 
+void CPDF_PageContentGenerator::ProcessPageObjectOrReuse(
+    std::ostringstream* buf,
+    CPDF_PageObject* pPageObj) {
+  // The operators written for an object do not depend on the objects around
+  // it, so a stream that is dirty because of one edit only has to serialize
+  // the objects that changed.
+  if (!pPageObj->IsDirty()) {
+    Optional<ByteString> content =
+        m_pObjHolder->GeneratedContentSearch(pPageObj);
+    if (content.has_value()) {
+      *buf << content.value();
+      return;
+    }
+  }
+
+  std::ostringstream object_buf;
+  ProcessPageObject(&object_buf, pPageObj);
+  ByteString content(object_buf);
+  m_pObjHolder->GeneratedContentInsert(pPageObj, content);
+  *buf << content;
+}
+
 void CPDF_PageContentGenerator::ProcessImage(std::ostringstream* buf,
                                              CPDF_ImageObject* pImageObj) {
   if ((pImageObj->matrix().a == 0 && pImageObj->matrix().b == 0) ||
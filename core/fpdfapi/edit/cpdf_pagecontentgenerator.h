@@ -37,6 +37,10 @@ class CPDF_PageContentGenerator {
   friend class CPDF_PageContentGeneratorTest;
 
   void ProcessPageObject(std::ostringstream* buf, CPDF_PageObject* pPageObj);
+  // Like ProcessPageObject(), but reuses the operators generated for
+  // |pPageObj| last time if it has not been marked dirty since.
+  void ProcessPageObjectOrReuse(std::ostringstream* buf,
+                                CPDF_PageObject* pPageObj);
   void ProcessPathPoints(std::ostringstream* buf, CPDF_Path* pPath);
   void ProcessPath(std::ostringstream* buf, CPDF_PathObject* pPathObj);
   void ProcessImage(std::ostringstream* buf, CPDF_ImageObject* pImageObj);
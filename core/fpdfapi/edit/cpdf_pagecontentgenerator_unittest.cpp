@@ -4,6 +4,7 @@
 
 #include "core/fpdfapi/edit/cpdf_pagecontentgenerator.h"
 
+#include <map>
 #include <memory>
 #include <utility>
 
@@ -51,6 +52,14 @@ class CPDF_PageContentGeneratorTest : public testing::Test {
                        CPDF_TextObject* pTextObj) {
     pGen->ProcessText(buf, pTextObj);
   }
+
+  ByteString TestGenerateModifiedStream(CPDF_PageContentGenerator* pGen,
+                                        int32_t stream_index) {
+    std::map<int32_t, std::ostringstream> streams =
+        pGen->GenerateModifiedStreams();
+    auto it = streams.find(stream_index);
+    return it != streams.end() ? ByteString(it->second) : ByteString();
+  }
 };
 
 TEST_F(CPDF_PageContentGeneratorTest, ProcessRect) {
@@ -431,3 +440,48 @@ TEST_F(CPDF_PageContentGeneratorTest, ProcessFormWithPath) {
       "99999 4.6500001 2.98 3.4560001 .24000001 c 3.102 4.6700001 l h f Q\n",
       ByteString(process_buf).c_str());
 }
+
+TEST_F(CPDF_PageContentGeneratorTest, ReuseUnchangedObjects) {
+  auto pDoc =
+      std::make_unique<CPDF_Document>(std::make_unique<CPDF_DocRenderData>(),
+                                      std::make_unique<CPDF_DocPageData>());
+  pDoc->CreateNewDoc();
+  CPDF_Dictionary* pPageDict = pDoc->CreateNewPage(0);
+  auto pTestPage = pdfium::MakeRetain<CPDF_Page>(pDoc.get(), pPageDict);
+
+  for (int i = 0; i < 2; ++i) {
+    auto pPathObj = std::make_unique<CPDF_PathObject>();
+    pPathObj->set_stroke(true);
+    pPathObj->path().AppendPoint(CFX_PointF(i, 2), FXPT_TYPE::MoveTo);
+    pPathObj->path().AppendPoint(CFX_PointF(3, 4), FXPT_TYPE::LineTo);
+    pPathObj->SetDirty(true);
+    pTestPage->AppendPageObject(std::move(pPathObj));
+  }
+  CPDF_PathObject* pFirst = pTestPage->GetPageObjectByIndex(0)->AsPath();
+  CPDF_PathObject* pSecond = pTestPage->GetPageObjectByIndex(1)->AsPath();
+  {
+    CPDF_PageContentGenerator generator(pTestPage.Get());
+    generator.GenerateContent();
+  }
+  ASSERT_EQ(0, pFirst->GetContentStream());
+  ASSERT_EQ(0, pSecond->GetContentStream());
+
+  // Change the first object without marking it dirty, so the stream only shows
+  // the change if the object is serialized again.
+  pFirst->m_GraphState.SetLineWidth(2);
+  pSecond->path().AppendPoint(CFX_PointF(5, 6), FXPT_TYPE::LineTo);
+  pSecond->SetDirty(true);
+
+  CPDF_PageContentGenerator generator(pTestPage.Get());
+  ByteString content = TestGenerateModifiedStream(&generator, 0);
+  EXPECT_FALSE(content.Contains("2 w "));
+  std::ostringstream second_buf;
+  TestProcessPath(&generator, &second_buf, pSecond);
+  EXPECT_TRUE(content.Contains(ByteString(second_buf).AsStringView()));
+  EXPECT_FALSE(pSecond->IsDirty());
+
+  // Once marked dirty, the first object is serialized again.
+  pFirst->SetDirty(true);
+  CPDF_PageContentGenerator generator2(pTestPage.Get());
+  EXPECT_TRUE(TestGenerateModifiedStream(&generator2, 0).Contains("2 w "));
+}
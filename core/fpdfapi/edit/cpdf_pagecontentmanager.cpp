@@ -77,6 +77,7 @@ size_t CPDF_PageContentManager::AddStream(std::ostringstream* buf) {
     CPDF_Dictionary* page_dict = obj_holder_->GetDict();
     page_dict->SetNewFor<CPDF_Reference>("Contents", doc_.Get(),
                                          new_contents_array->GetObjNum());
+    doc_->MarkIndirectObjectDirty(page_dict->GetObjNum());
     contents_array_.Reset(new_contents_array);
     contents_stream_ = nullptr;
     return 1;
@@ -86,6 +87,7 @@ size_t CPDF_PageContentManager::AddStream(std::ostringstream* buf) {
   if (contents_array_) {
     contents_array_->AppendNew<CPDF_Reference>(doc_.Get(),
                                                new_stream->GetObjNum());
+    MarkContentsArrayDirty();
     return contents_array_->size() - 1;
   }
 
@@ -94,6 +96,7 @@ size_t CPDF_PageContentManager::AddStream(std::ostringstream* buf) {
   CPDF_Dictionary* page_dict = obj_holder_->GetDict();
   page_dict->SetNewFor<CPDF_Reference>("Contents", doc_.Get(),
                                        new_stream->GetObjNum());
+  doc_->MarkIndirectObjectDirty(page_dict->GetObjNum());
   contents_stream_.Reset(new_stream);
   return 0;
 }
@@ -115,6 +118,7 @@ void CPDF_PageContentManager::ExecuteScheduledRemovals() {
     if (streams_to_remove_.find(0) != streams_to_remove_.end()) {
       CPDF_Dictionary* page_dict = obj_holder_->GetDict();
       page_dict->RemoveFor("Contents");
+      doc_->MarkIndirectObjectDirty(page_dict->GetObjNum());
       contents_stream_ = nullptr;
     }
   } else if (contents_array_) {
@@ -129,6 +133,8 @@ void CPDF_PageContentManager::ExecuteScheduledRemovals() {
       contents_array_->RemoveAt(stream_index);
       streams_left.erase(streams_left.begin() + stream_index);
     }
+    if (!streams_to_remove_.empty())
+      MarkContentsArrayDirty();
 
     // Create a mapping from the old to the new stream indexes, shifted due to
     // the deletion of the |streams_to_remove_|.
@@ -150,3 +156,10 @@ void CPDF_PageContentManager::ExecuteScheduledRemovals() {
 
   streams_to_remove_.clear();
 }
+
+void CPDF_PageContentManager::MarkContentsArrayDirty() {
+  // A direct array is part of the page dictionary.
+  const uint32_t objnum = contents_array_->GetObjNum();
+  doc_->MarkIndirectObjectDirty(objnum ? objnum
+                                       : obj_holder_->GetDict()->GetObjNum());
+}
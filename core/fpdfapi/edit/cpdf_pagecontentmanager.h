@@ -40,6 +40,9 @@ class CPDF_PageContentManager {
   void ExecuteScheduledRemovals();
 
  private:
+  // Marks the object holding |contents_array_| dirty.
+  void MarkContentsArrayDirty();
+
   UnownedPtr<const CPDF_PageObjectHolder> const obj_holder_;
   UnownedPtr<CPDF_Document> const doc_;
   RetainPtr<CPDF_Array> contents_array_;
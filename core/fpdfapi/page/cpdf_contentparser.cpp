@@ -9,12 +9,16 @@
 #include "constants/page_object.h"
 #include "core/fpdfapi/font/cpdf_type3char.h"
 #include "core/fpdfapi/page/cpdf_allstates.h"
+#include "core/fpdfapi/page/cpdf_docpagedata.h"
 #include "core/fpdfapi/page/cpdf_form.h"
 #include "core/fpdfapi/page/cpdf_page.h"
 #include "core/fpdfapi/page/cpdf_pageobject.h"
 #include "core/fpdfapi/page/cpdf_path.h"
 #include "core/fpdfapi/parser/cpdf_array.h"
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
+#include "core/fpdfapi/parser/cpdf_document.h"
+#include "core/fpdfapi/parser/cpdf_parser.h"
+#include "core/fpdfapi/parser/cpdf_reference.h"
 #include "core/fpdfapi/parser/cpdf_stream.h"
 #include "core/fpdfapi/parser/cpdf_stream_acc.h"
 #include "core/fxcrt/fx_safe_types.h"
@@ -24,31 +28,14 @@
 #include "third_party/base/check_op.h"
 
 CPDF_ContentParser::CPDF_ContentParser(CPDF_Page* pPage)
-    : m_CurrentStage(Stage::kGetContent), m_pObjectHolder(pPage) {
+    : m_CurrentStage(Stage::kGetContentObject), m_pObjectHolder(pPage) {
   DCHECK(pPage);
   if (!pPage->GetDocument()) {
     m_CurrentStage = Stage::kComplete;
     return;
   }
 
-  CPDF_Object* pContent =
-      pPage->GetDict()->GetDirectObjectFor(pdfium::page_object::kContents);
-  if (!pContent) {
-    HandlePageContentFailure();
-    return;
-  }
-
-  CPDF_Stream* pStream = pContent->AsStream();
-  if (pStream) {
-    HandlePageContentStream(pStream);
-    return;
-  }
-
-  CPDF_Array* pArray = pContent->AsArray();
-  if (pArray && HandlePageContentArray(pArray))
-    return;
-
-  HandlePageContentFailure();
+  m_CurrentStage = GetContentObject();
 }
 
 CPDF_ContentParser::CPDF_ContentParser(CPDF_Form* pForm,
@@ -97,8 +84,9 @@ CPDF_ContentParser::CPDF_ContentParser(CPDF_Form* pForm,
     pState->SetFillAlpha(1.0f);
     pState->SetSoftMask(nullptr);
   }
-  m_pSingleStream = pdfium::MakeRetain<CPDF_StreamAcc>(pForm->GetStream());
-  m_pSingleStream->LoadAllDataFiltered();
+  m_pSingleStream =
+      CPDF_DocPageData::FromDocument(pForm->GetDocument())
+          ->GetDecodedStreamAcc(pForm->GetStream());
   m_pData.Reset(m_pSingleStream->GetData());
   m_Size = m_pSingleStream->GetSize();
 }
@@ -109,7 +97,20 @@ CPDF_ContentParser::~CPDF_ContentParser() = default;
 // Continue() should be called again. Returning |false| means that we've
 // completed the parse and Continue() is complete.
 bool CPDF_ContentParser::Continue(PauseIndicatorIface* pPause) {
+  if (m_CurrentStage == Stage::kGetContentObject) {
+    m_CurrentStage = GetContentObject();
+    if (m_CurrentStage == Stage::kGetContentObject) {
+      // Only progressive parsing can give the data time to arrive.
+      if (pPause)
+        return true;
+      m_CurrentStage = Stage::kComplete;
+    }
+  }
+
   while (m_CurrentStage == Stage::kGetContent) {
+    // Only progressive parsing can give the data time to arrive.
+    if (pPause && NeedToWaitForContentStream())
+      return true;
     m_CurrentStage = GetContent();
     if (pPause && pPause->NeedToPauseNow())
       return true;
@@ -131,16 +132,46 @@ bool CPDF_ContentParser::Continue(PauseIndicatorIface* pPause) {
   return false;
 }
 
+CPDF_ContentParser::Stage CPDF_ContentParser::GetContentObject() {
+  DCHECK(m_pObjectHolder->IsPage());
+  CPDF_Dictionary* pDict = m_pObjectHolder->GetDict();
+  CPDF_Object* pContent =
+      pDict->GetDirectObjectFor(pdfium::page_object::kContents);
+  if (!pContent) {
+    // The content object itself may still be on its way.
+    const CPDF_Object* pContentRef =
+        pDict->GetObjectFor(pdfium::page_object::kContents);
+    if (IsObjectDataPending(pContentRef))
+      return Stage::kGetContentObject;
+
+    // Its data may also have arrived since the lookup above, in which case the
+    // check parsed it.
+    pContent = pDict->GetDirectObjectFor(pdfium::page_object::kContents);
+    if (!pContent)
+      return Stage::kComplete;
+  }
+
+  // GetContent() loads a single content stream into |m_pSingleStream|.
+  if (pContent->IsStream())
+    return Stage::kGetContent;
+
+  CPDF_Array* pArray = pContent->AsArray();
+  return pArray && HandlePageContentArray(pArray) ? Stage::kGetContent
+                                                  : Stage::kComplete;
+}
+
 CPDF_ContentParser::Stage CPDF_ContentParser::GetContent() {
   DCHECK_EQ(m_CurrentStage, Stage::kGetContent);
   DCHECK(m_pObjectHolder->IsPage());
-  CPDF_Array* pContent =
-      m_pObjectHolder->GetDict()->GetArrayFor(pdfium::page_object::kContents);
-  CPDF_Stream* pStreamObj = ToStream(
-      pContent ? pContent->GetDirectObjectAt(m_CurrentOffset) : nullptr);
-  m_StreamArray[m_CurrentOffset] =
-      pdfium::MakeRetain<CPDF_StreamAcc>(pStreamObj);
-  m_StreamArray[m_CurrentOffset]->LoadAllDataFiltered();
+  RetainPtr<CPDF_StreamAcc> pStreamAcc =
+      CPDF_DocPageData::FromDocument(m_pObjectHolder->GetDocument())
+          ->GetDecodedStreamAcc(GetCurrentContentStream());
+  if (m_StreamArray.empty()) {
+    m_pSingleStream = std::move(pStreamAcc);
+    return Stage::kPrepareContent;
+  }
+
+  m_StreamArray[m_CurrentOffset] = std::move(pStreamAcc);
   m_CurrentOffset++;
 
   return m_CurrentOffset == m_nStreams ? Stage::kPrepareContent
@@ -232,10 +263,34 @@ CPDF_ContentParser::Stage CPDF_ContentParser::CheckClip() {
   return Stage::kComplete;
 }
 
-void CPDF_ContentParser::HandlePageContentStream(CPDF_Stream* pStream) {
-  m_pSingleStream = pdfium::MakeRetain<CPDF_StreamAcc>(pStream);
-  m_pSingleStream->LoadAllDataFiltered();
-  m_CurrentStage = Stage::kPrepareContent;
+CPDF_Stream* CPDF_ContentParser::GetCurrentContentStream() const {
+  CPDF_Object* pContent = m_pObjectHolder->GetDict()->GetDirectObjectFor(
+      pdfium::page_object::kContents);
+  if (m_StreamArray.empty())
+    return ToStream(pContent);
+
+  CPDF_Array* pArray = ToArray(pContent);
+  return ToStream(pArray ? pArray->GetDirectObjectAt(m_CurrentOffset)
+                         : nullptr);
+}
+
+bool CPDF_ContentParser::NeedToWaitForContentStream() const {
+  const CPDF_Stream* pStream = GetCurrentContentStream();
+  if (pStream)
+    return pStream->NeedToWaitForRawData();
+
+  // The stream object itself may still be on its way. A single stream was
+  // already loaded by GetContentObject().
+  const CPDF_Array* pArray =
+      m_pObjectHolder->GetDict()->GetArrayFor(pdfium::page_object::kContents);
+  return !m_StreamArray.empty() && pArray &&
+         IsObjectDataPending(pArray->GetObjectAt(m_CurrentOffset));
+}
+
+bool CPDF_ContentParser::IsObjectDataPending(const CPDF_Object* pObj) const {
+  const CPDF_Reference* pRef = ToReference(pObj);
+  CPDF_Parser* pParser = m_pObjectHolder->GetDocument()->GetParser();
+  return pRef && pParser && pParser->IsObjectDataPending(pRef->GetRefObjNum());
 }
 
 bool CPDF_ContentParser::HandlePageContentArray(CPDF_Array* pArray) {
@@ -246,7 +301,3 @@ bool CPDF_ContentParser::HandlePageContentArray(CPDF_Array* pArray) {
   m_StreamArray.resize(m_nStreams);
   return true;
 }
-
-void CPDF_ContentParser::HandlePageContentFailure() {
-  m_CurrentStage = Stage::kComplete;
-}
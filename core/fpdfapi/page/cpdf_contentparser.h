@@ -20,6 +20,7 @@
 class CPDF_AllStates;
 class CPDF_Array;
 class CPDF_Form;
+class CPDF_Object;
 class CPDF_Page;
 class CPDF_PageObjectHolder;
 class CPDF_Stream;
@@ -45,21 +46,29 @@ class CPDF_ContentParser {
 
  private:
   enum class Stage : uint8_t {
-    kGetContent = 1,
+    kGetContentObject = 1,
+    kGetContent,
     kPrepareContent,
     kParse,
     kCheckClip,
     kComplete,
   };
 
+  Stage GetContentObject();
   Stage GetContent();
   Stage PrepareContent();
   Stage Parse();
   Stage CheckClip();
 
-  void HandlePageContentStream(CPDF_Stream* pStream);
+  // Returns the content stream GetContent() loads next, if any.
+  CPDF_Stream* GetCurrentContentStream() const;
+  // Returns true if the data of that stream is being loaded asynchronously.
+  bool NeedToWaitForContentStream() const;
+  // Returns true if |pObj| references an object that cannot be parsed until
+  // more of its data arrives asynchronously.
+  bool IsObjectDataPending(const CPDF_Object* pObj) const;
+
   bool HandlePageContentArray(CPDF_Array* pArray);
-  void HandlePageContentFailure();
 
   Stage m_CurrentStage;
   UnownedPtr<CPDF_PageObjectHolder> const m_pObjectHolder;
@@ -42,6 +42,9 @@
 
 namespace {
 
+size_t g_DecodedStreamCacheLimit =
+    CPDF_DocPageData::kDefaultDecodedStreamCacheLimit;
+
 void InsertWidthArrayImpl(std::vector<int> widths, CPDF_Array* pWidthArray) {
   size_t i;
   for (i = 1; i < widths.size(); i++) {
@@ -162,7 +165,13 @@ CPDF_DocPageData* CPDF_DocPageData::FromDocument(const CPDF_Document* pDoc) {
   return static_cast<CPDF_DocPageData*>(pDoc->GetPageData());
 }
 
-CPDF_DocPageData::CPDF_DocPageData() = default;
+// static
+void CPDF_DocPageData::SetDecodedStreamCacheLimit(size_t limit) {
+  g_DecodedStreamCacheLimit = limit;
+}
+
+CPDF_DocPageData::CPDF_DocPageData()
+    : m_DecodedStreamCacheLimit(g_DecodedStreamCacheLimit) {}
 
 CPDF_DocPageData::~CPDF_DocPageData() {
   for (auto& it : m_FontMap) {
@@ -427,6 +436,64 @@ RetainPtr<CPDF_StreamAcc> CPDF_DocPageData::GetFontFileStreamAcc(
   return pFontAcc;
 }
 
+RetainPtr<CPDF_StreamAcc> CPDF_DocPageData::GetDecodedStreamAcc(
+    const CPDF_Stream* pStream) {
+  // Streams that are not in a document, or that are already in memory and
+  // need no decoding, gain nothing from caching.
+  if (!pStream || pStream->GetObjNum() == CPDF_Object::kInvalidObjNum ||
+      m_DecodedStreamCacheLimit == 0 ||
+      (pStream->IsMemoryBased() && !pStream->HasFilter())) {
+    auto pStreamAcc = pdfium::MakeRetain<CPDF_StreamAcc>(pStream);
+    pStreamAcc->LoadAllDataFiltered();
+    return pStreamAcc;
+  }
+
+  const StreamKey key(pStream->GetObjNum(), pStream->GetGenNum());
+  auto it = m_DecodedStreamMap.find(key);
+  if (it != m_DecodedStreamMap.end()) {
+    const DecodedStreamCacheEntry& entry = it->second;
+    if (entry.pStreamAcc->GetStream() == pStream &&
+        entry.data_version == pStream->GetDataVersion()) {
+      ++m_DecodedStreamCacheHits;
+      m_DecodedStreamLru.splice(m_DecodedStreamLru.begin(), m_DecodedStreamLru,
+                                entry.lru_pos);
+      return entry.pStreamAcc;
+    }
+    // The object was replaced or its data changed.
+    EraseDecodedStream(it);
+  }
+
+  ++m_DecodedStreamCacheMisses;
+  auto pStreamAcc = pdfium::MakeRetain<CPDF_StreamAcc>(pStream);
+  pStreamAcc->LoadAllDataFiltered();
+  if (pStreamAcc->GetSize() > m_DecodedStreamCacheLimit)
+    return pStreamAcc;
+
+  m_DecodedStreamLru.push_front(key);
+  DecodedStreamCacheEntry& entry = m_DecodedStreamMap[key];
+  entry.pStreamAcc = pStreamAcc;
+  entry.data_version = pStream->GetDataVersion();
+  entry.lru_pos = m_DecodedStreamLru.begin();
+  m_DecodedStreamCacheSize += pStreamAcc->GetSize();
+  TrimDecodedStreamCache();
+  return pStreamAcc;
+}
+
+void CPDF_DocPageData::EraseDecodedStream(
+    std::map<StreamKey, DecodedStreamCacheEntry>::iterator it) {
+  m_DecodedStreamCacheSize -= it->second.pStreamAcc->GetSize();
+  m_DecodedStreamLru.erase(it->second.lru_pos);
+  m_DecodedStreamMap.erase(it);
+}
+
+void CPDF_DocPageData::TrimDecodedStreamCache() {
+  while (m_DecodedStreamCacheSize > m_DecodedStreamCacheLimit) {
+    auto it = m_DecodedStreamMap.find(m_DecodedStreamLru.back());
+    DCHECK(it != m_DecodedStreamMap.end());
+    EraseDecodedStream(it);
+  }
+}
+
 void CPDF_DocPageData::MaybePurgeFontFileStreamAcc(
     const CPDF_Stream* pFontStream) {
   if (!pFontStream)
@@ -7,9 +7,11 @@
 #ifndef CORE_FPDFAPI_PAGE_CPDF_DOCPAGEDATA_H_
 #define CORE_FPDFAPI_PAGE_CPDF_DOCPAGEDATA_H_
 
+#include <list>
 #include <map>
 #include <memory>
 #include <set>
+#include <utility>
 
 #include "core/fpdfapi/font/cpdf_font.h"
 #include "core/fpdfapi/page/cpdf_colorspace.h"
@@ -32,8 +34,16 @@ class CPDF_StreamAcc;
 class CPDF_DocPageData : public CPDF_Document::PageDataIface,
                          public CPDF_Font::FormFactoryIface {
  public:
+  // Default limit on the total decoded size of the streams each document
+  // keeps in its decoded stream cache.
+  static constexpr size_t kDefaultDecodedStreamCacheLimit = 16 * 1024 * 1024;
+
   static CPDF_DocPageData* FromDocument(const CPDF_Document* pDoc);
 
+  // Sets the decoded stream cache limit of documents created afterwards. A
+  // limit of 0 disables the cache.
+  static void SetDecodedStreamCacheLimit(size_t limit);
+
   CPDF_DocPageData();
   ~CPDF_DocPageData() override;
 
@@ -82,7 +92,29 @@ class CPDF_DocPageData : public CPDF_Document::PageDataIface,
 
   RetainPtr<CPDF_IccProfile> GetIccProfile(const CPDF_Stream* pProfileStream);
 
+  // Returns an accessor with the filtered data of |pStream| loaded. Indirect
+  // streams are kept in a least-recently-used cache bounded by their total
+  // decoded size, so content streams and form XObjects shared by many pages
+  // are not decoded again on each page load.
+  RetainPtr<CPDF_StreamAcc> GetDecodedStreamAcc(const CPDF_Stream* pStream);
+  size_t GetDecodedStreamCacheHits() const { return m_DecodedStreamCacheHits; }
+  size_t GetDecodedStreamCacheMisses() const {
+    return m_DecodedStreamCacheMisses;
+  }
+  size_t GetDecodedStreamCacheSizeForTesting() const {
+    return m_DecodedStreamCacheSize;
+  }
+
  private:
+  // Object and generation numbers.
+  using StreamKey = std::pair<uint32_t, uint32_t>;
+
+  struct DecodedStreamCacheEntry {
+    RetainPtr<CPDF_StreamAcc> pStreamAcc;
+    uint32_t data_version;
+    std::list<StreamKey>::iterator lru_pos;
+  };
+
   // Loads a colorspace in a context that might be while loading another
   // colorspace, or even in a recursive call from this method itself. |pVisited|
   // is passed recursively to avoid circular calls involving
@@ -94,6 +126,10 @@ class CPDF_DocPageData : public CPDF_Document::PageDataIface,
       std::set<const CPDF_Object*>* pVisited,
       std::set<const CPDF_Object*>* pVisitedInternal);
 
+  void EraseDecodedStream(
+      std::map<StreamKey, DecodedStreamCacheEntry>::iterator it);
+  void TrimDecodedStreamCache();
+
   size_t CalculateEncodingDict(int charset, CPDF_Dictionary* pBaseDict);
   CPDF_Dictionary* ProcessbCJK(
       CPDF_Dictionary* pBaseDict,
@@ -102,6 +138,10 @@ class CPDF_DocPageData : public CPDF_Document::PageDataIface,
       std::function<void(wchar_t, wchar_t, CPDF_Array*)> Insert);
 
   bool m_bForceClear = false;
+  const size_t m_DecodedStreamCacheLimit;
+  size_t m_DecodedStreamCacheSize = 0;
+  size_t m_DecodedStreamCacheHits = 0;
+  size_t m_DecodedStreamCacheMisses = 0;
 
   // Specific destruction order may be required between maps.
   std::map<ByteString, RetainPtr<const CPDF_Stream>> m_HashProfileMap;
@@ -111,6 +151,10 @@ class CPDF_DocPageData : public CPDF_Document::PageDataIface,
   std::map<const CPDF_Object*, ObservedPtr<CPDF_Pattern>> m_PatternMap;
   std::map<uint32_t, RetainPtr<CPDF_Image>> m_ImageMap;
   std::map<const CPDF_Dictionary*, ObservedPtr<CPDF_Font>> m_FontMap;
+
+  // Keys of |m_DecodedStreamMap|, most recently used first.
+  std::list<StreamKey> m_DecodedStreamLru;
+  std::map<StreamKey, DecodedStreamCacheEntry> m_DecodedStreamMap;
 };
 
 #endif  // CORE_FPDFAPI_PAGE_CPDF_DOCPAGEDATA_H_
@@ -14,6 +14,7 @@
 #include "core/fpdfapi/page/cpdf_pageobject.h"
 #include "core/fpdfapi/parser/cpdf_array.h"
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
+#include "core/fpdfapi/parser/cpdf_document.h"
 #include "core/fpdfapi/parser/cpdf_object.h"
 #include "third_party/base/check.h"
 #include "third_party/base/check_op.h"
@@ -67,15 +68,28 @@ void CPDF_Page::ParseContent() {
   if (GetParseState() == ParseState::kParsed)
     return;
 
-  if (GetParseState() == ParseState::kNotParsed)
-    StartParse(std::make_unique<CPDF_ContentParser>(this));
-
+  StartParseContent();
   DCHECK_EQ(GetParseState(), ParseState::kParsing);
   ContinueParse(nullptr);
 }
 
+void CPDF_Page::StartParseContent() {
+  if (GetParseState() == ParseState::kNotParsed)
+    StartParse(std::make_unique<CPDF_ContentParser>(this));
+}
+
 CPDF_Object* CPDF_Page::GetPageAttr(const ByteString& name) const {
   CPDF_Dictionary* pPageDict = GetDict();
+  if (CPDF_Object* pObj = pPageDict->GetDirectObjectFor(name))
+    return pObj;
+
+  CPDF_Object* pInherited;
+  if (m_pPDFDocument && m_pPDFDocument->GetInheritedPageAttr(
+          pPageDict->GetDictFor(pdfium::page_object::kParent), name,
+          &pInherited)) {
+    return pInherited;
+  }
+
   std::set<CPDF_Dictionary*> visited;
   while (1) {
     visited.insert(pPageDict);
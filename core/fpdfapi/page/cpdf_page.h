@@ -73,6 +73,9 @@ class CPDF_Page final : public IPDF_Page, public CPDF_PageObjectHolder {
   bool IsPage() const override;
 
   void ParseContent();
+  // Sets up parsing the content without parsing any of it, for callers that
+  // parse progressively with ContinueParse().
+  void StartParseContent();
   const CFX_SizeF& GetPageSize() const { return m_PageSize; }
   int GetPageRotation() const;
   RenderCacheIface* GetRenderCache() const { return m_pRenderCache.get(); }
@@ -6,6 +6,8 @@
 
 #include "core/fpdfapi/page/cpdf_pageobject.h"
 
+#include "core/fpdfapi/page/cpdf_pageobjectholder.h"
+
 CPDF_PageObject::CPDF_PageObject(int32_t content_stream)
     : m_ContentStream(content_stream) {}
 
@@ -71,6 +73,12 @@ const CPDF_FormObject* CPDF_PageObject::AsForm() const {
   return nullptr;
 }
 
+void CPDF_PageObject::SetRect(const CFX_FloatRect& rect) {
+  m_Rect = rect;
+  if (m_pSpatialIndexHolder)
+    m_pSpatialIndexHolder->OnPageObjectRectChanged();
+}
+
 void CPDF_PageObject::CopyData(const CPDF_PageObject* pSrc) {
   CopyStates(*pSrc);
   m_Rect = pSrc->m_Rect;
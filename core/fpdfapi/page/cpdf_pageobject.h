@@ -11,9 +11,11 @@
 #include "core/fpdfapi/page/cpdf_graphicstates.h"
 #include "core/fxcrt/fx_coordinates.h"
 #include "core/fxcrt/fx_system.h"
+#include "core/fxcrt/unowned_ptr.h"
 
 class CPDF_FormObject;
 class CPDF_ImageObject;
+class CPDF_PageObjectHolder;
 class CPDF_PathObject;
 class CPDF_ShadingObject;
 class CPDF_TextObject;
@@ -58,7 +60,7 @@ class CPDF_PageObject : public CPDF_GraphicStates {
   void TransformClipPath(const CFX_Matrix& matrix);
   void TransformGeneralState(const CFX_Matrix& matrix);
 
-  void SetRect(const CFX_FloatRect& rect) { m_Rect = rect; }
+  void SetRect(const CFX_FloatRect& rect);
   const CFX_FloatRect& GetRect() const { return m_Rect; }
   FX_RECT GetBBox() const;
   FX_RECT GetTransformedBBox(const CFX_Matrix& matrix) const;
@@ -77,6 +79,12 @@ class CPDF_PageObject : public CPDF_GraphicStates {
 
   CPDF_ContentMarks m_ContentMarks;
 
+  // The holder whose spatial index covers this object, if any. SetRect()
+  // tells it that the index is stale.
+  void SetSpatialIndexHolder(const CPDF_PageObjectHolder* pHolder) {
+    m_pSpatialIndexHolder = pHolder;
+  }
+
  protected:
   void CopyData(const CPDF_PageObject* pSrcObject);
 
@@ -84,6 +92,7 @@ class CPDF_PageObject : public CPDF_GraphicStates {
 
  private:
   bool m_bDirty = false;
+  UnownedPtr<const CPDF_PageObjectHolder> m_pSpatialIndexHolder;
   int32_t m_ContentStream;
 };
 
@@ -0,0 +1,179 @@
+// Copyright 2020 PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfapi/page/cpdf_pageobjectgrid.h"
+
+#include <math.h>
+
+#include <algorithm>
+#include <utility>
+
+namespace {
+
+// The grid aims for about this many objects per cell.
+constexpr size_t kObjectsPerCell = 4;
+constexpr int kMaxCellsPerSide = 256;
+
+// Objects covering more cells than this are not worth putting in each cell.
+constexpr size_t kMaxCellsPerObject = 64;
+
+bool IsFiniteAndNormalized(const CFX_FloatRect& rect) {
+  return isfinite(rect.left) && isfinite(rect.right) && isfinite(rect.bottom) &&
+         isfinite(rect.top) && rect.left <= rect.right &&
+         rect.bottom <= rect.top;
+}
+
+int GetCell(float offset, float cell_size, int cell_count) {
+  if (cell_count == 1)
+    return 0;
+
+  // Also maps NaN to 0.
+  float pos = offset / cell_size;
+  if (!(pos > 0))
+    return 0;
+  if (pos >= cell_count)
+    return cell_count - 1;
+  return static_cast<int>(pos);
+}
+
+}  // namespace
+
+CPDF_PageObjectGrid::CPDF_PageObjectGrid(std::vector<CFX_FloatRect> rects)
+    : m_Rects(std::move(rects)) {
+  bool has_bounds = false;
+  for (const CFX_FloatRect& rect : m_Rects) {
+    if (!IsFiniteAndNormalized(rect))
+      continue;
+    if (has_bounds) {
+      m_Bounds.Union(rect);
+    } else {
+      m_Bounds = rect;
+      has_bounds = true;
+    }
+  }
+
+  const int side = std::min(
+      static_cast<int>(sqrt(std::max<size_t>(m_Rects.size() / kObjectsPerCell,
+                                             1))),
+      kMaxCellsPerSide);
+  const float width = m_Bounds.Width();
+  const float height = m_Bounds.Height();
+  if (side > 1 && width > 0 && isfinite(width)) {
+    m_Columns = side;
+    m_CellWidth = width / m_Columns;
+  }
+  if (side > 1 && height > 0 && isfinite(height)) {
+    m_Rows = side;
+    m_CellHeight = height / m_Rows;
+  }
+
+  // Fill the cells in two passes: count the objects in each cell, then place
+  // them. Going through the objects in order keeps each cell sorted.
+  const size_t cell_count = static_cast<size_t>(m_Columns) * m_Rows;
+  m_CellStarts.assign(cell_count + 1, 0);
+  std::vector<CellRange> ranges(m_Rects.size());
+  for (uint32_t pos = 0; pos < m_Rects.size(); ++pos) {
+    if (!IsFiniteAndNormalized(m_Rects[pos])) {
+      m_Unbinned.push_back(pos);
+      continue;
+    }
+    const CellRange range = GetCellRange(m_Rects[pos]);
+    const size_t covered = static_cast<size_t>(range.right - range.left + 1) *
+                           (range.top - range.bottom + 1);
+    if (covered > kMaxCellsPerObject) {
+      m_Unbinned.push_back(pos);
+      continue;
+    }
+    ranges[pos] = range;
+    for (int row = range.bottom; row <= range.top; ++row) {
+      for (int col = range.left; col <= range.right; ++col)
+        ++m_CellStarts[row * m_Columns + col + 1];
+    }
+  }
+  for (size_t i = 1; i <= cell_count; ++i)
+    m_CellStarts[i] += m_CellStarts[i - 1];
+
+  m_CellEntries.resize(m_CellStarts.back());
+  std::vector<uint32_t> next(m_CellStarts.begin(), m_CellStarts.end() - 1);
+  auto unbinned = m_Unbinned.begin();
+  for (uint32_t pos = 0; pos < m_Rects.size(); ++pos) {
+    if (unbinned != m_Unbinned.end() && *unbinned == pos) {
+      ++unbinned;
+      continue;
+    }
+    const CellRange& range = ranges[pos];
+    for (int row = range.bottom; row <= range.top; ++row) {
+      for (int col = range.left; col <= range.right; ++col)
+        m_CellEntries[next[row * m_Columns + col]++] = pos;
+    }
+  }
+}
+
+CPDF_PageObjectGrid::~CPDF_PageObjectGrid() = default;
+
+std::vector<uint32_t> CPDF_PageObjectGrid::Query(
+    const CFX_FloatRect& rect) const {
+  std::vector<uint32_t> result;
+  std::vector<uint32_t> candidates;
+  bool scan_all = !IsFiniteAndNormalized(rect);
+  if (!scan_all) {
+    candidates = m_Unbinned;
+    if (rect.left <= m_Bounds.right && rect.right >= m_Bounds.left &&
+        rect.bottom <= m_Bounds.top && rect.top >= m_Bounds.bottom) {
+      const CellRange range = GetCellRange(rect);
+      const size_t covered =
+          static_cast<size_t>(range.right - range.left + 1) *
+          (range.top - range.bottom + 1);
+      // Once most cells are involved, sorting their contents costs more than
+      // testing every object.
+      scan_all = covered * 2 > m_CellStarts.size() - 1;
+      for (int row = range.bottom; !scan_all && row <= range.top; ++row) {
+        for (int col = range.left; col <= range.right; ++col) {
+          const size_t cell = row * m_Columns + col;
+          candidates.insert(candidates.end(),
+                            m_CellEntries.begin() + m_CellStarts[cell],
+                            m_CellEntries.begin() + m_CellStarts[cell + 1]);
+        }
+      }
+    }
+  }
+
+  if (scan_all) {
+    for (uint32_t pos = 0; pos < m_Rects.size(); ++pos) {
+      if (Intersects(pos, rect))
+        result.push_back(pos);
+    }
+    return result;
+  }
+
+  std::sort(candidates.begin(), candidates.end());
+  candidates.erase(std::unique(candidates.begin(), candidates.end()),
+                   candidates.end());
+  for (uint32_t pos : candidates) {
+    if (Intersects(pos, rect))
+      result.push_back(pos);
+  }
+  return result;
+}
+
+int CPDF_PageObjectGrid::GetColumn(float x) const {
+  return GetCell(x - m_Bounds.left, m_CellWidth, m_Columns);
+}
+
+int CPDF_PageObjectGrid::GetRow(float y) const {
+  return GetCell(y - m_Bounds.bottom, m_CellHeight, m_Rows);
+}
+
+CPDF_PageObjectGrid::CellRange CPDF_PageObjectGrid::GetCellRange(
+    const CFX_FloatRect& rect) const {
+  return {GetColumn(rect.left), GetColumn(rect.right), GetRow(rect.bottom),
+          GetRow(rect.top)};
+}
+
+bool CPDF_PageObjectGrid::Intersects(uint32_t pos,
+                                     const CFX_FloatRect& rect) const {
+  const CFX_FloatRect& object_rect = m_Rects[pos];
+  return !(object_rect.left > rect.right || object_rect.right < rect.left ||
+           object_rect.bottom > rect.top || object_rect.top < rect.bottom);
+}
@@ -0,0 +1,60 @@
+// Copyright 2020 PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FPDFAPI_PAGE_CPDF_PAGEOBJECTGRID_H_
+#define CORE_FPDFAPI_PAGE_CPDF_PAGEOBJECTGRID_H_
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "core/fxcrt/fx_coordinates.h"
+
+// Uniform grid over the bounding boxes of a page's objects, so that finding
+// the objects that intersect a region does not test every object. Objects are
+// identified by their position in paint order.
+class CPDF_PageObjectGrid {
+ public:
+  // |rects| holds the bounding box of each object, in paint order.
+  explicit CPDF_PageObjectGrid(std::vector<CFX_FloatRect> rects);
+  ~CPDF_PageObjectGrid();
+
+  size_t size() const { return m_Rects.size(); }
+
+  // Returns the positions, in increasing order, of the objects whose bounding
+  // boxes intersect |rect|. Touching edges count as intersecting, like the
+  // culling in CPDF_RenderStatus, and so do boxes with NaN coordinates.
+  std::vector<uint32_t> Query(const CFX_FloatRect& rect) const;
+
+ private:
+  struct CellRange {
+    int left;
+    int right;
+    int bottom;
+    int top;
+  };
+
+  int GetColumn(float x) const;
+  int GetRow(float y) const;
+  CellRange GetCellRange(const CFX_FloatRect& rect) const;
+  bool Intersects(uint32_t pos, const CFX_FloatRect& rect) const;
+
+  const std::vector<CFX_FloatRect> m_Rects;
+  CFX_FloatRect m_Bounds;
+  int m_Columns = 1;
+  int m_Rows = 1;
+  float m_CellWidth = 0;
+  float m_CellHeight = 0;
+
+  // The objects in cell |i| are m_CellEntries[m_CellStarts[i]] up to
+  // m_CellEntries[m_CellStarts[i + 1]].
+  std::vector<uint32_t> m_CellStarts;
+  std::vector<uint32_t> m_CellEntries;
+
+  // Objects that are checked on every query instead of being put in cells,
+  // because they cover too many cells or do not have finite bounds.
+  std::vector<uint32_t> m_Unbinned;
+};
+
+#endif  // CORE_FPDFAPI_PAGE_CPDF_PAGEOBJECTGRID_H_
@@ -0,0 +1,89 @@
+// Copyright 2020 PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfapi/page/cpdf_pageobjectgrid.h"
+
+#include <limits>
+#include <vector>
+
+#include "testing/gmock/include/gmock/gmock.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+std::vector<uint32_t> QueryByScanning(const std::vector<CFX_FloatRect>& rects,
+                                      const CFX_FloatRect& rect) {
+  std::vector<uint32_t> result;
+  for (uint32_t i = 0; i < rects.size(); ++i) {
+    if (!(rects[i].left > rect.right || rects[i].right < rect.left ||
+          rects[i].bottom > rect.top || rects[i].top < rect.bottom)) {
+      result.push_back(i);
+    }
+  }
+  return result;
+}
+
+}  // namespace
+
+TEST(CPDF_PageObjectGridTest, Empty) {
+  CPDF_PageObjectGrid grid({});
+  EXPECT_EQ(0u, grid.size());
+  EXPECT_TRUE(grid.Query(CFX_FloatRect(0, 0, 100, 100)).empty());
+}
+
+TEST(CPDF_PageObjectGridTest, TouchingEdges) {
+  CPDF_PageObjectGrid grid({CFX_FloatRect(0, 0, 10, 10),
+                            CFX_FloatRect(10, 10, 20, 20),
+                            CFX_FloatRect(30, 30, 40, 40)});
+  EXPECT_THAT(grid.Query(CFX_FloatRect(10, 10, 10, 10)),
+              testing::ElementsAre(0u, 1u));
+  EXPECT_THAT(grid.Query(CFX_FloatRect(20.5f, 20.5f, 29.5f, 29.5f)),
+              testing::ElementsAre());
+  EXPECT_THAT(grid.Query(CFX_FloatRect(-100, -100, 100, 100)),
+              testing::ElementsAre(0u, 1u, 2u));
+}
+
+TEST(CPDF_PageObjectGridTest, MatchesScanning) {
+  // Small objects in rows and columns, with a large background object first
+  // and objects that overlap neighboring cells.
+  std::vector<CFX_FloatRect> rects;
+  rects.emplace_back(0, 0, 1000, 1000);
+  for (int row = 0; row < 40; ++row) {
+    for (int col = 0; col < 40; ++col) {
+      float x = col * 25.0f;
+      float y = row * 25.0f;
+      rects.emplace_back(x, y, x + 20 + (col % 3) * 10, y + 20 + (row % 4) * 8);
+    }
+  }
+  CPDF_PageObjectGrid grid(rects);
+  ASSERT_EQ(rects.size(), grid.size());
+
+  for (float left = -50; left < 1000; left += 97) {
+    for (float bottom = -50; bottom < 1000; bottom += 89) {
+      for (float size : {0.0f, 3.0f, 60.0f, 400.0f}) {
+        CFX_FloatRect query(left, bottom, left + size, bottom + size);
+        EXPECT_EQ(QueryByScanning(rects, query), grid.Query(query));
+      }
+    }
+  }
+}
+
+TEST(CPDF_PageObjectGridTest, UnusualBounds) {
+  const float kNan = std::numeric_limits<float>::quiet_NaN();
+  const float kInf = std::numeric_limits<float>::infinity();
+  std::vector<CFX_FloatRect> rects;
+  for (int i = 0; i < 100; ++i)
+    rects.emplace_back(i * 10, 0, i * 10 + 5, 5);
+  rects.emplace_back(kNan, kNan, kNan, kNan);
+  rects.emplace_back(-kInf, -kInf, kInf, kInf);
+  rects.emplace_back(500, 500, 400, 400);
+  CPDF_PageObjectGrid grid(rects);
+
+  for (const CFX_FloatRect& query :
+       {CFX_FloatRect(0, 0, 1, 1), CFX_FloatRect(450, 0, 455, 2),
+        CFX_FloatRect(2000, 2000, 3000, 3000),
+        CFX_FloatRect(kNan, 0, 10, 10), CFX_FloatRect(-kInf, 0, kInf, 1)}) {
+    EXPECT_EQ(QueryByScanning(rects, query), grid.Query(query));
+  }
+}
@@ -13,6 +13,7 @@
 #include "core/fpdfapi/page/cpdf_allstates.h"
 #include "core/fpdfapi/page/cpdf_contentparser.h"
 #include "core/fpdfapi/page/cpdf_pageobject.h"
+#include "core/fpdfapi/page/cpdf_pageobjectgrid.h"
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
 #include "core/fpdfapi/parser/cpdf_document.h"
 #include "core/fxcrt/fx_extension.h"
@@ -20,6 +21,13 @@
 #include "third_party/base/check_op.h"
 #include "third_party/base/stl_util.h"
 
+namespace {
+
+// Below this many objects, testing each one is cheaper than using a grid.
+constexpr size_t kMinObjectsForGrid = 64;
+
+}  // namespace
+
 bool GraphicsData::operator<(const GraphicsData& other) const {
   if (!FXSYS_SafeEQ(fillAlpha, other.fillAlpha))
     return FXSYS_SafeLT(fillAlpha, other.fillAlpha);
@@ -111,6 +119,21 @@ void CPDF_PageObjectHolder::FontsMapInsert(const FontData& fd,
   m_FontsMap[fd] = str;
 }
 
+Optional<ByteString> CPDF_PageObjectHolder::GeneratedContentSearch(
+    const CPDF_PageObject* pPageObj) const {
+  auto it = m_GeneratedContentMap.find(pPageObj);
+  if (it == m_GeneratedContentMap.end())
+    return pdfium::nullopt;
+
+  return it->second;
+}
+
+void CPDF_PageObjectHolder::GeneratedContentInsert(
+    const CPDF_PageObject* pPageObj,
+    const ByteString& str) {
+  m_GeneratedContentMap[pPageObj] = str;
+}
+
 void CPDF_PageObjectHolder::LoadTransparencyInfo() {
   CPDF_Dictionary* pGroup = m_pDict->GetDictFor("Group");
   if (!pGroup)
@@ -135,6 +158,7 @@ CPDF_PageObject* CPDF_PageObjectHolder::GetPageObjectByIndex(
 void CPDF_PageObjectHolder::AppendPageObject(
     std::unique_ptr<CPDF_PageObject> pPageObj) {
   m_PageObjectList.push_back(std::move(pPageObj));
+  m_pObjectGrid.reset();
 }
 
 bool CPDF_PageObjectHolder::RemovePageObject(CPDF_PageObject* pPageObj) {
@@ -147,6 +171,9 @@ bool CPDF_PageObjectHolder::RemovePageObject(CPDF_PageObject* pPageObj) {
 
   it->release();
   m_PageObjectList.erase(it);
+  m_pObjectGrid.reset();
+  pPageObj->SetSpatialIndexHolder(nullptr);
+  m_GeneratedContentMap.erase(pPageObj);
 
   int32_t content_stream = pPageObj->GetContentStream();
   if (content_stream >= 0)
@@ -159,6 +186,47 @@ bool CPDF_PageObjectHolder::ErasePageObjectAtIndex(size_t index) {
   if (index >= m_PageObjectList.size())
     return false;
 
+  m_GeneratedContentMap.erase(m_PageObjectList[index].get());
   m_PageObjectList.erase(m_PageObjectList.begin() + index);
+  m_pObjectGrid.reset();
   return true;
 }
+
+std::vector<CPDF_PageObject*> CPDF_PageObjectHolder::GetPageObjectsInRect(
+    const CFX_FloatRect& rect) const {
+  std::vector<CPDF_PageObject*> result;
+  if (m_PageObjectList.size() < kMinObjectsForGrid) {
+    for (const auto& pObj : m_PageObjectList) {
+      if (!pObj)
+        continue;
+      const CFX_FloatRect& obj_rect = pObj->GetRect();
+      if (obj_rect.left > rect.right || obj_rect.right < rect.left ||
+          obj_rect.bottom > rect.top || obj_rect.top < rect.bottom) {
+        continue;
+      }
+      result.push_back(pObj.get());
+    }
+    return result;
+  }
+
+  if (!m_pObjectGrid) {
+    std::vector<CFX_FloatRect> rects;
+    rects.reserve(m_PageObjectList.size());
+    for (const auto& pObj : m_PageObjectList) {
+      if (pObj)
+        pObj->SetSpatialIndexHolder(this);
+      rects.push_back(pObj ? pObj->GetRect() : CFX_FloatRect());
+    }
+    m_pObjectGrid = std::make_unique<CPDF_PageObjectGrid>(std::move(rects));
+  }
+
+  for (uint32_t pos : m_pObjectGrid->Query(rect)) {
+    if (m_PageObjectList[pos])
+      result.push_back(m_PageObjectList[pos].get());
+  }
+  return result;
+}
+
+void CPDF_PageObjectHolder::OnPageObjectRectChanged() const {
+  m_pObjectGrid.reset();
+}
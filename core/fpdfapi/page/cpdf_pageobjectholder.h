@@ -26,6 +26,7 @@
 class CPDF_ContentParser;
 class CPDF_Document;
 class CPDF_PageObject;
+class CPDF_PageObjectGrid;
 class CPDF_Stream;
 class PauseIndicatorIface;
 
@@ -77,6 +78,15 @@ class CPDF_PageObjectHolder {
   bool RemovePageObject(CPDF_PageObject* pPageObj);
   bool ErasePageObjectAtIndex(size_t index);
 
+  // Returns the objects whose bounding boxes intersect |rect|, in paint order.
+  // On pages with many objects, this uses a grid that is built on first use
+  // and rebuilt after objects are added, removed or moved.
+  std::vector<CPDF_PageObject*> GetPageObjectsInRect(
+      const CFX_FloatRect& rect) const;
+
+  // Called by objects in the grid when their bounding box changes.
+  void OnPageObjectRectChanged() const;
+
   iterator begin() { return m_PageObjectList.begin(); }
   const_iterator begin() const { return m_PageObjectList.begin(); }
 
@@ -106,6 +116,17 @@ class CPDF_PageObjectHolder {
   Optional<ByteString> FontsMapSearch(const FontData& fd);
   void FontsMapInsert(const FontData& fd, const ByteString& str);
 
+  // Content stream operators last generated for |pPageObj|, which belongs to
+  // this holder. They stay valid until the object is marked dirty again.
+  // CPDF_PageContentGenerator writes them back for objects that are not dirty,
+  // even when other objects in the same stream changed. So any change to an
+  // object must be followed by SetDirty(true), or it is silently dropped the
+  // next time the stream is regenerated.
+  Optional<ByteString> GeneratedContentSearch(
+      const CPDF_PageObject* pPageObj) const;
+  void GeneratedContentInsert(const CPDF_PageObject* pPageObj,
+                              const ByteString& str);
+
  protected:
   void LoadTransparencyInfo();
 
@@ -126,8 +147,15 @@ class CPDF_PageObjectHolder {
   std::deque<std::unique_ptr<CPDF_PageObject>> m_PageObjectList;
   CFX_Matrix m_LastCTM;
 
+  // Lazily built by GetPageObjectsInRect(). Dropped when this holder's
+  // objects change, or when one of them moves.
+  mutable std::unique_ptr<CPDF_PageObjectGrid> m_pObjectGrid;
+
   // The indexes of Content streams that are dirty and need to be regenerated.
   std::set<int32_t> m_DirtyStreams;
+
+  // Entries are dropped when their object leaves this holder.
+  std::map<const CPDF_PageObject*, ByteString> m_GeneratedContentMap;
 };
 
 #endif  // CORE_FPDFAPI_PAGE_CPDF_PAGEOBJECTHOLDER_H_
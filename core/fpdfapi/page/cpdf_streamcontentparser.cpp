@@ -38,7 +38,6 @@
 #include "core/fxcrt/fx_safe_types.h"
 #include "core/fxge/cfx_graphstatedata.h"
 #include "third_party/base/check.h"
-#include "third_party/base/no_destructor.h"
 #include "third_party/base/notreached.h"
 #include "third_party/base/span.h"
 #include "third_party/base/stl_util.h"
@@ -414,134 +413,186 @@ void CPDF_StreamContentParser::SetGraphicStates(CPDF_PageObject* pObj,
   }
 }
 
+// Content operators are at most 3 characters long, so their GetID() values
+// differ in the top 24 bits only. |kMultiplier| was chosen so that the top 8
+// bits of the product are distinct for every operator PDFium handles.
+struct CPDF_StreamContentParser::OpCodeTable {
+  struct Entry {
+    uint32_t id;
+    OpHandler handler;
+  };
+
+  static constexpr uint32_t kMultiplier = 6167;
+  static constexpr size_t kSize = 256;
+
+  static constexpr size_t Hash(uint32_t id) {
+    return (id * kMultiplier) >> 24;
+  }
+
+  constexpr void Add(uint32_t id, OpHandler handler) {
+    Entry& entry = entries[Hash(id)];
+    if (entry.handler)
+      has_collision = true;
+    entry.id = id;
+    entry.handler = handler;
+  }
+
+  Entry entries[kSize] = {};
+  bool has_collision = false;
+};
+
 // static
-CPDF_StreamContentParser::OpCodes
+constexpr CPDF_StreamContentParser::OpCodeTable
 CPDF_StreamContentParser::InitializeOpCodes() {
-  return OpCodes({
-      {FXBSTR_ID('"', 0, 0, 0),
-       &CPDF_StreamContentParser::Handle_NextLineShowText_Space},
-      {FXBSTR_ID('\'', 0, 0, 0),
-       &CPDF_StreamContentParser::Handle_NextLineShowText},
-      {FXBSTR_ID('B', 0, 0, 0),
-       &CPDF_StreamContentParser::Handle_FillStrokePath},
-      {FXBSTR_ID('B', '*', 0, 0),
-       &CPDF_StreamContentParser::Handle_EOFillStrokePath},
-      {FXBSTR_ID('B', 'D', 'C', 0),
-       &CPDF_StreamContentParser::Handle_BeginMarkedContent_Dictionary},
-      {FXBSTR_ID('B', 'I', 0, 0), &CPDF_StreamContentParser::Handle_BeginImage},
-      {FXBSTR_ID('B', 'M', 'C', 0),
-       &CPDF_StreamContentParser::Handle_BeginMarkedContent},
-      {FXBSTR_ID('B', 'T', 0, 0), &CPDF_StreamContentParser::Handle_BeginText},
-      {FXBSTR_ID('C', 'S', 0, 0),
-       &CPDF_StreamContentParser::Handle_SetColorSpace_Stroke},
-      {FXBSTR_ID('D', 'P', 0, 0),
-       &CPDF_StreamContentParser::Handle_MarkPlace_Dictionary},
-      {FXBSTR_ID('D', 'o', 0, 0),
-       &CPDF_StreamContentParser::Handle_ExecuteXObject},
-      {FXBSTR_ID('E', 'I', 0, 0), &CPDF_StreamContentParser::Handle_EndImage},
-      {FXBSTR_ID('E', 'M', 'C', 0),
-       &CPDF_StreamContentParser::Handle_EndMarkedContent},
-      {FXBSTR_ID('E', 'T', 0, 0), &CPDF_StreamContentParser::Handle_EndText},
-      {FXBSTR_ID('F', 0, 0, 0), &CPDF_StreamContentParser::Handle_FillPathOld},
-      {FXBSTR_ID('G', 0, 0, 0),
-       &CPDF_StreamContentParser::Handle_SetGray_Stroke},
-      {FXBSTR_ID('I', 'D', 0, 0),
-       &CPDF_StreamContentParser::Handle_BeginImageData},
-      {FXBSTR_ID('J', 0, 0, 0), &CPDF_StreamContentParser::Handle_SetLineCap},
-      {FXBSTR_ID('K', 0, 0, 0),
-       &CPDF_StreamContentParser::Handle_SetCMYKColor_Stroke},
-      {FXBSTR_ID('M', 0, 0, 0),
-       &CPDF_StreamContentParser::Handle_SetMiterLimit},
-      {FXBSTR_ID('M', 'P', 0, 0), &CPDF_StreamContentParser::Handle_MarkPlace},
-      {FXBSTR_ID('Q', 0, 0, 0),
-       &CPDF_StreamContentParser::Handle_RestoreGraphState},
-      {FXBSTR_ID('R', 'G', 0, 0),
-       &CPDF_StreamContentParser::Handle_SetRGBColor_Stroke},
-      {FXBSTR_ID('S', 0, 0, 0), &CPDF_StreamContentParser::Handle_StrokePath},
-      {FXBSTR_ID('S', 'C', 0, 0),
-       &CPDF_StreamContentParser::Handle_SetColor_Stroke},
-      {FXBSTR_ID('S', 'C', 'N', 0),
-       &CPDF_StreamContentParser::Handle_SetColorPS_Stroke},
-      {FXBSTR_ID('T', '*', 0, 0),
-       &CPDF_StreamContentParser::Handle_MoveToNextLine},
-      {FXBSTR_ID('T', 'D', 0, 0),
-       &CPDF_StreamContentParser::Handle_MoveTextPoint_SetLeading},
-      {FXBSTR_ID('T', 'J', 0, 0),
-       &CPDF_StreamContentParser::Handle_ShowText_Positioning},
-      {FXBSTR_ID('T', 'L', 0, 0),
-       &CPDF_StreamContentParser::Handle_SetTextLeading},
-      {FXBSTR_ID('T', 'c', 0, 0),
-       &CPDF_StreamContentParser::Handle_SetCharSpace},
-      {FXBSTR_ID('T', 'd', 0, 0),
-       &CPDF_StreamContentParser::Handle_MoveTextPoint},
-      {FXBSTR_ID('T', 'f', 0, 0), &CPDF_StreamContentParser::Handle_SetFont},
-      {FXBSTR_ID('T', 'j', 0, 0), &CPDF_StreamContentParser::Handle_ShowText},
-      {FXBSTR_ID('T', 'm', 0, 0),
-       &CPDF_StreamContentParser::Handle_SetTextMatrix},
-      {FXBSTR_ID('T', 'r', 0, 0),
-       &CPDF_StreamContentParser::Handle_SetTextRenderMode},
-      {FXBSTR_ID('T', 's', 0, 0),
-       &CPDF_StreamContentParser::Handle_SetTextRise},
-      {FXBSTR_ID('T', 'w', 0, 0),
-       &CPDF_StreamContentParser::Handle_SetWordSpace},
-      {FXBSTR_ID('T', 'z', 0, 0),
-       &CPDF_StreamContentParser::Handle_SetHorzScale},
-      {FXBSTR_ID('W', 0, 0, 0), &CPDF_StreamContentParser::Handle_Clip},
-      {FXBSTR_ID('W', '*', 0, 0), &CPDF_StreamContentParser::Handle_EOClip},
-      {FXBSTR_ID('b', 0, 0, 0),
-       &CPDF_StreamContentParser::Handle_CloseFillStrokePath},
-      {FXBSTR_ID('b', '*', 0, 0),
-       &CPDF_StreamContentParser::Handle_CloseEOFillStrokePath},
-      {FXBSTR_ID('c', 0, 0, 0), &CPDF_StreamContentParser::Handle_CurveTo_123},
-      {FXBSTR_ID('c', 'm', 0, 0),
-       &CPDF_StreamContentParser::Handle_ConcatMatrix},
-      {FXBSTR_ID('c', 's', 0, 0),
-       &CPDF_StreamContentParser::Handle_SetColorSpace_Fill},
-      {FXBSTR_ID('d', 0, 0, 0), &CPDF_StreamContentParser::Handle_SetDash},
-      {FXBSTR_ID('d', '0', 0, 0),
-       &CPDF_StreamContentParser::Handle_SetCharWidth},
-      {FXBSTR_ID('d', '1', 0, 0),
-       &CPDF_StreamContentParser::Handle_SetCachedDevice},
-      {FXBSTR_ID('f', 0, 0, 0), &CPDF_StreamContentParser::Handle_FillPath},
-      {FXBSTR_ID('f', '*', 0, 0), &CPDF_StreamContentParser::Handle_EOFillPath},
-      {FXBSTR_ID('g', 0, 0, 0), &CPDF_StreamContentParser::Handle_SetGray_Fill},
-      {FXBSTR_ID('g', 's', 0, 0),
-       &CPDF_StreamContentParser::Handle_SetExtendGraphState},
-      {FXBSTR_ID('h', 0, 0, 0), &CPDF_StreamContentParser::Handle_ClosePath},
-      {FXBSTR_ID('i', 0, 0, 0), &CPDF_StreamContentParser::Handle_SetFlat},
-      {FXBSTR_ID('j', 0, 0, 0), &CPDF_StreamContentParser::Handle_SetLineJoin},
-      {FXBSTR_ID('k', 0, 0, 0),
-       &CPDF_StreamContentParser::Handle_SetCMYKColor_Fill},
-      {FXBSTR_ID('l', 0, 0, 0), &CPDF_StreamContentParser::Handle_LineTo},
-      {FXBSTR_ID('m', 0, 0, 0), &CPDF_StreamContentParser::Handle_MoveTo},
-      {FXBSTR_ID('n', 0, 0, 0), &CPDF_StreamContentParser::Handle_EndPath},
-      {FXBSTR_ID('q', 0, 0, 0),
-       &CPDF_StreamContentParser::Handle_SaveGraphState},
-      {FXBSTR_ID('r', 'e', 0, 0), &CPDF_StreamContentParser::Handle_Rectangle},
-      {FXBSTR_ID('r', 'g', 0, 0),
-       &CPDF_StreamContentParser::Handle_SetRGBColor_Fill},
-      {FXBSTR_ID('r', 'i', 0, 0),
-       &CPDF_StreamContentParser::Handle_SetRenderIntent},
-      {FXBSTR_ID('s', 0, 0, 0),
-       &CPDF_StreamContentParser::Handle_CloseStrokePath},
-      {FXBSTR_ID('s', 'c', 0, 0),
-       &CPDF_StreamContentParser::Handle_SetColor_Fill},
-      {FXBSTR_ID('s', 'c', 'n', 0),
-       &CPDF_StreamContentParser::Handle_SetColorPS_Fill},
-      {FXBSTR_ID('s', 'h', 0, 0), &CPDF_StreamContentParser::Handle_ShadeFill},
-      {FXBSTR_ID('v', 0, 0, 0), &CPDF_StreamContentParser::Handle_CurveTo_23},
-      {FXBSTR_ID('w', 0, 0, 0), &CPDF_StreamContentParser::Handle_SetLineWidth},
-      {FXBSTR_ID('y', 0, 0, 0), &CPDF_StreamContentParser::Handle_CurveTo_13},
-  });
+  OpCodeTable table;
+  table.Add(FXBSTR_ID('"', 0, 0, 0),
+            &CPDF_StreamContentParser::Handle_NextLineShowText_Space);
+  table.Add(FXBSTR_ID('\'', 0, 0, 0),
+            &CPDF_StreamContentParser::Handle_NextLineShowText);
+  table.Add(FXBSTR_ID('B', 0, 0, 0),
+            &CPDF_StreamContentParser::Handle_FillStrokePath);
+  table.Add(FXBSTR_ID('B', '*', 0, 0),
+            &CPDF_StreamContentParser::Handle_EOFillStrokePath);
+  table.Add(FXBSTR_ID('B', 'D', 'C', 0),
+            &CPDF_StreamContentParser::Handle_BeginMarkedContent_Dictionary);
+  table.Add(FXBSTR_ID('B', 'I', 0, 0),
+            &CPDF_StreamContentParser::Handle_BeginImage);
+  table.Add(FXBSTR_ID('B', 'M', 'C', 0),
+            &CPDF_StreamContentParser::Handle_BeginMarkedContent);
+  table.Add(FXBSTR_ID('B', 'T', 0, 0),
+            &CPDF_StreamContentParser::Handle_BeginText);
+  table.Add(FXBSTR_ID('C', 'S', 0, 0),
+            &CPDF_StreamContentParser::Handle_SetColorSpace_Stroke);
+  table.Add(FXBSTR_ID('D', 'P', 0, 0),
+            &CPDF_StreamContentParser::Handle_MarkPlace_Dictionary);
+  table.Add(FXBSTR_ID('D', 'o', 0, 0),
+            &CPDF_StreamContentParser::Handle_ExecuteXObject);
+  table.Add(FXBSTR_ID('E', 'I', 0, 0),
+            &CPDF_StreamContentParser::Handle_EndImage);
+  table.Add(FXBSTR_ID('E', 'M', 'C', 0),
+            &CPDF_StreamContentParser::Handle_EndMarkedContent);
+  table.Add(FXBSTR_ID('E', 'T', 0, 0),
+            &CPDF_StreamContentParser::Handle_EndText);
+  table.Add(FXBSTR_ID('F', 0, 0, 0),
+            &CPDF_StreamContentParser::Handle_FillPathOld);
+  table.Add(FXBSTR_ID('G', 0, 0, 0),
+            &CPDF_StreamContentParser::Handle_SetGray_Stroke);
+  table.Add(FXBSTR_ID('I', 'D', 0, 0),
+            &CPDF_StreamContentParser::Handle_BeginImageData);
+  table.Add(FXBSTR_ID('J', 0, 0, 0),
+            &CPDF_StreamContentParser::Handle_SetLineCap);
+  table.Add(FXBSTR_ID('K', 0, 0, 0),
+            &CPDF_StreamContentParser::Handle_SetCMYKColor_Stroke);
+  table.Add(FXBSTR_ID('M', 0, 0, 0),
+            &CPDF_StreamContentParser::Handle_SetMiterLimit);
+  table.Add(FXBSTR_ID('M', 'P', 0, 0),
+            &CPDF_StreamContentParser::Handle_MarkPlace);
+  table.Add(FXBSTR_ID('Q', 0, 0, 0),
+            &CPDF_StreamContentParser::Handle_RestoreGraphState);
+  table.Add(FXBSTR_ID('R', 'G', 0, 0),
+            &CPDF_StreamContentParser::Handle_SetRGBColor_Stroke);
+  table.Add(FXBSTR_ID('S', 0, 0, 0),
+            &CPDF_StreamContentParser::Handle_StrokePath);
+  table.Add(FXBSTR_ID('S', 'C', 0, 0),
+            &CPDF_StreamContentParser::Handle_SetColor_Stroke);
+  table.Add(FXBSTR_ID('S', 'C', 'N', 0),
+            &CPDF_StreamContentParser::Handle_SetColorPS_Stroke);
+  table.Add(FXBSTR_ID('T', '*', 0, 0),
+            &CPDF_StreamContentParser::Handle_MoveToNextLine);
+  table.Add(FXBSTR_ID('T', 'D', 0, 0),
+            &CPDF_StreamContentParser::Handle_MoveTextPoint_SetLeading);
+  table.Add(FXBSTR_ID('T', 'J', 0, 0),
+            &CPDF_StreamContentParser::Handle_ShowText_Positioning);
+  table.Add(FXBSTR_ID('T', 'L', 0, 0),
+            &CPDF_StreamContentParser::Handle_SetTextLeading);
+  table.Add(FXBSTR_ID('T', 'c', 0, 0),
+            &CPDF_StreamContentParser::Handle_SetCharSpace);
+  table.Add(FXBSTR_ID('T', 'd', 0, 0),
+            &CPDF_StreamContentParser::Handle_MoveTextPoint);
+  table.Add(FXBSTR_ID('T', 'f', 0, 0),
+            &CPDF_StreamContentParser::Handle_SetFont);
+  table.Add(FXBSTR_ID('T', 'j', 0, 0),
+            &CPDF_StreamContentParser::Handle_ShowText);
+  table.Add(FXBSTR_ID('T', 'm', 0, 0),
+            &CPDF_StreamContentParser::Handle_SetTextMatrix);
+  table.Add(FXBSTR_ID('T', 'r', 0, 0),
+            &CPDF_StreamContentParser::Handle_SetTextRenderMode);
+  table.Add(FXBSTR_ID('T', 's', 0, 0),
+            &CPDF_StreamContentParser::Handle_SetTextRise);
+  table.Add(FXBSTR_ID('T', 'w', 0, 0),
+            &CPDF_StreamContentParser::Handle_SetWordSpace);
+  table.Add(FXBSTR_ID('T', 'z', 0, 0),
+            &CPDF_StreamContentParser::Handle_SetHorzScale);
+  table.Add(FXBSTR_ID('W', 0, 0, 0), &CPDF_StreamContentParser::Handle_Clip);
+  table.Add(FXBSTR_ID('W', '*', 0, 0),
+            &CPDF_StreamContentParser::Handle_EOClip);
+  table.Add(FXBSTR_ID('b', 0, 0, 0),
+            &CPDF_StreamContentParser::Handle_CloseFillStrokePath);
+  table.Add(FXBSTR_ID('b', '*', 0, 0),
+            &CPDF_StreamContentParser::Handle_CloseEOFillStrokePath);
+  table.Add(FXBSTR_ID('c', 0, 0, 0),
+            &CPDF_StreamContentParser::Handle_CurveTo_123);
+  table.Add(FXBSTR_ID('c', 'm', 0, 0),
+            &CPDF_StreamContentParser::Handle_ConcatMatrix);
+  table.Add(FXBSTR_ID('c', 's', 0, 0),
+            &CPDF_StreamContentParser::Handle_SetColorSpace_Fill);
+  table.Add(FXBSTR_ID('d', 0, 0, 0), &CPDF_StreamContentParser::Handle_SetDash);
+  table.Add(FXBSTR_ID('d', '0', 0, 0),
+            &CPDF_StreamContentParser::Handle_SetCharWidth);
+  table.Add(FXBSTR_ID('d', '1', 0, 0),
+            &CPDF_StreamContentParser::Handle_SetCachedDevice);
+  table.Add(FXBSTR_ID('f', 0, 0, 0),
+            &CPDF_StreamContentParser::Handle_FillPath);
+  table.Add(FXBSTR_ID('f', '*', 0, 0),
+            &CPDF_StreamContentParser::Handle_EOFillPath);
+  table.Add(FXBSTR_ID('g', 0, 0, 0),
+            &CPDF_StreamContentParser::Handle_SetGray_Fill);
+  table.Add(FXBSTR_ID('g', 's', 0, 0),
+            &CPDF_StreamContentParser::Handle_SetExtendGraphState);
+  table.Add(FXBSTR_ID('h', 0, 0, 0),
+            &CPDF_StreamContentParser::Handle_ClosePath);
+  table.Add(FXBSTR_ID('i', 0, 0, 0), &CPDF_StreamContentParser::Handle_SetFlat);
+  table.Add(FXBSTR_ID('j', 0, 0, 0),
+            &CPDF_StreamContentParser::Handle_SetLineJoin);
+  table.Add(FXBSTR_ID('k', 0, 0, 0),
+            &CPDF_StreamContentParser::Handle_SetCMYKColor_Fill);
+  table.Add(FXBSTR_ID('l', 0, 0, 0), &CPDF_StreamContentParser::Handle_LineTo);
+  table.Add(FXBSTR_ID('m', 0, 0, 0), &CPDF_StreamContentParser::Handle_MoveTo);
+  table.Add(FXBSTR_ID('n', 0, 0, 0), &CPDF_StreamContentParser::Handle_EndPath);
+  table.Add(FXBSTR_ID('q', 0, 0, 0),
+            &CPDF_StreamContentParser::Handle_SaveGraphState);
+  table.Add(FXBSTR_ID('r', 'e', 0, 0),
+            &CPDF_StreamContentParser::Handle_Rectangle);
+  table.Add(FXBSTR_ID('r', 'g', 0, 0),
+            &CPDF_StreamContentParser::Handle_SetRGBColor_Fill);
+  table.Add(FXBSTR_ID('r', 'i', 0, 0),
+            &CPDF_StreamContentParser::Handle_SetRenderIntent);
+  table.Add(FXBSTR_ID('s', 0, 0, 0),
+            &CPDF_StreamContentParser::Handle_CloseStrokePath);
+  table.Add(FXBSTR_ID('s', 'c', 0, 0),
+            &CPDF_StreamContentParser::Handle_SetColor_Fill);
+  table.Add(FXBSTR_ID('s', 'c', 'n', 0),
+            &CPDF_StreamContentParser::Handle_SetColorPS_Fill);
+  table.Add(FXBSTR_ID('s', 'h', 0, 0),
+            &CPDF_StreamContentParser::Handle_ShadeFill);
+  table.Add(FXBSTR_ID('v', 0, 0, 0),
+            &CPDF_StreamContentParser::Handle_CurveTo_23);
+  table.Add(FXBSTR_ID('w', 0, 0, 0),
+            &CPDF_StreamContentParser::Handle_SetLineWidth);
+  table.Add(FXBSTR_ID('y', 0, 0, 0),
+            &CPDF_StreamContentParser::Handle_CurveTo_13);
+  return table;
 }
 
 void CPDF_StreamContentParser::OnOperator(ByteStringView op) {
-  static const pdfium::base::NoDestructor<OpCodes> s_OpCodes(
-      InitializeOpCodes());
-
-  auto it = s_OpCodes->find(op.GetID());
-  if (it != s_OpCodes->end())
-    (this->*it->second)();
+  static constexpr OpCodeTable kOpCodes = InitializeOpCodes();
+  static_assert(!kOpCodes.has_collision,
+                "OpCodeTable::kMultiplier must hash operators uniquely");
+
+  const uint32_t id = op.GetID();
+  const OpCodeTable::Entry& entry = kOpCodes.entries[OpCodeTable::Hash(id)];
+  if (entry.handler && entry.id == id)
+    (this->*entry.handler)();
 }
 
 void CPDF_StreamContentParser::Handle_CloseFillStrokePath() {
@@ -7,7 +7,6 @@
 #ifndef CORE_FPDFAPI_PAGE_CPDF_STREAMCONTENTPARSER_H_
 #define CORE_FPDFAPI_PAGE_CPDF_STREAMCONTENTPARSER_H_
 
-#include <map>
 #include <memory>
 #include <set>
 #include <stack>
@@ -80,8 +79,9 @@ class CPDF_StreamContentParser {
 
   static constexpr int kParamBufSize = 16;
 
-  using OpCodes = std::map<uint32_t, void (CPDF_StreamContentParser::*)()>;
-  static OpCodes InitializeOpCodes();
+  using OpHandler = void (CPDF_StreamContentParser::*)();
+  struct OpCodeTable;
+  static constexpr OpCodeTable InitializeOpCodes();
 
   void AddNameParam(ByteStringView bsName);
   void AddNumberParam(ByteStringView str);
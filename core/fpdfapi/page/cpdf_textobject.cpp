@@ -186,6 +186,7 @@ CFX_Matrix CPDF_TextObject::GetTextMatrix() const {
 void CPDF_TextObject::SetSegments(const ByteString* pStrs,
                                   const std::vector<float>& kernings,
                                   size_t nSegs) {
+  ResetCachedCharPosList();
   m_CharCodes.clear();
   m_CharPos.clear();
   RetainPtr<CPDF_Font> pFont = GetFont();
@@ -248,6 +249,7 @@ void CPDF_TextObject::SetTextRenderMode(TextRenderingMode mode) {
 }
 
 CFX_PointF CPDF_TextObject::CalcPositionData(float horz_scale) {
+  ResetCachedCharPosList();
   float curpos = 0;
   float min_x = 10000 * 1.0f;
   float max_x = -10000 * 1.0f;
@@ -334,3 +336,25 @@ CFX_PointF CPDF_TextObject::CalcPositionData(float horz_scale) {
 void CPDF_TextObject::RecalcPositionData() {
   CalcPositionData(1);
 }
+
+const std::vector<TextCharPos>* CPDF_TextObject::GetCachedCharPosList() const {
+  if (!m_bHasCachedCharPosList || m_pCachedCharPosFont != GetFont() ||
+      m_CachedCharPosFontSize != GetFontSize()) {
+    return nullptr;
+  }
+  return &m_CachedCharPosList;
+}
+
+void CPDF_TextObject::SetCachedCharPosList(
+    std::vector<TextCharPos> char_pos_list) const {
+  m_CachedCharPosList = std::move(char_pos_list);
+  m_pCachedCharPosFont = GetFont();
+  m_CachedCharPosFontSize = GetFontSize();
+  m_bHasCachedCharPosList = true;
+}
+
+void CPDF_TextObject::ResetCachedCharPosList() {
+  m_CachedCharPosList.clear();
+  m_pCachedCharPosFont.Reset();
+  m_bHasCachedCharPosList = false;
+}
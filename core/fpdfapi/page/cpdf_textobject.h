@@ -14,6 +14,7 @@
 #include "core/fxcrt/fx_string.h"
 #include "core/fxcrt/fx_system.h"
 #include "core/fxcrt/retain_ptr.h"
+#include "core/fxge/text_char_pos.h"
 
 class CPDF_TextObjectItem {
  public:
@@ -71,10 +72,30 @@ class CPDF_TextObject final : public CPDF_PageObject {
                    size_t nSegs);
   CFX_PointF CalcPositionData(float horz_scale);
 
+  // Glyph layout of the text in text space, as computed by the renderer from
+  // the char codes, positions, font and font size. Returns nullptr if none was
+  // set, or if any of those inputs changed since.
+  //
+  // The layout is not bounded by any budget: once rendered, a text object
+  // keeps it until the text changes or the object is destroyed, usually along
+  // with its page. That costs one TextCharPos per glyph for every rendered
+  // text object, in exchange for not laying out text again on every render.
+  const std::vector<TextCharPos>* GetCachedCharPosList() const;
+  void SetCachedCharPosList(std::vector<TextCharPos> char_pos_list) const;
+
  private:
+  void ResetCachedCharPosList();
+
   CFX_PointF m_Pos;
   std::vector<uint32_t> m_CharCodes;
   std::vector<float> m_CharPos;
+
+  // Set by SetCachedCharPosList(). The font and font size live in the shared
+  // text state, so they are recorded to notice changes made there.
+  mutable std::vector<TextCharPos> m_CachedCharPosList;
+  mutable RetainPtr<CPDF_Font> m_pCachedCharPosFont;
+  mutable float m_CachedCharPosFontSize = 0;
+  mutable bool m_bHasCachedCharPosList = false;
 };
 
 #endif  // CORE_FPDFAPI_PAGE_CPDF_TEXTOBJECT_H_
@@ -9,7 +9,6 @@
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
 #include "core/fpdfapi/parser/cpdf_parser.h"
 #include "third_party/base/notreached.h"
-#include "third_party/base/stl_util.h"
 
 // static
 std::unique_ptr<CPDF_CrossRefTable> CPDF_CrossRefTable::MergeUp(
@@ -88,19 +87,28 @@ void CPDF_CrossRefTable::SetFree(uint32_t obj_num) {
   info.pos = 0;
 }
 
+void CPDF_CrossRefTable::SetObjectInfo(uint32_t obj_num,
+                                       const ObjectInfo& info) {
+  if (obj_num >= CPDF_Parser::kMaxObjectNumber) {
+    NOTREACHED();
+    return;
+  }
+
+  objects_info_[obj_num] = info;
+}
+
 void CPDF_CrossRefTable::SetTrailer(RetainPtr<CPDF_Dictionary> trailer) {
   trailer_ = std::move(trailer);
 }
 
 const CPDF_CrossRefTable::ObjectInfo* CPDF_CrossRefTable::GetObjectInfo(
     uint32_t obj_num) const {
-  const auto it = objects_info_.find(obj_num);
-  return it != objects_info_.end() ? &it->second : nullptr;
+  return objects_info_.Find(obj_num);
 }
 
 void CPDF_CrossRefTable::Update(
     std::unique_ptr<CPDF_CrossRefTable> new_cross_ref) {
-  UpdateInfo(std::move(new_cross_ref->objects_info_));
+  UpdateInfo(new_cross_ref->objects_info_);
   UpdateTrailer(std::move(new_cross_ref->trailer_));
 }
 
@@ -110,35 +118,24 @@ void CPDF_CrossRefTable::ShrinkObjectMap(uint32_t objnum) {
     return;
   }
 
-  objects_info_.erase(objects_info_.lower_bound(objnum), objects_info_.end());
+  objects_info_.EraseFrom(objnum);
 
-  if (!pdfium::Contains(objects_info_, objnum - 1))
+  if (!objects_info_.Contains(objnum - 1))
     objects_info_[objnum - 1].pos = 0;
 }
 
 void CPDF_CrossRefTable::UpdateInfo(
-    std::map<uint32_t, ObjectInfo>&& new_objects_info) {
-  auto cur_it = objects_info_.begin();
-  auto new_it = new_objects_info.begin();
-  while (cur_it != objects_info_.end() && new_it != new_objects_info.end()) {
-    if (cur_it->first == new_it->first) {
-      if (cur_it->second.type == ObjectType::kObjStream &&
-          new_it->second.type == ObjectType::kNormal) {
-        new_it->second.type = ObjectType::kObjStream;
-      }
-      ++cur_it;
-      ++new_it;
-    } else if (cur_it->first < new_it->first) {
-      new_objects_info.insert(new_it, *cur_it);
-      ++cur_it;
-    } else {
-      new_it = new_objects_info.lower_bound(cur_it->first);
-    }
-  }
-  for (; cur_it != objects_info_.end(); ++cur_it) {
-    new_objects_info.insert(new_objects_info.end(), *cur_it);
+    const FlatIndexMap<ObjectInfo>& new_objects_info) {
+  // Apply the (usually much smaller) update on top of the current table, so
+  // the cost is proportional to the size of the update.
+  for (const auto& it : new_objects_info) {
+    ObjectInfo& info = objects_info_[it.first];
+    const bool keep_obj_stream = info.type == ObjectType::kObjStream &&
+                                 it.second.type == ObjectType::kNormal;
+    info = it.second;
+    if (keep_obj_stream)
+      info.type = ObjectType::kObjStream;
   }
-  objects_info_ = std::move(new_objects_info);
 }
 
 void CPDF_CrossRefTable::UpdateTrailer(RetainPtr<CPDF_Dictionary> new_trailer) {
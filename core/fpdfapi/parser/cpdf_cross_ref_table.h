@@ -5,9 +5,9 @@
 #ifndef CORE_FPDFAPI_PARSER_CPDF_CROSS_REF_TABLE_H_
 #define CORE_FPDFAPI_PARSER_CPDF_CROSS_REF_TABLE_H_
 
-#include <map>
 #include <memory>
 
+#include "core/fxcrt/flat_index_map.h"
 #include "core/fxcrt/fx_system.h"
 #include "core/fxcrt/retain_ptr.h"
 
@@ -49,6 +49,8 @@ class CPDF_CrossRefTable {
   void AddCompressed(uint32_t obj_num, uint32_t archive_obj_num);
   void AddNormal(uint32_t obj_num, uint16_t gen_num, FX_FILESIZE pos);
   void SetFree(uint32_t obj_num);
+  // Stores |info| as is, e.g. when restoring a previously resolved table.
+  void SetObjectInfo(uint32_t obj_num, const ObjectInfo& info);
 
   void SetTrailer(RetainPtr<CPDF_Dictionary> trailer);
   const CPDF_Dictionary* trailer() const { return trailer_.Get(); }
@@ -56,7 +58,7 @@ class CPDF_CrossRefTable {
 
   const ObjectInfo* GetObjectInfo(uint32_t obj_num) const;
 
-  const std::map<uint32_t, ObjectInfo>& objects_info() const {
+  const FlatIndexMap<ObjectInfo>& objects_info() const {
     return objects_info_;
   }
 
@@ -65,11 +67,11 @@ class CPDF_CrossRefTable {
   void ShrinkObjectMap(uint32_t objnum);
 
  private:
-  void UpdateInfo(std::map<uint32_t, ObjectInfo>&& new_objects_info);
+  void UpdateInfo(const FlatIndexMap<ObjectInfo>& new_objects_info);
   void UpdateTrailer(RetainPtr<CPDF_Dictionary> new_trailer);
 
   RetainPtr<CPDF_Dictionary> trailer_;
-  std::map<uint32_t, ObjectInfo> objects_info_;
+  FlatIndexMap<ObjectInfo> objects_info_;
 };
 
 #endif  // CORE_FPDFAPI_PARSER_CPDF_CROSS_REF_TABLE_H_
@@ -439,6 +439,8 @@ bool CPDF_DataAvail::CheckHintTables() {
   CPDF_ReadValidator::ScopedSession read_session(GetValidator());
   m_pHintTables =
       CPDF_HintTables::Parse(GetSyntaxParser(), m_pLinearized.get());
+  if (m_pHintTables)
+    m_pHintTables->SetPrefetchPageCount(m_PrefetchPageCount);
 
   if (GetValidator()->read_error()) {
     m_docStatus = PDF_DATAAVAIL_ERROR;
@@ -782,6 +784,16 @@ CPDF_DataAvail::DocAvailStatus CPDF_DataAvail::CheckLinearizedData() {
   return m_bLinearedDataOK ? DataAvailable : DataNotAvailable;
 }
 
+void CPDF_DataAvail::SetPrefetchPageCount(uint32_t count) {
+  m_PrefetchPageCount = count;
+  if (m_pHintTables)
+    m_pHintTables->SetPrefetchPageCount(count);
+}
+
+void CPDF_DataAvail::SetAsyncDownloadHints(DownloadHints* pHints) {
+  GetValidator()->SetAsyncDownloadHints(pHints);
+}
+
 CPDF_DataAvail::DocAvailStatus CPDF_DataAvail::IsPageAvail(
     uint32_t dwPage,
     DownloadHints* pHints) {
@@ -115,6 +115,16 @@ class CPDF_DataAvail final : public Observable::ObserverIface {
 
   const CPDF_HintTables* GetHintTables() const { return m_pHintTables.get(); }
 
+  // For linearized documents with hint tables, makes IsPageAvail() request
+  // the data of up to |count| following pages together with the data of the
+  // page it checks, in as few requests as possible.
+  void SetPrefetchPageCount(uint32_t count);
+
+  // Makes reads of unavailable data request it through |pHints| whenever
+  // IsDocAvail() and the like are not running, and lets page content parsing
+  // wait for it. Passing nullptr turns this off. |pHints| must outlive this.
+  void SetAsyncDownloadHints(DownloadHints* pHints);
+
  private:
   class PageNode {
    public:
@@ -193,6 +203,7 @@ class CPDF_DataAvail final : public Observable::ObserverIface {
   std::set<uint32_t> m_pagesLoadState;
   std::unique_ptr<CPDF_HintTables> m_pHintTables;
   const bool m_bSupportHintTable;
+  uint32_t m_PrefetchPageCount = 0;
   std::map<uint32_t, std::unique_ptr<CPDF_PageObjectAvail>> m_PagesObjAvail;
   std::map<const CPDF_Object*, std::unique_ptr<CPDF_PageObjectAvail>>
       m_PagesResourcesAvail;
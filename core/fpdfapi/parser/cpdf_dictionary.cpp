@@ -32,7 +32,7 @@ CPDF_Dictionary::~CPDF_Dictionary() {
   // Mark the object as deleted so that it will not be deleted again,
   // and break cyclic references.
   m_ObjNum = kInvalidObjNum;
-  for (auto& it : m_Map) {
+  for (auto it : m_Map) {
     if (it.second && it.second->GetObjNum() == kInvalidObjNum)
       it.second.Leak();
   }
@@ -76,15 +76,15 @@ RetainPtr<CPDF_Object> CPDF_Dictionary::CloneNonCyclic(
     if (!pdfium::Contains(*pVisited, it.second.Get())) {
       std::set<const CPDF_Object*> visited(*pVisited);
       if (auto obj = it.second->CloneNonCyclic(bDirect, &visited))
-        pCopy->m_Map.insert(std::make_pair(it.first, std::move(obj)));
+        pCopy->m_Map[it.first] = std::move(obj);
     }
   }
   return pCopy;
 }
 
 const CPDF_Object* CPDF_Dictionary::GetObjectFor(const ByteString& key) const {
-  auto it = m_Map.find(key);
-  return it != m_Map.end() ? it->second.Get() : nullptr;
+  const RetainPtr<CPDF_Object>* obj = m_Map.Find(key);
+  return obj ? obj->Get() : nullptr;
 }
 
 CPDF_Object* CPDF_Dictionary::GetObjectFor(const ByteString& key) {
@@ -197,7 +197,7 @@ CFX_Matrix CPDF_Dictionary::GetMatrixFor(const ByteString& key) const {
 }
 
 bool CPDF_Dictionary::KeyExist(const ByteString& key) const {
-  return pdfium::Contains(m_Map, key);
+  return m_Map.Contains(key);
 }
 
 std::vector<ByteString> CPDF_Dictionary::GetKeys() const {
@@ -212,7 +212,7 @@ CPDF_Object* CPDF_Dictionary::SetFor(const ByteString& key,
                                      RetainPtr<CPDF_Object> pObj) {
   CHECK(!IsLocked());
   if (!pObj) {
-    m_Map.erase(key);
+    m_Map.Erase(key);
     return nullptr;
   }
   DCHECK(pObj->IsInline());
@@ -225,21 +225,21 @@ void CPDF_Dictionary::ConvertToIndirectObjectFor(
     const ByteString& key,
     CPDF_IndirectObjectHolder* pHolder) {
   CHECK(!IsLocked());
-  auto it = m_Map.find(key);
-  if (it == m_Map.end() || it->second->IsReference())
+  RetainPtr<CPDF_Object>* obj = m_Map.Find(key);
+  if (!obj || (*obj)->IsReference())
     return;
 
-  CPDF_Object* pObj = pHolder->AddIndirectObject(std::move(it->second));
-  it->second = pObj->MakeReference(pHolder);
+  CPDF_Object* pObj = pHolder->AddIndirectObject(std::move(*obj));
+  *obj = pObj->MakeReference(pHolder);
 }
 
 RetainPtr<CPDF_Object> CPDF_Dictionary::RemoveFor(const ByteString& key) {
   CHECK(!IsLocked());
   RetainPtr<CPDF_Object> result;
-  auto it = m_Map.find(key);
-  if (it != m_Map.end()) {
-    result = std::move(it->second);
-    m_Map.erase(it);
+  RetainPtr<CPDF_Object>* obj = m_Map.Find(key);
+  if (obj) {
+    result = std::move(*obj);
+    m_Map.Erase(key);
   }
   return result;
 }
@@ -247,16 +247,14 @@ RetainPtr<CPDF_Object> CPDF_Dictionary::RemoveFor(const ByteString& key) {
 void CPDF_Dictionary::ReplaceKey(const ByteString& oldkey,
                                  const ByteString& newkey) {
   CHECK(!IsLocked());
-  auto old_it = m_Map.find(oldkey);
-  if (old_it == m_Map.end())
+  RetainPtr<CPDF_Object>* old_obj = m_Map.Find(oldkey);
+  if (!old_obj || oldkey == newkey)
     return;
 
-  auto new_it = m_Map.find(newkey);
-  if (new_it == old_it)
-    return;
-
-  m_Map[MaybeIntern(newkey)] = std::move(old_it->second);
-  m_Map.erase(old_it);
+  // Inserting may move entries, so take the value out first.
+  RetainPtr<CPDF_Object> obj = std::move(*old_obj);
+  m_Map.Erase(oldkey);
+  m_Map[MaybeIntern(newkey)] = std::move(obj);
 }
 
 void CPDF_Dictionary::SetRectFor(const ByteString& key,
@@ -7,7 +7,6 @@
 #ifndef CORE_FPDFAPI_PARSER_CPDF_DICTIONARY_H_
 #define CORE_FPDFAPI_PARSER_CPDF_DICTIONARY_H_
 
-#include <map>
 #include <memory>
 #include <set>
 #include <utility>
@@ -17,6 +16,7 @@
 #include "core/fxcrt/fx_coordinates.h"
 #include "core/fxcrt/fx_string.h"
 #include "core/fxcrt/retain_ptr.h"
+#include "core/fxcrt/small_flat_map.h"
 #include "core/fxcrt/string_pool_template.h"
 #include "core/fxcrt/weak_ptr.h"
 #include "third_party/base/check.h"
@@ -25,8 +25,10 @@ class CPDF_IndirectObjectHolder;
 
 class CPDF_Dictionary final : public CPDF_Object {
  public:
-  using const_iterator =
-      std::map<ByteString, RetainPtr<CPDF_Object>>::const_iterator;
+  // Small dictionaries, which are the vast majority, keep their entries in a
+  // sorted vector. Iteration is in key order either way.
+  using Map = SmallFlatMap<ByteString, RetainPtr<CPDF_Object>>;
+  using const_iterator = Map::const_iterator;
 
   CONSTRUCT_VIA_MAKE_RETAIN;
 
@@ -102,17 +104,17 @@ class CPDF_Dictionary final : public CPDF_Object {
   void SetRectFor(const ByteString& key, const CFX_FloatRect& rect);
   void SetMatrixFor(const ByteString& key, const CFX_Matrix& matrix);
 
-  // Set* functions invalidate iterators for the element with the key |key|.
+  // Set* functions invalidate all iterators.
   // Takes ownership of |pObj|, returns an unowned pointer to it.
   CPDF_Object* SetFor(const ByteString& key, RetainPtr<CPDF_Object> pObj);
 
   void ConvertToIndirectObjectFor(const ByteString& key,
                                   CPDF_IndirectObjectHolder* pHolder);
 
-  // Invalidates iterators for the element with the key |key|.
+  // Invalidates all iterators.
   RetainPtr<CPDF_Object> RemoveFor(const ByteString& key);
 
-  // Invalidates iterators for the element with the key |oldkey|.
+  // Invalidates all iterators.
   void ReplaceKey(const ByteString& oldkey, const ByteString& newkey);
 
   WeakPtr<ByteStringPool> GetByteStringPool() const { return m_pPool; }
@@ -131,7 +133,7 @@ class CPDF_Dictionary final : public CPDF_Object {
 
   mutable uint32_t m_LockCount = 0;
   WeakPtr<ByteStringPool> m_pPool;
-  std::map<ByteString, RetainPtr<CPDF_Object>> m_Map;
+  Map m_Map;
 };
 
 class CPDF_DictionaryLocker {
@@ -6,6 +6,7 @@
 
 #include "core/fpdfapi/parser/cpdf_document.h"
 
+#include "constants/page_object.h"
 #include "core/fpdfapi/parser/cpdf_array.h"
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
 #include "core/fpdfapi/parser/cpdf_linearized_header.h"
@@ -23,6 +24,10 @@ namespace {
 
 const int kMaxPageLevel = 1024;
 
+const char* const kInheritablePageAttrs[] = {
+    pdfium::page_object::kResources, pdfium::page_object::kMediaBox,
+    pdfium::page_object::kCropBox, pdfium::page_object::kRotate};
+
 int CountPages(CPDF_Dictionary* pPages,
                std::set<CPDF_Dictionary*>* visited_pages) {
   int count = pPages->GetIntegerFor("Count");
@@ -149,12 +154,24 @@ CPDF_Parser::Error CPDF_Document::LoadDoc(
   return HandleLoadResult(m_pParser->StartParse(pFileAccess, password));
 }
 
+CPDF_Parser::Error CPDF_Document::LoadDocWithCrossRefCache(
+    const RetainPtr<IFX_SeekableReadStream>& pFileAccess,
+    const char* password,
+    pdfium::span<const uint8_t> xref_cache) {
+  if (!m_pParser)
+    SetParser(std::make_unique<CPDF_Parser>(this));
+
+  return HandleLoadResult(
+      m_pParser->StartParseWithCrossRefCache(pFileAccess, password, xref_cache));
+}
+
 CPDF_Parser::Error CPDF_Document::LoadLinearizedDoc(
     const RetainPtr<CPDF_ReadValidator>& validator,
     const char* password) {
   if (!m_pParser)
     SetParser(std::make_unique<CPDF_Parser>(this));
 
+  m_bLoadedProgressively = true;
   return HandleLoadResult(m_pParser->StartLinearizedParse(validator, password));
 }
 
@@ -248,6 +265,114 @@ void CPDF_Document::ResetTraversal() {
   m_iNextPageToTraverse = 0;
   m_bReachedMaxPageLevel = false;
   m_pTreeTraversal.clear();
+  m_bHasPageIndex = false;
+  m_PageIndexMap.clear();
+  m_PageTreeNodes.clear();
+}
+
+bool CPDF_Document::CanUsePageIndex() const {
+  // Walking the whole tree could reach data that has not arrived yet.
+  return !m_bLoadedProgressively &&
+         !(m_pParser && m_pParser->GetLinearizedHeader());
+}
+
+void CPDF_Document::BuildPageIndex() {
+  ResetTraversal();
+  m_bHasPageIndex = true;
+
+  CPDF_Dictionary* pPages = GetPagesDict();
+  if (!pPages || m_PageList.empty())
+    return;
+
+  // Kids are counted the same way as in TraversePDFPages().
+  CPDF_Array* pRootKids = pPages->GetArrayFor("Kids");
+  if (!pRootKids) {
+    m_PageList[0] = pPages->GetObjNum();
+    m_PageIndexMap.emplace(m_PageList[0], 0);
+    return;
+  }
+
+  struct Frame {
+    CPDF_Dictionary* pNode;
+    CPDF_Array* pKids;
+    size_t next_kid;
+    const PageTreeNodeInfo* pInfo;
+  };
+  std::vector<Frame> stack;
+  stack.push_back({pPages, pRootKids, 0, AddPageTreeNode(pPages, nullptr)});
+  size_t page_index = 0;
+  while (!stack.empty() && page_index < m_PageList.size()) {
+    Frame& frame = stack.back();
+    if (frame.next_kid >= frame.pKids->size()) {
+      stack.pop_back();
+      continue;
+    }
+    const size_t i = frame.next_kid++;
+    frame.pKids->ConvertToIndirectObjectAt(i, this);
+    CPDF_Dictionary* pKid = frame.pKids->GetDictAt(i);
+    if (!pKid) {
+      ++page_index;
+      continue;
+    }
+    if (pKid == frame.pNode)
+      continue;
+
+    // Like TraversePDFPages(), treat a node whose Kids is not an array as a
+    // page.
+    CPDF_Array* pKidList = pKid->GetArrayFor("Kids");
+    if (!pKidList) {
+      m_PageList[page_index] = pKid->GetObjNum();
+      m_PageIndexMap.emplace(m_PageList[page_index],
+                             static_cast<int>(page_index));
+      ++page_index;
+      continue;
+    }
+    if (stack.size() >= static_cast<size_t>(kMaxPageLevel))
+      break;
+
+    const PageTreeNodeInfo* pInfo = AddPageTreeNode(pKid, frame.pInfo);
+    stack.push_back({pKid, pKidList, 0, pInfo});
+  }
+}
+
+const CPDF_Document::PageTreeNodeInfo* CPDF_Document::AddPageTreeNode(
+    CPDF_Dictionary* pNode,
+    const PageTreeNodeInfo* pParentInfo) {
+  static_assert(pdfium::size(kInheritablePageAttrs) ==
+                    kInheritablePageAttrCount,
+                "Wrong number of inheritable page attributes");
+  PageTreeNodeInfo& info = m_PageTreeNodes[pNode];
+  info.pNode.Reset(pNode);
+  for (size_t i = 0; i < kInheritablePageAttrCount; ++i) {
+    if (pNode->GetDirectObjectFor(kInheritablePageAttrs[i]))
+      info.attr_holders[i].Reset(pNode);
+    else if (pParentInfo)
+      info.attr_holders[i] = pParentInfo->attr_holders[i];
+  }
+  return &info;
+}
+
+bool CPDF_Document::GetInheritedPageAttr(const CPDF_Dictionary* pParent,
+                                         const ByteString& name,
+                                         CPDF_Object** pResult) const {
+  auto it = m_PageTreeNodes.find(pParent);
+  if (it == m_PageTreeNodes.end())
+    return false;
+
+  for (size_t i = 0; i < kInheritablePageAttrCount; ++i) {
+    if (name != kInheritablePageAttrs[i])
+      continue;
+
+    // The holder may have lost the attribute since the index was built, and
+    // pages with no holder at the time are left to the caller's own walk.
+    CPDF_Dictionary* pHolder = it->second.attr_holders[i].Get();
+    if (!pHolder)
+      return false;
+
+    *pResult = pHolder->GetDirectObjectFor(name);
+    return !!*pResult;
+  }
+  return false;
 }
 
 void CPDF_Document::SetParser(std::unique_ptr<CPDF_Parser> pParser) {
@@ -286,6 +411,23 @@ CPDF_Dictionary* CPDF_Document::GetPageDictionary(int iPage) {
       return result;
   }
 
+  if (m_bHasPageIndex)
+    return nullptr;
+
+  // Walking forward from where the last lookup stopped only visits nodes
+  // that have not been loaded yet. Build the index instead when the walk
+  // would have to start over from the root.
+  const bool walk_restarts =
+      iPage < m_iNextPageToTraverse ||
+      (m_pTreeTraversal.empty() && m_iNextPageToTraverse > 0);
+  if (walk_restarts && CanUsePageIndex()) {
+    BuildPageIndex();
+    const uint32_t indexed_objnum = m_PageList[iPage];
+    return indexed_objnum
+               ? ToDictionary(GetOrParseIndirectObject(indexed_objnum))
+               : nullptr;
+  }
+
   CPDF_Dictionary* pPages = GetPagesDict();
   if (!pPages)
     return nullptr;
@@ -311,6 +453,18 @@ JBig2_DocumentContext* CPDF_Document::GetOrCreateCodecContext() {
 }
 
 int CPDF_Document::GetPageIndex(uint32_t objnum) {
+  if (CanUsePageIndex()) {
+    if (!m_bHasPageIndex)
+      BuildPageIndex();
+
+    auto it = m_PageIndexMap.find(objnum);
+    if (it != m_PageIndexMap.end() &&
+        pdfium::IndexInBounds(m_PageList, it->second) &&
+        m_PageList[it->second] == objnum) {
+      return it->second;
+    }
+  }
+
   uint32_t skip_count = 0;
   bool bSkipped = false;
   for (uint32_t i = 0; i < m_PageList.size(); ++i) {
@@ -408,11 +562,14 @@ bool CPDF_Document::InsertDeletePDFPage(CPDF_Dictionary* pPages,
         pKidList->InsertNewAt<CPDF_Reference>(i, this, pPageDict->GetObjNum());
         pPageDict->SetNewFor<CPDF_Reference>("Parent", this,
                                              pPages->GetObjNum());
+        MarkIndirectObjectDirty(pPageDict->GetObjNum());
       } else {
         pKidList->RemoveAt(i);
       }
+      MarkIndirectObjectDirty(pKidList->GetObjNum());
       pPages->SetNewFor<CPDF_Number>(
           "Count", pPages->GetIntegerFor("Count") + (bInsert ? 1 : -1));
+      MarkIndirectObjectDirty(pPages->GetObjNum());
       ResetTraversal();
       break;
     }
@@ -430,6 +587,7 @@ bool CPDF_Document::InsertDeletePDFPage(CPDF_Dictionary* pPages,
 
     pPages->SetNewFor<CPDF_Number>(
         "Count", pPages->GetIntegerFor("Count") + (bInsert ? 1 : -1));
+    MarkIndirectObjectDirty(pPages->GetObjNum());
     break;
   }
   return true;
@@ -452,6 +610,9 @@ bool CPDF_Document::InsertNewPage(int iPage, CPDF_Dictionary* pPageDict) {
     pPagesList->AppendNew<CPDF_Reference>(this, pPageDict->GetObjNum());
     pPages->SetNewFor<CPDF_Number>("Count", nPages + 1);
     pPageDict->SetNewFor<CPDF_Reference>("Parent", this, pPages->GetObjNum());
+    MarkIndirectObjectDirty(pPagesList->GetObjNum());
+    MarkIndirectObjectDirty(pPages->GetObjNum());
+    MarkIndirectObjectDirty(pPageDict->GetObjNum());
     ResetTraversal();
   } else {
     std::set<CPDF_Dictionary*> stack = {pPages};
@@ -459,6 +620,7 @@ bool CPDF_Document::InsertNewPage(int iPage, CPDF_Dictionary* pPageDict) {
       return false;
   }
   m_PageList.insert(m_PageList.begin() + iPage, pPageDict->GetObjNum());
+  ResetTraversal();
   return true;
 }
 
@@ -493,6 +655,7 @@ void CPDF_Document::DeletePage(int iPage) {
     return;
 
   m_PageList.erase(m_PageList.begin() + iPage);
+  ResetTraversal();
 }
 
 void CPDF_Document::SetRootForTesting(CPDF_Dictionary* root) {
@@ -503,6 +666,10 @@ void CPDF_Document::ResizePageListForTesting(size_t size) {
   m_PageList.resize(size);
 }
 
+CPDF_Document::PageTreeNodeInfo::PageTreeNodeInfo() = default;
+
+CPDF_Document::PageTreeNodeInfo::~PageTreeNodeInfo() = default;
+
 CPDF_Document::StockFontClearer::StockFontClearer(
     CPDF_Document::PageDataIface* pPageData)
     : m_pPageData(pPageData) {}
@@ -7,6 +7,8 @@
 #ifndef CORE_FPDFAPI_PARSER_CPDF_DOCUMENT_H_
 #define CORE_FPDFAPI_PARSER_CPDF_DOCUMENT_H_
 
+#include <array>
+#include <map>
 #include <memory>
 #include <set>
 #include <utility>
@@ -17,6 +19,7 @@
 #include "core/fxcrt/retain_ptr.h"
 #include "core/fxcrt/unowned_ptr.h"
 
+class CPDF_Dictionary;
 class CPDF_ReadValidator;
 class CPDF_StreamAcc;
 class IFX_SeekableReadStream;
@@ -118,6 +121,10 @@ class CPDF_Document : public Observable,
   CPDF_Parser::Error LoadDoc(
       const RetainPtr<IFX_SeekableReadStream>& pFileAccess,
       const char* password);
+  CPDF_Parser::Error LoadDocWithCrossRefCache(
+      const RetainPtr<IFX_SeekableReadStream>& pFileAccess,
+      const char* password,
+      pdfium::span<const uint8_t> xref_cache);
   CPDF_Parser::Error LoadLinearizedDoc(
       const RetainPtr<CPDF_ReadValidator>& validator,
       const char* password);
@@ -126,6 +133,22 @@ class CPDF_Document : public Observable,
   }
 
   void LoadPages();
+
+  // Walks the whole page tree once, recording the object number of every page
+  // and which nodes supply the inheritable attributes of pages under each
+  // /Pages node. GetPageIndex() does this on first use, and
+  // GetPageDictionary() once a lookup would have to walk the tree from the
+  // root again, except for documents that are loaded progressively. The index
+  // is dropped whenever pages are inserted or deleted.
+  void BuildPageIndex();
+
+  // Looks up the inheritable page attribute |name| of a page whose /Parent is
+  // |pParent| in the page index. Returns false if the index cannot tell, in
+  // which case the caller has to walk the /Parent chain itself.
+  bool GetInheritedPageAttr(const CPDF_Dictionary* pParent,
+                            const ByteString& name,
+                            CPDF_Object** pResult) const;
+
   void CreateNewDoc();
   CPDF_Dictionary* CreateNewPage(int iPage);
 
@@ -139,6 +162,20 @@ class CPDF_Document : public Observable,
   void ResizePageListForTesting(size_t size);
 
  private:
+  static constexpr size_t kInheritablePageAttrCount = 4;
+
+  // A /Pages node, and for each inheritable page attribute, the nearest
+  // dictionary on the path from the root to it, inclusive, that defines the
+  // attribute.
+  struct PageTreeNodeInfo {
+    PageTreeNodeInfo();
+    ~PageTreeNodeInfo();
+
+    RetainPtr<const CPDF_Dictionary> pNode;
+    std::array<RetainPtr<CPDF_Dictionary>, kInheritablePageAttrCount>
+        attr_holders;
+  };
+
   class StockFontClearer {
    public:
     explicit StockFontClearer(CPDF_Document::PageDataIface* pPageData);
@@ -163,6 +200,9 @@ class CPDF_Document : public Observable,
                            std::set<CPDF_Dictionary*>* pVisited);
   bool InsertNewPage(int iPage, CPDF_Dictionary* pPageDict);
   void ResetTraversal();
+  bool CanUsePageIndex() const;
+  const PageTreeNodeInfo* AddPageTreeNode(CPDF_Dictionary* pNode,
+                                          const PageTreeNodeInfo* pParentInfo);
   CPDF_Parser::Error HandleLoadResult(CPDF_Parser::Error error);
 
   std::unique_ptr<CPDF_Parser> m_pParser;
@@ -190,6 +230,12 @@ class CPDF_Document : public Observable,
   std::unique_ptr<LinkListIface> m_pLinksContext;
   std::vector<uint32_t> m_PageList;  // Page number to page's dict objnum.
 
+  // Set by BuildPageIndex(), until the page tree changes.
+  bool m_bHasPageIndex = false;
+  bool m_bLoadedProgressively = false;
+  std::map<uint32_t, int> m_PageIndexMap;  // Page's dict objnum to number.
+  std::map<const CPDF_Dictionary*, PageTreeNodeInfo> m_PageTreeNodes;
+
   // Must be second to last.
   StockFontClearer m_StockFontClearer;
 
@@ -6,6 +6,7 @@
 
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "core/fpdfapi/page/cpdf_docpagedata.h"
 #include "core/fpdfapi/page/cpdf_pagemodule.h"
@@ -224,6 +225,119 @@ TEST_F(cpdf_document_test, GetPagesInDisorder) {
   EXPECT_EQ(6, page->GetIntegerFor("PageNumbering"));
 }
 
+TEST_F(cpdf_document_test, GetPageIndex) {
+  std::vector<uint32_t> objnums;
+  {
+    CPDF_TestDocumentForPages document;
+    for (int i = 0; i < kNumTestPages; i++) {
+      CPDF_Dictionary* page = document.GetPageDictionary(i);
+      ASSERT_TRUE(page);
+      objnums.push_back(page->GetObjNum());
+    }
+  }
+
+  CPDF_TestDocumentForPages document;
+  for (int i = kNumTestPages - 1; i >= 0; i--)
+    EXPECT_EQ(i, document.GetPageIndex(objnums[i]));
+
+  CPDF_Dictionary* not_a_page = document.NewIndirect<CPDF_Dictionary>();
+  EXPECT_EQ(-1, document.GetPageIndex(not_a_page->GetObjNum()));
+}
+
+TEST_F(cpdf_document_test, GetPageIndexAfterInsertingPage) {
+  CPDF_TestDocumentForPages document;
+  CPDF_Dictionary* first_page = document.GetPageDictionary(0);
+  ASSERT_TRUE(first_page);
+  const uint32_t first_page_objnum = first_page->GetObjNum();
+  EXPECT_EQ(0, document.GetPageIndex(first_page_objnum));
+
+  CPDF_Dictionary* new_page = document.CreateNewPage(0);
+  ASSERT_TRUE(new_page);
+  EXPECT_EQ(kNumTestPages + 1, document.GetPageCount());
+  EXPECT_EQ(0, document.GetPageIndex(new_page->GetObjNum()));
+  EXPECT_EQ(1, document.GetPageIndex(first_page_objnum));
+  EXPECT_EQ(first_page, document.GetPageDictionary(1));
+}
+
+TEST_F(cpdf_document_test, GetInheritedPageAttr) {
+  CPDF_TestDocumentForPages document;
+  CPDF_Dictionary* page = document.GetPageDictionary(0);
+  ASSERT_TRUE(page);
+  CPDF_Dictionary* parent = page->GetDictFor("Parent");
+  ASSERT_TRUE(parent);
+  CPDF_Dictionary* pages = document.GetRoot()->GetDictFor("Pages");
+  ASSERT_TRUE(pages);
+
+  pages->SetNewFor<CPDF_Number>("Rotate", 90);
+  CPDF_Dictionary* resources = parent->SetNewFor<CPDF_Dictionary>("Resources");
+  document.BuildPageIndex();
+
+  CPDF_Object* attr = nullptr;
+  ASSERT_TRUE(document.GetInheritedPageAttr(parent, "Rotate", &attr));
+  ASSERT_TRUE(attr);
+  EXPECT_EQ(90, attr->GetInteger());
+  ASSERT_TRUE(document.GetInheritedPageAttr(parent, "Resources", &attr));
+  EXPECT_EQ(resources, attr);
+
+  // Without a holder, the caller has to walk the parents itself, as the
+  // attribute may have been added since the index was built.
+  EXPECT_FALSE(document.GetInheritedPageAttr(pages, "Resources", &attr));
+  EXPECT_FALSE(document.GetInheritedPageAttr(parent, "MediaBox", &attr));
+
+  // Not inheritable.
+  EXPECT_FALSE(document.GetInheritedPageAttr(parent, "Contents", &attr));
+  // Not a /Pages node.
+  EXPECT_FALSE(document.GetInheritedPageAttr(page, "Rotate", &attr));
+
+  // Attributes removed after the index was built are not reported.
+  parent->RemoveFor("Resources");
+  EXPECT_FALSE(document.GetInheritedPageAttr(parent, "Resources", &attr));
+}
+
+TEST_F(cpdf_document_test, BuildPageIndexWithNonArrayKids) {
+  CPDF_TestDocumentForPages document;
+  CPDF_Dictionary* page3 = document.GetPageDictionary(3);
+  CPDF_Dictionary* page6 = document.GetPageDictionary(6);
+  ASSERT_TRUE(page3);
+  ASSERT_TRUE(page6);
+
+  // Pages 4 and 5 share a parent. With Kids that is not an array, that
+  // parent takes their place as a single page.
+  CPDF_Dictionary* parent = document.GetPageDictionary(4)->GetDictFor("Parent");
+  ASSERT_TRUE(parent);
+  parent->SetNewFor<CPDF_Number>("Kids", 1);
+  document.SetTreeSize(kNumTestPages - 1);
+  document.BuildPageIndex();
+
+  EXPECT_EQ(3, document.GetPageIndex(page3->GetObjNum()));
+  EXPECT_EQ(4, document.GetPageIndex(parent->GetObjNum()));
+  EXPECT_EQ(5, document.GetPageIndex(page6->GetObjNum()));
+}
+
+TEST_F(cpdf_document_test, SequentialPageLookupsDoNotBuildIndex) {
+  CPDF_TestDocumentForPages document;
+  CPDF_Dictionary* pages = document.GetRoot()->GetDictFor("Pages");
+  ASSERT_TRUE(pages);
+  pages->SetNewFor<CPDF_Number>("Rotate", 90);
+
+  CPDF_Object* attr = nullptr;
+  for (int i = 0; i < kNumTestPages; i++) {
+    CPDF_Dictionary* page = document.GetPageDictionary(i);
+    ASSERT_TRUE(page);
+    EXPECT_EQ(i, page->GetIntegerFor("PageNumbering"));
+    EXPECT_FALSE(document.GetInheritedPageAttr(pages, "Rotate", &attr));
+  }
+
+  // Going back to a page that is not loaded yet would restart the walk.
+  document.SetPageObjNum(1, 0);
+  CPDF_Dictionary* page = document.GetPageDictionary(1);
+  ASSERT_TRUE(page);
+  EXPECT_EQ(1, page->GetIntegerFor("PageNumbering"));
+  ASSERT_TRUE(document.GetInheritedPageAttr(pages, "Rotate", &attr));
+  ASSERT_TRUE(attr);
+  EXPECT_EQ(90, attr->GetInteger());
+}
+
 TEST_F(cpdf_document_test, IsValidPageObject) {
   CPDF_TestDocumentForPages document;
 
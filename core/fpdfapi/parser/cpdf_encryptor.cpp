@@ -9,8 +9,10 @@
 #include "core/fpdfapi/parser/cpdf_crypto_handler.h"
 #include "third_party/base/check.h"
 
-CPDF_Encryptor::CPDF_Encryptor(const CPDF_CryptoHandler* pHandler, int objnum)
-    : m_pHandler(pHandler), m_ObjNum(objnum) {
+CPDF_Encryptor::CPDF_Encryptor(const CPDF_CryptoHandler* pHandler,
+                               uint32_t objnum,
+                               uint32_t gennum)
+    : m_pHandler(pHandler), m_ObjNum(objnum), m_GenNum(gennum) {
   DCHECK(m_pHandler);
 }
 
@@ -22,7 +24,7 @@ std::vector<uint8_t, FxAllocAllocator<uint8_t>> CPDF_Encryptor::Encrypt(
   std::vector<uint8_t, FxAllocAllocator<uint8_t>> result;
   uint32_t buf_size = m_pHandler->EncryptGetSize(src_data);
   result.resize(buf_size);
-  m_pHandler->EncryptContent(m_ObjNum, 0, src_data, result.data(),
+  m_pHandler->EncryptContent(m_ObjNum, m_GenNum, src_data, result.data(),
                              buf_size);  // Updates |buf_size| with actual.
   result.resize(buf_size);
   return result;
@@ -19,7 +19,9 @@ class CPDF_CryptoHandler;
 
 class CPDF_Encryptor {
  public:
-  CPDF_Encryptor(const CPDF_CryptoHandler* pHandler, int objnum);
+  CPDF_Encryptor(const CPDF_CryptoHandler* pHandler,
+                 uint32_t objnum,
+                 uint32_t gennum);
   ~CPDF_Encryptor();
 
   std::vector<uint8_t, FxAllocAllocator<uint8_t>> Encrypt(
@@ -27,7 +29,8 @@ class CPDF_Encryptor {
 
  private:
   UnownedPtr<const CPDF_CryptoHandler> const m_pHandler;
-  const int m_ObjNum;
+  const uint32_t m_ObjNum;
+  const uint32_t m_GenNum;
 };
 
 #endif  // CORE_FPDFAPI_PARSER_CPDF_ENCRYPTOR_H_
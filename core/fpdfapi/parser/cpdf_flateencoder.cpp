@@ -45,7 +45,9 @@ CPDF_FlateEncoder::CPDF_FlateEncoder(const CPDF_Stream* pStream,
 
   // TODO(thestig): Move to Init() and check return value.
   std::unique_ptr<uint8_t, FxFreeDeleter> buffer;
-  ::FlateEncode(m_pAcc->GetSpan(), &buffer, &m_dwSize);
+  uint32_t encoded_size = 0;
+  ::FlateEncode(m_pAcc->GetSpan(), &buffer, &encoded_size);
+  m_dwSize = encoded_size;
 
   m_pData = std::move(buffer);
   m_pClonedDict = ToDictionary(pStream->GetDict()->Clone());
@@ -406,34 +406,60 @@ CPDF_DataAvail::DocAvailStatus CPDF_HintTables::CheckPage(uint32_t index) {
   if (index == m_pLinearized->GetFirstPageNo())
     return CPDF_DataAvail::DataAvailable;
 
-  if (index >= m_pLinearized->GetPageCount())
+  const uint32_t page_count = m_pLinearized->GetPageCount();
+  if (index >= page_count)
     return CPDF_DataAvail::DataError;
 
-  const uint32_t dwLength = m_PageInfos[index].page_length();
-  if (!dwLength)
+  // Download data of the page and of the shared objects in the page.
+  std::vector<CPDF_ReadValidator::Range> ranges;
+  if (!GetPageRanges(index, &ranges))
     return CPDF_DataAvail::DataError;
 
-  if (!m_pValidator->CheckDataRangeAndRequestIfUnavailable(
-          m_PageInfos[index].page_offset(), dwLength)) {
-    return CPDF_DataAvail::DataNotAvailable;
+  if (m_PrefetchPageCount == 0) {
+    for (const CPDF_ReadValidator::Range& range : ranges) {
+      if (!m_pValidator->CheckDataRangeAndRequestIfUnavailable(range.first,
+                                                               range.second)) {
+        return CPDF_DataAvail::DataNotAvailable;
+      }
+    }
+    return CPDF_DataAvail::DataAvailable;
+  }
+
+  std::vector<CPDF_ReadValidator::Range> prefetch_ranges;
+  for (uint32_t page = index + 1;
+       page < page_count && page - index <= m_PrefetchPageCount; ++page) {
+    if (page != m_pLinearized->GetFirstPageNo())
+      GetPageRanges(page, &prefetch_ranges);
   }
+  return m_pValidator->CheckDataRangesAndRequestIfUnavailable(ranges,
+                                                              prefetch_ranges)
+             ? CPDF_DataAvail::DataAvailable
+             : CPDF_DataAvail::DataNotAvailable;
+}
 
-  // Download data of shared objects in the page.
-  for (const uint32_t dwIndex : m_PageInfos[index].Identifiers()) {
+bool CPDF_HintTables::GetPageRanges(
+    uint32_t index,
+    std::vector<CPDF_ReadValidator::Range>* ranges) const {
+  const PageInfo& page_info = m_PageInfos[index];
+  if (!page_info.page_length())
+    return false;
+
+  std::vector<CPDF_ReadValidator::Range> page_ranges;
+  page_ranges.emplace_back(page_info.page_offset(), page_info.page_length());
+  for (const uint32_t dwIndex : page_info.Identifiers()) {
     if (dwIndex >= m_SharedObjGroupInfos.size())
       continue;
     const SharedObjGroupInfo& shared_group_info =
         m_SharedObjGroupInfos[dwIndex];
 
     if (!shared_group_info.m_szOffset || !shared_group_info.m_dwLength)
-      return CPDF_DataAvail::DataError;
+      return false;
 
-    if (!m_pValidator->CheckDataRangeAndRequestIfUnavailable(
-            shared_group_info.m_szOffset, shared_group_info.m_dwLength)) {
-      return CPDF_DataAvail::DataNotAvailable;
-    }
+    page_ranges.emplace_back(shared_group_info.m_szOffset,
+                             shared_group_info.m_dwLength);
   }
-  return CPDF_DataAvail::DataAvailable;
+  ranges->insert(ranges->end(), page_ranges.begin(), page_ranges.end());
+  return true;
 }
 
 bool CPDF_HintTables::LoadHintStream(CPDF_Stream* pHintStream) {
@@ -452,7 +478,7 @@ bool CPDF_HintTables::LoadHintStream(CPDF_Stream* pHintStream) {
   auto pAcc = pdfium::MakeRetain<CPDF_StreamAcc>(pHintStream);
   pAcc->LoadAllDataFiltered();
 
-  uint32_t size = pAcc->GetSize();
+  const size_t size = pAcc->GetSize();
   // The header section of page offset hint table is 36 bytes.
   // The header section of shared object hint table is 24 bytes.
   // Hint table has at least 60 bytes.
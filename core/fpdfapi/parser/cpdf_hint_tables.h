@@ -11,11 +11,11 @@
 #include <vector>
 
 #include "core/fpdfapi/parser/cpdf_data_avail.h"
+#include "core/fpdfapi/parser/cpdf_read_validator.h"
 #include "core/fxcrt/unowned_ptr.h"
 
 class CFX_BitStream;
 class CPDF_LinearizedHeader;
-class CPDF_ReadValidator;
 class CPDF_Stream;
 class CPDF_SyntaxParser;
 
@@ -83,6 +83,10 @@ class CPDF_HintTables {
 
   CPDF_DataAvail::DocAvailStatus CheckPage(uint32_t index);
 
+  // Sets how many of the pages after the one passed to CheckPage() to request
+  // along with it, when that page is not available yet.
+  void SetPrefetchPageCount(uint32_t count) { m_PrefetchPageCount = count; }
+
   bool LoadHintStream(CPDF_Stream* pHintStream);
 
   const std::vector<PageInfo>& PageInfos() const { return m_PageInfos; }
@@ -99,6 +103,12 @@ class CPDF_HintTables {
  private:
   FX_FILESIZE HintsOffsetToFileOffset(uint32_t hints_offset) const;
 
+  // Appends the byte ranges of page |index| and of the shared object groups it
+  // uses to |ranges|. Returns false and leaves |ranges| alone if the hint
+  // tables have no valid ranges for them.
+  bool GetPageRanges(uint32_t index,
+                     std::vector<CPDF_ReadValidator::Range>* ranges) const;
+
   // Owned by |m_pDataAvail|.
   UnownedPtr<CPDF_ReadValidator> m_pValidator;
 
@@ -106,6 +116,7 @@ class CPDF_HintTables {
   UnownedPtr<const CPDF_LinearizedHeader> const m_pLinearized;
 
   uint32_t m_nFirstPageSharedObjs = 0;
+  uint32_t m_PrefetchPageCount = 0;
   FX_FILESIZE m_szFirstPageObjOffset = 0;
   std::vector<PageInfo> m_PageInfos;
   std::vector<SharedObjGroupInfo> m_SharedObjGroupInfos;
@@ -7,6 +7,7 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "core/fpdfapi/page/cpdf_pagemodule.h"
 #include "core/fpdfapi/parser/cpdf_data_avail.h"
@@ -17,6 +18,7 @@
 #include "core/fpdfapi/parser/cpdf_stream.h"
 #include "core/fpdfapi/parser/cpdf_syntax_parser.h"
 #include "core/fxcrt/cfx_readonlymemorystream.h"
+#include "core/fxcrt/fx_memory_wrappers.h"
 #include "core/fxcrt/fx_stream.h"
 #include "testing/gmock/include/gmock/gmock.h"
 #include "testing/gtest/include/gtest/gtest.h"
@@ -57,6 +59,91 @@ class TestLinearizedHeader final : public CPDF_LinearizedHeader {
   }
 };
 
+// Serves a file over simulated range requests, counting the requests made and
+// the bytes they transfer.
+class FakeRangeServer final : public CPDF_DataAvail::FileAvail,
+                              public CPDF_DataAvail::DownloadHints {
+ public:
+  explicit FakeRangeServer(size_t file_size) : available_(file_size) {}
+  ~FakeRangeServer() override = default;
+
+  // CPDF_DataAvail::FileAvail:
+  bool IsDataAvail(FX_FILESIZE offset, size_t size) override {
+    for (size_t i = 0; i < size; ++i) {
+      if (!available_[offset + i])
+        return false;
+    }
+    return true;
+  }
+
+  // CPDF_DataAvail::DownloadHints:
+  void AddSegment(FX_FILESIZE offset, size_t size) override {
+    pending_requests_.emplace_back(offset, size);
+  }
+
+  // Serves the requests made since the last call, one at a time. Returns
+  // false if there were none.
+  bool ServeRequests() {
+    if (pending_requests_.empty())
+      return false;
+
+    for (const auto& request : pending_requests_) {
+      ++request_count_;
+      bytes_transferred_ += request.second;
+      for (size_t i = 0; i < request.second; ++i)
+        available_[request.first + i] = true;
+    }
+    pending_requests_.clear();
+    return true;
+  }
+
+  size_t request_count() const { return request_count_; }
+  size_t bytes_transferred() const { return bytes_transferred_; }
+
+ private:
+  std::vector<bool> available_;
+  std::vector<std::pair<FX_FILESIZE, size_t>> pending_requests_;
+  size_t request_count_ = 0;
+  size_t bytes_transferred_ = 0;
+};
+
+// Checks all pages but the first of the 102 page document that
+// hint_table_102p.bin comes from, in order, serving the requested data each
+// time a page is not available yet.
+void CheckAllPagesWithPrefetch(uint32_t prefetch_page_count,
+                               FakeRangeServer* server) {
+  const auto linearized_header = TestLinearizedHeader::MakeHeader(
+      "<< /Linearized 1 /L 19326762 /H [ 123730 3816 ] /O 5932 /E 639518 /N "
+      "102 /T 19220281 >>");
+  ASSERT_TRUE(linearized_header);
+
+  RetainPtr<CPDF_ReadValidator> hint_table_validator =
+      MakeValidatorFromFile("hint_table_102p.bin");
+  CPDF_SyntaxParser parser(hint_table_validator, 0);
+  RetainPtr<CPDF_Stream> stream = ToStream(parser.GetObjectBody(nullptr));
+  ASSERT_TRUE(stream);
+
+  std::vector<uint8_t, FxAllocAllocator<uint8_t>> file_data(
+      linearized_header->GetFileSize());
+  auto validator = pdfium::MakeRetain<CPDF_ReadValidator>(
+      pdfium::MakeRetain<CFX_ReadOnlyMemoryStream>(file_data), server);
+  validator->SetDownloadHints(server);
+
+  CPDF_HintTables hint_tables(validator.Get(), linearized_header.get());
+  ASSERT_TRUE(hint_tables.LoadHintStream(stream.Get()));
+  hint_tables.SetPrefetchPageCount(prefetch_page_count);
+
+  for (uint32_t page = 1; page < linearized_header->GetPageCount(); ++page) {
+    CPDF_DataAvail::DocAvailStatus status;
+    while ((status = hint_tables.CheckPage(page)) ==
+           CPDF_DataAvail::DataNotAvailable) {
+      ASSERT_TRUE(server->ServeRequests());
+    }
+    ASSERT_EQ(CPDF_DataAvail::DataAvailable, status);
+  }
+  validator->SetDownloadHints(nullptr);
+}
+
 }  // namespace
 
 class CPDF_HintTablesTest : public testing::Test {
@@ -180,3 +267,17 @@ TEST_F(CPDF_HintTablesTest, FirstPageOffset) {
   // 127546 is predefined real value from original file.
   EXPECT_EQ(127546, hint_tables->GetFirstPageObjOffset());
 }
+
+TEST_F(CPDF_HintTablesTest, PrefetchFollowingPages) {
+  FakeRangeServer server(19326762);
+  CheckAllPagesWithPrefetch(0, &server);
+  ASSERT_FALSE(HasFatalFailure());
+  const size_t request_count = server.request_count();
+  const size_t bytes_transferred = server.bytes_transferred();
+
+  FakeRangeServer prefetch_server(19326762);
+  CheckAllPagesWithPrefetch(4, &prefetch_server);
+  ASSERT_FALSE(HasFatalFailure());
+  EXPECT_LT(prefetch_server.request_count(), request_count / 2);
+  EXPECT_LT(prefetch_server.bytes_transferred(), bytes_transferred);
+}
@@ -10,6 +10,7 @@
 #include <utility>
 
 #include "core/fpdfapi/parser/cpdf_object.h"
+#include "core/fpdfapi/parser/cpdf_object_arena.h"
 #include "core/fpdfapi/parser/cpdf_parser.h"
 #include "third_party/base/check.h"
 
@@ -28,11 +29,15 @@ CPDF_IndirectObjectHolder::~CPDF_IndirectObjectHolder() {
   m_pByteStringPool.DeleteObject();  // Make weak.
 }
 
+void CPDF_IndirectObjectHolder::EnableObjectArena() {
+  if (!m_pObjectArena)
+    m_pObjectArena = std::make_unique<CPDF_ObjectArena>();
+}
+
 CPDF_Object* CPDF_IndirectObjectHolder::GetIndirectObject(
     uint32_t objnum) const {
-  auto it = m_IndirectObjs.find(objnum);
-  return (it != m_IndirectObjs.end()) ? FilterInvalidObjNum(it->second.Get())
-                                      : nullptr;
+  const RetainPtr<CPDF_Object>* obj = m_IndirectObjs.Find(objnum);
+  return obj ? FilterInvalidObjNum(obj->Get()) : nullptr;
 }
 
 CPDF_Object* CPDF_IndirectObjectHolder::GetOrParseIndirectObject(
@@ -40,21 +45,29 @@ CPDF_Object* CPDF_IndirectObjectHolder::GetOrParseIndirectObject(
   if (objnum == 0 || objnum == CPDF_Object::kInvalidObjNum)
     return nullptr;
 
+  const RetainPtr<CPDF_Object>* existing = m_IndirectObjs.Find(objnum);
+  if (existing)
+    return FilterInvalidObjNum(existing->Get());
+
   // Add item anyway to prevent recursively parsing of same object.
-  auto insert_result = m_IndirectObjs.insert(std::make_pair(objnum, nullptr));
-  if (!insert_result.second)
-    return FilterInvalidObjNum(insert_result.first->second.Get());
+  m_IndirectObjs[objnum];
 
-  RetainPtr<CPDF_Object> pNewObj = ParseIndirectObject(objnum);
+  // Parsing may add further objects, so look the slot up again afterwards.
+  RetainPtr<CPDF_Object> pNewObj;
+  {
+    CPDF_ObjectArena::ScopedUse arena_scope(m_pObjectArena.get());
+    pNewObj = ParseIndirectObject(objnum);
+  }
   if (!pNewObj) {
-    m_IndirectObjs.erase(insert_result.first);
+    m_IndirectObjs.Erase(objnum);
     return nullptr;
   }
 
   pNewObj->SetObjNum(objnum);
   m_LastObjNum = std::max(m_LastObjNum, objnum);
-  insert_result.first->second = std::move(pNewObj);
-  return insert_result.first->second.Get();
+  RetainPtr<CPDF_Object>& obj_holder = m_IndirectObjs[objnum];
+  obj_holder = std::move(pNewObj);
+  return obj_holder.Get();
 }
 
 RetainPtr<CPDF_Object> CPDF_IndirectObjectHolder::ParseIndirectObject(
@@ -66,6 +79,7 @@ CPDF_Object* CPDF_IndirectObjectHolder::AddIndirectObject(
     RetainPtr<CPDF_Object> pObj) {
   CHECK(!pObj->GetObjNum());
   pObj->SetObjNum(++m_LastObjNum);
+  m_DirtyObjNums.insert(m_LastObjNum);
 
   auto& obj_holder = m_IndirectObjs[m_LastObjNum];
   obj_holder = std::move(pObj);
@@ -91,9 +105,15 @@ bool CPDF_IndirectObjectHolder::ReplaceIndirectObjectIfHigherGeneration(
 }
 
 void CPDF_IndirectObjectHolder::DeleteIndirectObject(uint32_t objnum) {
-  auto it = m_IndirectObjs.find(objnum);
-  if (it == m_IndirectObjs.end() || !FilterInvalidObjNum(it->second.Get()))
+  const RetainPtr<CPDF_Object>* obj = m_IndirectObjs.Find(objnum);
+  if (!obj || !FilterInvalidObjNum(obj->Get()))
     return;
 
-  m_IndirectObjs.erase(it);
+  m_IndirectObjs.Erase(objnum);
+  m_DirtyObjNums.erase(objnum);
+}
+
+void CPDF_IndirectObjectHolder::MarkIndirectObjectDirty(uint32_t objnum) {
+  if (objnum != 0 && objnum != CPDF_Object::kInvalidObjNum)
+    m_DirtyObjNums.insert(objnum);
 }
@@ -7,21 +7,23 @@
 #ifndef CORE_FPDFAPI_PARSER_CPDF_INDIRECT_OBJECT_HOLDER_H_
 #define CORE_FPDFAPI_PARSER_CPDF_INDIRECT_OBJECT_HOLDER_H_
 
-#include <map>
 #include <memory>
+#include <set>
 #include <type_traits>
 #include <utility>
 
 #include "core/fpdfapi/parser/cpdf_object.h"
+#include "core/fxcrt/flat_index_map.h"
 #include "core/fxcrt/fx_system.h"
 #include "core/fxcrt/retain_ptr.h"
 #include "core/fxcrt/string_pool_template.h"
 #include "core/fxcrt/weak_ptr.h"
 
+class CPDF_ObjectArena;
+
 class CPDF_IndirectObjectHolder {
  public:
-  using const_iterator =
-      std::map<uint32_t, RetainPtr<CPDF_Object>>::const_iterator;
+  using const_iterator = FlatIndexMap<RetainPtr<CPDF_Object>>::const_iterator;
 
   CPDF_IndirectObjectHolder();
   virtual ~CPDF_IndirectObjectHolder();
@@ -62,6 +64,13 @@ class CPDF_IndirectObjectHolder {
   bool ReplaceIndirectObjectIfHigherGeneration(uint32_t objnum,
                                                RetainPtr<CPDF_Object> pObj);
 
+  // Records that indirect object |objnum| changed since it was loaded, so
+  // that incremental saves write it. Objects added with AddIndirectObject()
+  // are recorded automatically. Does nothing for direct objects, whose
+  // |objnum| is 0.
+  void MarkIndirectObjectDirty(uint32_t objnum);
+  const std::set<uint32_t>& GetDirtyObjNums() const { return m_DirtyObjNums; }
+
   uint32_t GetLastObjNum() const { return m_LastObjNum; }
   void SetLastObjNum(uint32_t objnum) { m_LastObjNum = objnum; }
 
@@ -69,6 +78,12 @@ class CPDF_IndirectObjectHolder {
     return m_pByteStringPool;
   }
 
+  // Allocates objects parsed from now on out of a CPDF_ObjectArena, which is
+  // released in bulk together with the holder. Best for documents that are
+  // only read. Objects created by other means still use the heap.
+  void EnableObjectArena();
+  CPDF_ObjectArena* GetObjectArena() const { return m_pObjectArena.get(); }
+
   const_iterator begin() const { return m_IndirectObjs.begin(); }
   const_iterator end() const { return m_IndirectObjs.end(); }
 
@@ -77,7 +92,10 @@ class CPDF_IndirectObjectHolder {
 
  private:
   uint32_t m_LastObjNum = 0;
-  std::map<uint32_t, RetainPtr<CPDF_Object>> m_IndirectObjs;
+  // Declared before |m_IndirectObjs| so that it outlives the objects.
+  std::unique_ptr<CPDF_ObjectArena> m_pObjectArena;
+  FlatIndexMap<RetainPtr<CPDF_Object>> m_IndirectObjs;
+  std::set<uint32_t> m_DirtyObjNums;
   WeakPtr<ByteStringPool> m_pByteStringPool;
 };
 
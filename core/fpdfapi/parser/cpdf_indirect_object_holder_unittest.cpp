@@ -75,3 +75,34 @@ TEST(CPDF_IndirectObjectHolderTest, ReplaceObjectWithInvalidObjNum) {
   EXPECT_FALSE(mock_holder.ReplaceIndirectObjectIfHigherGeneration(
       CPDF_Object::kInvalidObjNum, pdfium::MakeRetain<CPDF_Null>()));
 }
+
+TEST(CPDF_IndirectObjectHolderTest, DirtyObjNums) {
+  MockIndirectObjectHolder mock_holder;
+
+  EXPECT_CALL(mock_holder, ParseIndirectObject(::testing::_))
+      .WillOnce(::testing::WithArg<0>(
+          ::testing::Invoke([](uint32_t objnum) -> RetainPtr<CPDF_Object> {
+            return pdfium::MakeRetain<CPDF_Null>();
+          })));
+  ASSERT_TRUE(mock_holder.GetOrParseIndirectObject(1));
+  ::testing::Mock::VerifyAndClearExpectations(&mock_holder);
+
+  // Loaded objects are clean until marked.
+  EXPECT_TRUE(mock_holder.GetDirtyObjNums().empty());
+
+  // Added objects are dirty.
+  uint32_t new_objnum = mock_holder.NewIndirect<CPDF_Null>()->GetObjNum();
+  EXPECT_THAT(mock_holder.GetDirtyObjNums(),
+              ::testing::ElementsAre(new_objnum));
+
+  // Direct and invalid object numbers are ignored.
+  mock_holder.MarkIndirectObjectDirty(0);
+  mock_holder.MarkIndirectObjectDirty(CPDF_Object::kInvalidObjNum);
+  mock_holder.MarkIndirectObjectDirty(1);
+  EXPECT_THAT(mock_holder.GetDirtyObjNums(),
+              ::testing::ElementsAre(1u, new_objnum));
+
+  // Deleted objects are no longer dirty.
+  mock_holder.DeleteIndirectObject(new_objnum);
+  EXPECT_THAT(mock_holder.GetDirtyObjNums(), ::testing::ElementsAre(1u));
+}
@@ -9,14 +9,73 @@
 #include <algorithm>
 
 #include "core/fpdfapi/parser/cpdf_array.h"
+#include "core/fpdfapi/parser/cpdf_boolean.h"
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
 #include "core/fpdfapi/parser/cpdf_indirect_object_holder.h"
+#include "core/fpdfapi/parser/cpdf_name.h"
+#include "core/fpdfapi/parser/cpdf_null.h"
+#include "core/fpdfapi/parser/cpdf_number.h"
+#include "core/fpdfapi/parser/cpdf_object_arena.h"
 #include "core/fpdfapi/parser/cpdf_parser.h"
 #include "core/fpdfapi/parser/cpdf_reference.h"
+#include "core/fpdfapi/parser/cpdf_stream.h"
+#include "core/fpdfapi/parser/cpdf_string.h"
 #include "core/fxcrt/fx_string.h"
 #include "third_party/base/notreached.h"
 
-CPDF_Object::~CPDF_Object() = default;
+// CPDF_ObjectArena only guarantees pointer alignment, and every subclass goes
+// through CPDF_Object::operator new.
+static_assert(alignof(CPDF_Object) <= CPDF_ObjectArena::kAlignment,
+              "Over-aligned CPDF_Object");
+static_assert(alignof(CPDF_Array) <= CPDF_ObjectArena::kAlignment,
+              "Over-aligned CPDF_Array");
+static_assert(alignof(CPDF_Boolean) <= CPDF_ObjectArena::kAlignment,
+              "Over-aligned CPDF_Boolean");
+static_assert(alignof(CPDF_Dictionary) <= CPDF_ObjectArena::kAlignment,
+              "Over-aligned CPDF_Dictionary");
+static_assert(alignof(CPDF_Name) <= CPDF_ObjectArena::kAlignment,
+              "Over-aligned CPDF_Name");
+static_assert(alignof(CPDF_Null) <= CPDF_ObjectArena::kAlignment,
+              "Over-aligned CPDF_Null");
+static_assert(alignof(CPDF_Number) <= CPDF_ObjectArena::kAlignment,
+              "Over-aligned CPDF_Number");
+static_assert(alignof(CPDF_Reference) <= CPDF_ObjectArena::kAlignment,
+              "Over-aligned CPDF_Reference");
+static_assert(alignof(CPDF_Stream) <= CPDF_ObjectArena::kAlignment,
+              "Over-aligned CPDF_Stream");
+static_assert(alignof(CPDF_String) <= CPDF_ObjectArena::kAlignment,
+              "Over-aligned CPDF_String");
+
+namespace {
+
+// Set by ~CPDF_Object() for operator delete, which runs right after it but can
+// no longer look at the object.
+thread_local const void* g_ArenaObjectBeingDeleted = nullptr;
+
+}  // namespace
+
+// static
+void* CPDF_Object::operator new(size_t size) {
+  return CPDF_ObjectArena::Allocate(size);
+}
+
+// static
+void CPDF_Object::operator delete(void* ptr) {
+  const bool from_arena = ptr && ptr == g_ArenaObjectBeingDeleted;
+  g_ArenaObjectBeingDeleted = nullptr;
+  CPDF_ObjectArena::Free(ptr, from_arena);
+}
+
+// Constructors run after operator new, still inside the same ScopedUse.
+CPDF_Object::CPDF_Object()
+    : m_GenNum(0), m_bFromArena(CPDF_ObjectArena::IsFromCurrentArena(this)) {}
+
+CPDF_Object::~CPDF_Object() {
+  // Subclass members have all been destroyed by now, so nothing else gets
+  // deleted before operator delete.
+  if (m_bFromArena)
+    g_ArenaObjectBeingDeleted = this;
+}
 
 CPDF_Object* CPDF_Object::GetDirect() {
   return this;
@@ -43,6 +43,11 @@ class CPDF_Object : public Retainable {
     kReference
   };
 
+  // Objects come from the current thread's CPDF_ObjectArena, if any, and from
+  // the regular heap otherwise.
+  static void* operator new(size_t size);
+  static void operator delete(void* ptr);
+
   virtual Type GetType() const = 0;
   uint32_t GetObjNum() const { return m_ObjNum; }
   void SetObjNum(uint32_t objnum) { m_ObjNum = objnum; }
@@ -114,14 +119,17 @@ class CPDF_Object : public Retainable {
       CPDF_IndirectObjectHolder* holder) const;
 
  protected:
-  CPDF_Object() = default;
+  CPDF_Object();
   CPDF_Object(const CPDF_Object& src) = delete;
   ~CPDF_Object() override;
 
   RetainPtr<CPDF_Object> CloneObjectNonCyclic(bool bDirect) const;
 
   uint32_t m_ObjNum = 0;
-  uint32_t m_GenNum = 0;
+  // Generation numbers never exceed 65535, which leaves room for the flag.
+  uint32_t m_GenNum : 31;
+  // Whether operator new got the object's memory from a CPDF_ObjectArena.
+  uint32_t m_bFromArena : 1;
 };
 
 template <typename T>
@@ -0,0 +1,155 @@
+// Copyright 2020 PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfapi/parser/cpdf_object_arena.h"
+
+#include <stdint.h>
+
+#include <new>
+
+#include "core/fxcrt/fx_memory.h"
+#include "third_party/base/check.h"
+#include "third_party/base/memory/aligned_memory.h"
+
+struct CPDF_ObjectArena::Chunk {
+  // Cleared when the arena goes away before the chunk does.
+  CPDF_ObjectArena* arena;
+  // Bytes handed out so far, including the chunk header itself.
+  size_t used;
+  size_t live_count;
+  // Set once the owning arena stops allocating from the chunk.
+  bool retired;
+};
+
+namespace {
+
+constexpr size_t kAlignment = CPDF_ObjectArena::kAlignment;
+constexpr size_t kChunkSize = CPDF_ObjectArena::kChunkSize;
+constexpr size_t kChunkHeaderSize = sizeof(CPDF_ObjectArena::Chunk);
+static_assert(kChunkHeaderSize % kAlignment == 0, "Misaligned chunk header");
+static_assert((kChunkSize & (kChunkSize - 1)) == 0,
+              "Chunk size must be a power of 2");
+
+// Larger allocations go to the heap directly, so they never waste the tail of
+// a chunk.
+constexpr size_t kMaxArenaAllocation = kChunkSize / 4;
+
+thread_local CPDF_ObjectArena* g_CurrentArena = nullptr;
+
+// Chunks are aligned to their size, so the chunk of an arena allocation is
+// found by masking its address.
+CPDF_ObjectArena::Chunk* GetChunk(const void* ptr) {
+  uintptr_t base = reinterpret_cast<uintptr_t>(ptr) & ~(kChunkSize - 1);
+  return reinterpret_cast<CPDF_ObjectArena::Chunk*>(base);
+}
+
+}  // namespace
+
+CPDF_ObjectArena::ScopedUse::ScopedUse(CPDF_ObjectArena* arena)
+    : m_pPrevious(g_CurrentArena) {
+  g_CurrentArena = arena;
+}
+
+CPDF_ObjectArena::ScopedUse::~ScopedUse() {
+  g_CurrentArena = m_pPrevious;
+}
+
+// static
+void* CPDF_ObjectArena::Allocate(size_t size) {
+  const size_t aligned_size = FxAlignToBoundary<kAlignment>(size);
+  if (g_CurrentArena && aligned_size <= kMaxArenaAllocation)
+    return g_CurrentArena->AllocateFromChunk(aligned_size);
+
+  return ::operator new(size);
+}
+
+// static
+bool CPDF_ObjectArena::IsFromCurrentArena(const void* ptr) {
+  if (!g_CurrentArena)
+    return false;
+
+  // Usually the allocation just came out of the current chunk, but allocations
+  // made in between may have retired it already.
+  Chunk* chunk = GetChunk(ptr);
+  return chunk == g_CurrentArena->m_pCurrentChunk ||
+         g_CurrentArena->m_Chunks.count(chunk) > 0;
+}
+
+// static
+void CPDF_ObjectArena::Free(void* ptr, bool from_arena) {
+  if (!ptr)
+    return;
+
+  if (!from_arena) {
+    ::operator delete(ptr);
+    return;
+  }
+
+  Chunk* chunk = GetChunk(ptr);
+
+  DCHECK(chunk->live_count > 0);
+  if (--chunk->live_count > 0)
+    return;
+
+  if (chunk->retired) {
+    DeleteChunk(chunk);
+    return;
+  }
+
+  // The arena's current chunk is empty again, so start over from the top.
+  chunk->used = kChunkHeaderSize;
+}
+
+// static
+CPDF_ObjectArena* CPDF_ObjectArena::GetCurrent() {
+  return g_CurrentArena;
+}
+
+CPDF_ObjectArena::CPDF_ObjectArena() = default;
+
+CPDF_ObjectArena::~CPDF_ObjectArena() {
+  DCHECK(g_CurrentArena != this);
+  RetireCurrentChunk();
+
+  // The remaining chunks still hold live objects, and go away with the last of
+  // them.
+  for (Chunk* chunk : m_Chunks)
+    chunk->arena = nullptr;
+}
+
+void* CPDF_ObjectArena::AllocateFromChunk(size_t size) {
+  if (!m_pCurrentChunk || kChunkSize - m_pCurrentChunk->used < size) {
+    RetireCurrentChunk();
+    void* mem = pdfium::base::AlignedAlloc(kChunkSize, kChunkSize);
+    m_pCurrentChunk = new (mem) Chunk();
+    m_pCurrentChunk->arena = this;
+    m_pCurrentChunk->used = kChunkHeaderSize;
+    m_Chunks.insert(m_pCurrentChunk);
+    ++m_ChunkCount;
+  }
+
+  uint8_t* base = reinterpret_cast<uint8_t*>(m_pCurrentChunk);
+  void* result = base + m_pCurrentChunk->used;
+  m_pCurrentChunk->used += size;
+  ++m_pCurrentChunk->live_count;
+  return result;
+}
+
+void CPDF_ObjectArena::RetireCurrentChunk() {
+  if (!m_pCurrentChunk)
+    return;
+
+  if (m_pCurrentChunk->live_count == 0)
+    DeleteChunk(m_pCurrentChunk);
+  else
+    m_pCurrentChunk->retired = true;
+  m_pCurrentChunk = nullptr;
+}
+
+// static
+void CPDF_ObjectArena::DeleteChunk(Chunk* chunk) {
+  if (chunk->arena)
+    chunk->arena->m_Chunks.erase(chunk);
+  pdfium::base::AlignedFree(chunk);
+}
@@ -0,0 +1,89 @@
+// Copyright 2020 PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FPDFAPI_PARSER_CPDF_OBJECT_ARENA_H_
+#define CORE_FPDFAPI_PARSER_CPDF_OBJECT_ARENA_H_
+
+#include <stddef.h>
+
+#include <set>
+
+// Bump allocator for CPDF_Objects parsed out of one document. Objects are
+// carved out of large chunks, and a chunk is only returned to the system as a
+// whole: right away if it fills up and every object in it is gone, and
+// otherwise when the arena is destroyed along with its document. Objects keep
+// their usual reference counting, so any that outlive the arena keep their
+// chunk alive until the last of them is freed.
+//
+// Memory of individual objects is not reused until their whole chunk is
+// free, so this only pays off for documents that are mostly read.
+//
+// Allocations only come from an arena inside a ScopedUse for it. Elsewhere,
+// CPDF_Objects use the regular heap. Each CPDF_Object remembers whether it
+// came from an arena, so freeing a heap object never consults the arena, and
+// nothing is shared between arenas. Like the rest of a document, an arena and
+// its objects must only be used from one thread at a time.
+class CPDF_ObjectArena {
+ public:
+  // Routes CPDF_Object allocations on the current thread to |arena| for the
+  // lifetime of the scope. |arena| may be nullptr to use the heap.
+  class ScopedUse {
+   public:
+    explicit ScopedUse(CPDF_ObjectArena* arena);
+    ScopedUse(const ScopedUse& that) = delete;
+    ScopedUse& operator=(const ScopedUse& that) = delete;
+    ~ScopedUse();
+
+   private:
+    // Make stack-allocated.
+    void* operator new(size_t) = delete;
+    void* operator new(size_t, void*) = delete;
+
+    CPDF_ObjectArena* const m_pPrevious;
+  };
+
+  // Opaque outside of the implementation.
+  struct Chunk;
+
+  static constexpr size_t kChunkSize = 64 * 1024;
+
+  // Alignment of every allocation, arena or not.
+  static constexpr size_t kAlignment = alignof(void*);
+
+  // Allocates from the current thread's arena if there is one, and from the
+  // heap otherwise. Never returns nullptr.
+  static void* Allocate(size_t size);
+
+  // Whether |ptr| was returned by Allocate() from the current thread's arena,
+  // and has not been freed since.
+  static bool IsFromCurrentArena(const void* ptr);
+
+  // Frees memory returned by Allocate(). |from_arena| must be the result of
+  // IsFromCurrentArena() right after the allocation.
+  static void Free(void* ptr, bool from_arena);
+
+  static CPDF_ObjectArena* GetCurrent();
+
+  CPDF_ObjectArena();
+  CPDF_ObjectArena(const CPDF_ObjectArena& that) = delete;
+  CPDF_ObjectArena& operator=(const CPDF_ObjectArena& that) = delete;
+  ~CPDF_ObjectArena();
+
+  // Number of chunks allocated over the arena's lifetime.
+  size_t chunk_count() const { return m_ChunkCount; }
+
+ private:
+  void* AllocateFromChunk(size_t size);
+  void RetireCurrentChunk();
+
+  // Returns |chunk| to the system, and forgets it in its arena, if any.
+  static void DeleteChunk(Chunk* chunk);
+
+  Chunk* m_pCurrentChunk = nullptr;
+  // Every chunk of this arena still in memory, including retired ones.
+  std::set<Chunk*> m_Chunks;
+  size_t m_ChunkCount = 0;
+};
+
+#endif  // CORE_FPDFAPI_PARSER_CPDF_OBJECT_ARENA_H_
@@ -0,0 +1,141 @@
+// Copyright 2020 PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfapi/parser/cpdf_object_arena.h"
+
+#include <memory>
+#include <vector>
+
+#include "core/fpdfapi/parser/cpdf_dictionary.h"
+#include "core/fpdfapi/parser/cpdf_number.h"
+#include "core/fpdfapi/parser/cpdf_string.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+TEST(CPDF_ObjectArenaTest, NoArenaByDefault) {
+  EXPECT_FALSE(CPDF_ObjectArena::GetCurrent());
+
+  CPDF_ObjectArena arena;
+  auto number = pdfium::MakeRetain<CPDF_Number>(1);
+  EXPECT_EQ(0u, arena.chunk_count());
+  EXPECT_EQ(1, number->GetInteger());
+}
+
+TEST(CPDF_ObjectArenaTest, ScopedUse) {
+  CPDF_ObjectArena outer;
+  CPDF_ObjectArena inner;
+  {
+    CPDF_ObjectArena::ScopedUse outer_scope(&outer);
+    EXPECT_EQ(&outer, CPDF_ObjectArena::GetCurrent());
+    {
+      CPDF_ObjectArena::ScopedUse inner_scope(&inner);
+      EXPECT_EQ(&inner, CPDF_ObjectArena::GetCurrent());
+      {
+        CPDF_ObjectArena::ScopedUse heap_scope(nullptr);
+        EXPECT_FALSE(CPDF_ObjectArena::GetCurrent());
+      }
+      EXPECT_EQ(&inner, CPDF_ObjectArena::GetCurrent());
+    }
+    EXPECT_EQ(&outer, CPDF_ObjectArena::GetCurrent());
+  }
+  EXPECT_FALSE(CPDF_ObjectArena::GetCurrent());
+}
+
+TEST(CPDF_ObjectArenaTest, AllocateFromChunks) {
+  std::vector<RetainPtr<CPDF_Object>> objects;
+  CPDF_ObjectArena arena;
+  {
+    CPDF_ObjectArena::ScopedUse scope(&arena);
+    auto dict = pdfium::MakeRetain<CPDF_Dictionary>();
+    dict->SetNewFor<CPDF_String>("Key", "Value", false);
+    objects.push_back(dict);
+    EXPECT_EQ(1u, arena.chunk_count());
+
+    for (int i = 0; i < 10000; ++i)
+      objects.push_back(pdfium::MakeRetain<CPDF_Number>(i));
+  }
+  EXPECT_GT(arena.chunk_count(), 1u);
+  EXPECT_EQ("Value", objects[0]->GetDict()->GetStringFor("Key"));
+  EXPECT_EQ(9999, objects.back()->GetInteger());
+
+  // Objects made outside the scope do not touch the arena.
+  const size_t chunk_count = arena.chunk_count();
+  objects.push_back(pdfium::MakeRetain<CPDF_Number>(1));
+  EXPECT_EQ(chunk_count, arena.chunk_count());
+}
+
+TEST(CPDF_ObjectArenaTest, ReuseEmptyChunk) {
+  CPDF_ObjectArena arena;
+  CPDF_ObjectArena::ScopedUse scope(&arena);
+  for (int i = 0; i < 10000; ++i) {
+    auto number = pdfium::MakeRetain<CPDF_Number>(i);
+    EXPECT_EQ(i, number->GetInteger());
+  }
+  EXPECT_EQ(1u, arena.chunk_count());
+}
+
+TEST(CPDF_ObjectArenaTest, ObjectsOutliveArena) {
+  std::vector<RetainPtr<CPDF_Object>> objects;
+  {
+    auto arena = std::make_unique<CPDF_ObjectArena>();
+    CPDF_ObjectArena::ScopedUse scope(arena.get());
+    for (int i = 0; i < 10000; ++i)
+      objects.push_back(pdfium::MakeRetain<CPDF_Number>(i));
+
+    // Leave the scope before the arena goes away.
+    CPDF_ObjectArena::ScopedUse heap_scope(nullptr);
+    arena.reset();
+  }
+  for (int i = 0; i < 10000; ++i)
+    EXPECT_EQ(i, objects[i]->GetInteger());
+}
+
+TEST(CPDF_ObjectArenaTest, HeapObjectsWhileArenaExists) {
+  // Objects made outside any scope go to the heap, and must be freed there
+  // even while arena chunks exist.
+  auto heap_number = pdfium::MakeRetain<CPDF_Number>(1);
+  CPDF_ObjectArena arena;
+  RetainPtr<CPDF_Number> arena_number;
+  {
+    CPDF_ObjectArena::ScopedUse scope(&arena);
+    arena_number = pdfium::MakeRetain<CPDF_Number>(2);
+  }
+  EXPECT_EQ(1u, arena.chunk_count());
+  heap_number.Reset();
+  EXPECT_EQ(2, arena_number->GetInteger());
+  arena_number.Reset();
+}
+
+TEST(CPDF_ObjectArenaTest, LargeObjectsUseHeap) {
+  CPDF_ObjectArena arena;
+  CPDF_ObjectArena::ScopedUse scope(&arena);
+  void* ptr = CPDF_ObjectArena::Allocate(CPDF_ObjectArena::kChunkSize);
+  EXPECT_EQ(0u, arena.chunk_count());
+  EXPECT_FALSE(CPDF_ObjectArena::IsFromCurrentArena(ptr));
+  CPDF_ObjectArena::Free(ptr, false);
+}
+
+TEST(CPDF_ObjectArenaTest, IsFromCurrentArena) {
+  CPDF_ObjectArena arena;
+  CPDF_ObjectArena other;
+  CPDF_ObjectArena::ScopedUse scope(&arena);
+  void* first = CPDF_ObjectArena::Allocate(sizeof(CPDF_Number));
+  EXPECT_TRUE(CPDF_ObjectArena::IsFromCurrentArena(first));
+
+  // Still true once later allocations retire the chunk.
+  std::vector<RetainPtr<CPDF_Object>> objects;
+  for (int i = 0; i < 10000; ++i)
+    objects.push_back(pdfium::MakeRetain<CPDF_Number>(i));
+  EXPECT_GT(arena.chunk_count(), 1u);
+  EXPECT_TRUE(CPDF_ObjectArena::IsFromCurrentArena(first));
+
+  {
+    CPDF_ObjectArena::ScopedUse other_scope(&other);
+    EXPECT_FALSE(CPDF_ObjectArena::IsFromCurrentArena(first));
+  }
+  {
+    CPDF_ObjectArena::ScopedUse heap_scope(nullptr);
+    EXPECT_FALSE(CPDF_ObjectArena::IsFromCurrentArena(first));
+  }
+  CPDF_ObjectArena::Free(first, true);
+}
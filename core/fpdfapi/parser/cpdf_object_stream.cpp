@@ -78,6 +78,10 @@ bool CPDF_ObjectStream::HasObject(uint32_t obj_number) const {
   return pdfium::Contains(objects_offsets_, obj_number);
 }
 
+FX_FILESIZE CPDF_ObjectStream::GetDecodedSize() const {
+  return data_stream_->GetSize();
+}
+
 RetainPtr<CPDF_Object> CPDF_ObjectStream::ParseObject(
     CPDF_IndirectObjectHolder* pObjList,
     uint32_t obj_number) const {
@@ -97,7 +101,7 @@ void CPDF_ObjectStream::Init(const CPDF_Stream* stream) {
   {
     auto stream_acc = pdfium::MakeRetain<CPDF_StreamAcc>(stream);
     stream_acc->LoadAllDataFiltered();
-    const uint32_t data_size = stream_acc->GetSize();
+    const size_t data_size = stream_acc->GetSize();
     data_stream_ = pdfium::MakeRetain<CFX_ReadOnlyMemoryStream>(
         stream_acc->DetachData(), data_size);
   }
@@ -35,6 +35,9 @@ class CPDF_ObjectStream {
     return objects_offsets_;
   }
 
+  // Size of the decoded stream data held by this object.
+  FX_FILESIZE GetDecodedSize() const;
+
  protected:
   explicit CPDF_ObjectStream(const CPDF_Stream* stream);
 
@@ -23,6 +23,7 @@
 #include "core/fpdfapi/parser/cpdf_string.h"
 #include "core/fxcrt/fx_memory_wrappers.h"
 #include "testing/gtest/include/gtest/gtest.h"
+#include "testing/invalid_seekable_read_stream.h"
 #include "third_party/base/stl_util.h"
 
 namespace {
@@ -896,6 +897,18 @@ TEST(PDFStreamTest, LengthInDictionaryOnCreate) {
   }
 }
 
+TEST(PDFStreamTest, LengthOfLargeStreamFromFile) {
+  // Larger than any PDF integer. The file is never actually read.
+  static constexpr FX_FILESIZE kSize = 3 * 1024 * 1024 * 1024LL;
+  auto dict = pdfium::MakeRetain<CPDF_Dictionary>();
+  dict->SetNewFor<CPDF_Number>(pdfium::stream::kLength, 123);
+  auto stream = pdfium::MakeRetain<CPDF_Stream>();
+  stream->InitStreamFromFile(
+      pdfium::MakeRetain<InvalidSeekableReadStream>(kSize), std::move(dict));
+  EXPECT_EQ(static_cast<size_t>(kSize), stream->GetRawSize());
+  EXPECT_FALSE(stream->GetDict()->KeyExist(pdfium::stream::kLength));
+}
+
 TEST(PDFDictionaryTest, CloneDirectObject) {
   CPDF_IndirectObjectHolder objects_holder;
   auto dict = pdfium::MakeRetain<CPDF_Dictionary>();
@@ -1004,6 +1017,37 @@ TEST(PDFDictionaryTest, ExtractObjectOnRemove) {
   EXPECT_FALSE(extracted_object);
 }
 
+TEST(PDFDictionaryTest, KeysAreOrderedForAnySize) {
+  auto dict = pdfium::MakeRetain<CPDF_Dictionary>();
+  std::vector<ByteString> expected_keys;
+  for (int i = 99; i >= 0; --i) {
+    ByteString key = ByteString::Format("Key%02d", i);
+    dict->SetNewFor<CPDF_Number>(key, i);
+    expected_keys.insert(expected_keys.begin(), key);
+    ASSERT_EQ(expected_keys, dict->GetKeys());
+  }
+  for (int i = 0; i < 100; ++i)
+    EXPECT_EQ(i, dict->GetIntegerFor(ByteString::Format("Key%02d", i)));
+}
+
+TEST(PDFDictionaryTest, ReplaceKey) {
+  auto dict = pdfium::MakeRetain<CPDF_Dictionary>();
+  CPDF_Object* pObj = dict->SetNewFor<CPDF_Number>("A", 1);
+  dict->SetNewFor<CPDF_Number>("C", 3);
+
+  dict->ReplaceKey("A", "B");
+  EXPECT_EQ((std::vector<ByteString>{"B", "C"}), dict->GetKeys());
+  EXPECT_EQ(pObj, dict->GetObjectFor("B"));
+
+  dict->ReplaceKey("B", "C");
+  EXPECT_EQ((std::vector<ByteString>{"C"}), dict->GetKeys());
+  EXPECT_EQ(pObj, dict->GetObjectFor("C"));
+
+  dict->ReplaceKey("C", "C");
+  dict->ReplaceKey("D", "E");
+  EXPECT_EQ((std::vector<ByteString>{"C"}), dict->GetKeys());
+}
+
 TEST(PDFRefernceTest, MakeReferenceToReference) {
   auto obj_holder = std::make_unique<CPDF_IndirectObjectHolder>();
   auto original_ref = pdfium::MakeRetain<CPDF_Reference>(obj_holder.get(), 42);
@@ -6,10 +6,14 @@
 
 #include "core/fpdfapi/parser/cpdf_parser.h"
 
+#include <string.h>
+
 #include <algorithm>
+#include <sstream>
 #include <utility>
 #include <vector>
 
+#include "core/fdrm/fx_crypt.h"
 #include "core/fpdfapi/parser/cpdf_array.h"
 #include "core/fpdfapi/parser/cpdf_crypto_handler.h"
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
@@ -25,6 +29,7 @@
 #include "core/fpdfapi/parser/cpdf_syntax_parser.h"
 #include "core/fpdfapi/parser/fpdf_parser_utility.h"
 #include "core/fxcrt/autorestorer.h"
+#include "core/fxcrt/cfx_readonlymemorystream.h"
 #include "core/fxcrt/fx_extension.h"
 #include "core/fxcrt/fx_memory_wrappers.h"
 #include "core/fxcrt/fx_safe_types.h"
@@ -49,6 +54,88 @@ uint32_t GetVarInt(const uint8_t* p, int32_t n) {
   return result;
 }
 
+size_t GetDecodedSizeOrZero(const CPDF_ObjectStream* stream) {
+  return stream ? static_cast<size_t>(stream->GetDecodedSize()) : 0;
+}
+
+// Cross-reference cache format, all integers as LEB128 varints:
+//   magic, version,
+//   file size,
+//   section count, then per section: offset and size of a range of the file
+//   that cross-reference data was read from,
+//   flags, last xref offset,
+//   trailer size, trailer in PDF syntax,
+//   entry count, then per entry: object number delta, type byte, generation
+//   number, position or archive object number,
+//   SHA-256 of the first and last kCrossRefCacheDigestBlockSize bytes of the
+//   file, the bytes of every section, and everything above in the cache.
+constexpr uint8_t kCrossRefCacheMagic[] = {'P', 'D', 'F', 'X'};
+constexpr uint8_t kCrossRefCacheVersion = 3;
+constexpr size_t kCrossRefCacheDigestSize = 32;
+constexpr FX_FILESIZE kCrossRefCacheDigestBlockSize = 4096;
+constexpr size_t kCrossRefCacheReadBufferSize = 64 * 1024;
+constexpr uint8_t kCrossRefCacheXRefStreamFlag = 1 << 0;
+constexpr uint8_t kCrossRefCacheRebuiltFlag = 1 << 1;
+
+void AppendCacheVarInt(uint64_t value, std::vector<uint8_t>* out) {
+  while (value >= 0x80) {
+    out->push_back(static_cast<uint8_t>(value) | 0x80);
+    value >>= 7;
+  }
+  out->push_back(static_cast<uint8_t>(value));
+}
+
+class CrossRefCacheReader {
+ public:
+  explicit CrossRefCacheReader(pdfium::span<const uint8_t> data)
+      : data_(data) {}
+
+  bool IsEmpty() const { return data_.empty(); }
+
+  bool ReadByte(uint8_t* value) {
+    if (data_.empty())
+      return false;
+    *value = data_[0];
+    data_ = data_.subspan(1);
+    return true;
+  }
+
+  bool ReadVarInt(uint64_t* value) {
+    *value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+      uint8_t byte;
+      if (!ReadByte(&byte))
+        return false;
+      *value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+      if (!(byte & 0x80))
+        return true;
+    }
+    return false;
+  }
+
+  bool ReadBytes(uint64_t size, pdfium::span<const uint8_t>* bytes) {
+    if (size > data_.size())
+      return false;
+    *bytes = data_.first(static_cast<size_t>(size));
+    data_ = data_.subspan(static_cast<size_t>(size));
+    return true;
+  }
+
+ private:
+  pdfium::span<const uint8_t> data_;
+};
+
+bool IsValidCrossRefCacheType(uint8_t type) {
+  switch (static_cast<CPDF_CrossRefTable::ObjectType>(type)) {
+    case CPDF_CrossRefTable::ObjectType::kFree:
+    case CPDF_CrossRefTable::ObjectType::kNormal:
+    case CPDF_CrossRefTable::ObjectType::kCompressed:
+    case CPDF_CrossRefTable::ObjectType::kObjStream:
+      return true;
+  }
+  return false;
+}
+
 class ObjectsHolderStub final : public CPDF_Parser::ParsedObjectsHolder {
  public:
   ObjectsHolderStub() = default;
@@ -76,7 +163,7 @@ CPDF_Parser::~CPDF_Parser() {
 uint32_t CPDF_Parser::GetLastObjNum() const {
   return m_CrossRefTable->objects_info().empty()
              ? 0
-             : m_CrossRefTable->objects_info().rbegin()->first;
+             : m_CrossRefTable->objects_info().GetLastKey();
 }
 
 bool CPDF_Parser::IsValidObjectNumber(uint32_t objnum) const {
@@ -151,30 +238,46 @@ CPDF_Parser::Error CPDF_Parser::StartParse(
           pdfium::MakeRetain<CPDF_ReadValidator>(pFileAccess, nullptr)))
     return FORMAT_ERROR;
   SetPassword(password);
-  return StartParseInternal();
+  return StartParseInternal({});
 }
 
-CPDF_Parser::Error CPDF_Parser::StartParseInternal() {
+CPDF_Parser::Error CPDF_Parser::StartParseWithCrossRefCache(
+    const RetainPtr<IFX_SeekableReadStream>& pFileAccess,
+    const char* password,
+    pdfium::span<const uint8_t> xref_cache) {
+  if (!InitSyntaxParser(
+          pdfium::MakeRetain<CPDF_ReadValidator>(pFileAccess, nullptr)))
+    return FORMAT_ERROR;
+  SetPassword(password);
+  return StartParseInternal(xref_cache);
+}
+
+CPDF_Parser::Error CPDF_Parser::StartParseInternal(
+    pdfium::span<const uint8_t> xref_cache) {
   DCHECK(!m_bHasParsed);
   DCHECK(!m_bXRefTableRebuilt);
   m_bHasParsed = true;
   m_bXRefStream = false;
 
-  m_LastXRefOffset = ParseStartXRef();
-  if (m_LastXRefOffset >= kPDFHeaderSize) {
-    if (!LoadAllCrossRefV4(m_LastXRefOffset) &&
-        !LoadAllCrossRefV5(m_LastXRefOffset)) {
+  if (LoadCrossRefCache(xref_cache)) {
+    m_bLoadedFromCrossRefCache = true;
+  } else {
+    m_LastXRefOffset = ParseStartXRef();
+    if (m_LastXRefOffset >= kPDFHeaderSize) {
+      if (!LoadAllCrossRefV4(m_LastXRefOffset) &&
+          !LoadAllCrossRefV5(m_LastXRefOffset)) {
+        if (!RebuildCrossRef())
+          return FORMAT_ERROR;
+
+        m_bXRefTableRebuilt = true;
+        m_LastXRefOffset = 0;
+      }
+    } else {
       if (!RebuildCrossRef())
         return FORMAT_ERROR;
 
       m_bXRefTableRebuilt = true;
-      m_LastXRefOffset = 0;
     }
-  } else {
-    if (!RebuildCrossRef())
-      return FORMAT_ERROR;
-
-    m_bXRefTableRebuilt = true;
   }
   Error eRet = SetEncryptHandler();
   if (eRet != SUCCESS)
@@ -293,6 +396,7 @@ bool CPDF_Parser::LoadAllCrossRefV4(FX_FILESIZE xref_offset) {
   if (!trailer)
     return false;
 
+  AddCrossRefSection(xref_offset, m_pSyntax->GetPos());
   m_CrossRefTable->SetTrailer(std::move(trailer));
   int32_t xrefsize = GetDirectInteger(GetTrailer(), "Size");
   if (xrefsize > 0 && xrefsize <= kMaxXRefSize)
@@ -321,6 +425,7 @@ bool CPDF_Parser::LoadAllCrossRefV4(FX_FILESIZE xref_offset) {
     if (!pDict)
       return false;
 
+    AddCrossRefSection(xref_offset, m_pSyntax->GetPos());
     xref_offset = GetDirectInteger(pDict.Get(), "Prev");
 
     // SLOW ...
@@ -579,7 +684,7 @@ bool CPDF_Parser::LoadAllCrossRefV5(FX_FILESIZE xref_offset) {
     if (pdfium::Contains(seen_xref_offset, xref_offset))
       return false;
   }
-  m_ObjectStreamMap.clear();
+  ClearObjectStreamCache();
   m_bXRefStream = true;
   return true;
 }
@@ -587,6 +692,10 @@ bool CPDF_Parser::LoadAllCrossRefV5(FX_FILESIZE xref_offset) {
 bool CPDF_Parser::RebuildCrossRef() {
   auto cross_ref_table = std::make_unique<CPDF_CrossRefTable>();
 
+  // The rebuilt table depends on every byte of the file.
+  m_CrossRefSections.clear();
+  AddCrossRefSection(0, m_pSyntax->GetDocumentSize());
+
   const uint32_t kBufferSize = 4096;
   m_pSyntax->SetReadBufferSize(kBufferSize);
   m_pSyntax->SetPos(0);
@@ -656,7 +765,9 @@ bool CPDF_Parser::RebuildCrossRef() {
 }
 
 bool CPDF_Parser::LoadCrossRefV5(FX_FILESIZE* pos, bool bMainXRef) {
-  RetainPtr<CPDF_Object> pObject(ParseIndirectObjectAt(*pos, 0));
+  FX_FILESIZE end_pos = 0;
+  RetainPtr<CPDF_Object> pObject(
+      ParseIndirectObjectAtInternal(*pos, 0, &end_pos));
   if (!pObject || !pObject->GetObjNum())
     return false;
 
@@ -664,6 +775,7 @@ bool CPDF_Parser::LoadCrossRefV5(FX_FILESIZE* pos, bool bMainXRef) {
   if (!pStream)
     return false;
 
+  AddCrossRefSection(*pos, end_pos);
   CPDF_Dictionary* pDict = pStream->GetDict();
   *pos = pDict->GetIntegerFor("Prev");
   int32_t size = pDict->GetIntegerFor("Size");
@@ -719,7 +831,7 @@ bool CPDF_Parser::LoadCrossRefV5(FX_FILESIZE* pos, bool bMainXRef) {
   pAcc->LoadAllDataFiltered();
 
   const uint8_t* pData = pAcc->GetData();
-  uint32_t dwTotalSize = pAcc->GetSize();
+  const size_t dwTotalSize = pAcc->GetSize();
   uint32_t segindex = 0;
   for (const auto& index : arrIndex) {
     const int32_t startnum = index.first;
@@ -880,7 +992,14 @@ RetainPtr<CPDF_Object> CPDF_Parser::ParseIndirectObject(uint32_t objnum) {
   if (!pObjStream)
     return nullptr;
 
-  return pObjStream->ParseObject(m_pObjectsHolder.Get(), objnum);
+  RetainPtr<CPDF_Object> result;
+  {
+    AutoRestorer<int> depth_restorer(&m_ObjectStreamUseDepth);
+    ++m_ObjectStreamUseDepth;
+    result = pObjStream->ParseObject(m_pObjectsHolder.Get(), objnum);
+  }
+  TrimObjectStreamCache();
+  return result;
 }
 
 const CPDF_ObjectStream* CPDF_Parser::GetObjectStream(uint32_t object_number) {
@@ -892,8 +1011,11 @@ const CPDF_ObjectStream* CPDF_Parser::GetObjectStream(uint32_t object_number) {
                                                     object_number);
 
   auto it = m_ObjectStreamMap.find(object_number);
-  if (it != m_ObjectStreamMap.end())
-    return it->second.get();
+  if (it != m_ObjectStreamMap.end()) {
+    m_ObjectStreamLru.splice(m_ObjectStreamLru.begin(), m_ObjectStreamLru,
+                             it->second.lru_pos);
+    return it->second.stream.get();
+  }
 
   const auto* info = m_CrossRefTable->GetObjectInfo(object_number);
   if (!info || info->type != ObjectType::kObjStream)
@@ -911,18 +1033,55 @@ const CPDF_ObjectStream* CPDF_Parser::GetObjectStream(uint32_t object_number) {
   std::unique_ptr<CPDF_ObjectStream> objs_stream =
       CPDF_ObjectStream::Create(ToStream(object.Get()));
   const CPDF_ObjectStream* result = objs_stream.get();
-  m_ObjectStreamMap[object_number] = std::move(objs_stream);
-
+  m_ObjectStreamCacheSize += GetDecodedSizeOrZero(result);
+  m_ObjectStreamLru.push_front(object_number);
+  ObjectStreamCacheEntry& entry = m_ObjectStreamMap[object_number];
+  entry.stream = std::move(objs_stream);
+  entry.lru_pos = m_ObjectStreamLru.begin();
   return result;
 }
 
+void CPDF_Parser::SetObjectStreamCacheLimit(size_t limit) {
+  m_ObjectStreamCacheLimit = limit;
+  TrimObjectStreamCache();
+}
+
+void CPDF_Parser::TrimObjectStreamCache() {
+  if (m_ObjectStreamUseDepth > 0)
+    return;
+
+  while (m_ObjectStreamCacheSize > m_ObjectStreamCacheLimit &&
+         m_ObjectStreamLru.size() > 1) {
+    auto it = m_ObjectStreamMap.find(m_ObjectStreamLru.back());
+    DCHECK(it != m_ObjectStreamMap.end());
+    m_ObjectStreamCacheSize -= GetDecodedSizeOrZero(it->second.stream.get());
+    m_ObjectStreamMap.erase(it);
+    m_ObjectStreamLru.pop_back();
+  }
+}
+
+void CPDF_Parser::ClearObjectStreamCache() {
+  m_ObjectStreamMap.clear();
+  m_ObjectStreamLru.clear();
+  m_ObjectStreamCacheSize = 0;
+}
+
 RetainPtr<CPDF_Object> CPDF_Parser::ParseIndirectObjectAt(FX_FILESIZE pos,
                                                           uint32_t objnum) {
+  return ParseIndirectObjectAtInternal(pos, objnum, nullptr);
+}
+
+RetainPtr<CPDF_Object> CPDF_Parser::ParseIndirectObjectAtInternal(
+    FX_FILESIZE pos,
+    uint32_t objnum,
+    FX_FILESIZE* end_pos) {
   const FX_FILESIZE saved_pos = m_pSyntax->GetPos();
   m_pSyntax->SetPos(pos);
 
   auto result = m_pSyntax->GetIndirectObject(
       m_pObjectsHolder.Get(), CPDF_SyntaxParser::ParseType::kLoose);
+  if (end_pos)
+    *end_pos = m_pSyntax->GetPos();
   m_pSyntax->SetPos(saved_pos);
   if (result && objnum && result->GetObjNum() != objnum)
     return nullptr;
@@ -941,6 +1100,27 @@ uint32_t CPDF_Parser::GetFirstPageNo() const {
   return m_pLinearized ? m_pLinearized->GetFirstPageNo() : 0;
 }
 
+bool CPDF_Parser::IsDataLoadedAsynchronously() const {
+  return m_pSyntax && m_pSyntax->GetValidator()->has_async_download_hints();
+}
+
+bool CPDF_Parser::IsObjectDataPending(uint32_t objnum) {
+  if (!IsDataLoadedAsynchronously())
+    return false;
+
+  const RetainPtr<CPDF_ReadValidator>& validator = m_pSyntax->GetValidator();
+  CPDF_ReadValidator::ScopedSession read_session(validator);
+  if (m_pObjectsHolder->GetOrParseIndirectObject(objnum))
+    return false;
+
+  if (!validator->has_unavailable_data() || validator->read_error())
+    return false;
+
+  // Data that is on its way is not a read problem.
+  validator->ResetErrors();
+  return true;
+}
+
 void CPDF_Parser::SetLinearizedHeaderForTesting(
     std::unique_ptr<CPDF_LinearizedHeader> pLinearized) {
   m_pLinearized = std::move(pLinearized);
@@ -975,7 +1155,7 @@ CPDF_Parser::Error CPDF_Parser::StartLinearizedParse(
 
   m_pLinearized = ParseLinearizedHeader();
   if (!m_pLinearized)
-    return StartParseInternal();
+    return StartParseInternal({});
 
   m_bHasParsed = true;
 
@@ -1054,7 +1234,7 @@ bool CPDF_Parser::LoadLinearizedAllCrossRefV5(FX_FILESIZE main_xref_offset) {
     if (pdfium::Contains(seen_xref_offset, xref_offset))
       return false;
   }
-  m_ObjectStreamMap.clear();
+  ClearObjectStreamCache();
   m_bXRefStream = true;
   return true;
 }
@@ -1070,7 +1250,7 @@ CPDF_Parser::Error CPDF_Parser::LoadLinearizedMainXRefTable() {
 
   const AutoRestorer<uint32_t> save_metadata_objnum(&m_MetadataObjnum);
   m_MetadataObjnum = 0;
-  m_ObjectStreamMap.clear();
+  ClearObjectStreamCache();
 
   if (!LoadLinearizedAllCrossRefV4(main_xref_offset) &&
       !LoadLinearizedAllCrossRefV5(main_xref_offset)) {
@@ -1094,3 +1274,224 @@ CPDF_Parser::ObjectType CPDF_Parser::GetObjectTypeFromCrossRefStreamType(
       return CPDF_Parser::ObjectType::kNull;
   }
 }
+
+std::vector<uint8_t> CPDF_Parser::SerializeCrossRefCache() const {
+  std::vector<uint8_t> result;
+  if (!m_pSyntax || !GetTrailer())
+    return result;
+
+  std::ostringstream trailer_buf;
+  trailer_buf << GetTrailer();
+  const std::string trailer = trailer_buf.str();
+
+  result.insert(result.end(), std::begin(kCrossRefCacheMagic),
+                std::end(kCrossRefCacheMagic));
+  result.push_back(kCrossRefCacheVersion);
+  AppendCacheVarInt(m_pSyntax->GetValidator()->GetSize(), &result);
+  AppendCacheVarInt(m_CrossRefSections.size(), &result);
+  for (const CrossRefSection& section : m_CrossRefSections) {
+    AppendCacheVarInt(section.offset, &result);
+    AppendCacheVarInt(section.size, &result);
+  }
+
+  uint8_t flags = 0;
+  if (m_bXRefStream)
+    flags |= kCrossRefCacheXRefStreamFlag;
+  if (m_bXRefTableRebuilt)
+    flags |= kCrossRefCacheRebuiltFlag;
+  result.push_back(flags);
+  AppendCacheVarInt(m_LastXRefOffset, &result);
+
+  AppendCacheVarInt(trailer.size(), &result);
+  result.insert(result.end(), trailer.begin(), trailer.end());
+
+  const auto& objects_info = m_CrossRefTable->objects_info();
+  AppendCacheVarInt(objects_info.size(), &result);
+  uint32_t prev_obj_num = 0;
+  for (const auto& it : objects_info) {
+    const ObjectInfo& info = it.second;
+    AppendCacheVarInt(it.first - prev_obj_num, &result);
+    prev_obj_num = it.first;
+    result.push_back(static_cast<uint8_t>(info.type));
+    AppendCacheVarInt(info.gennum, &result);
+    AppendCacheVarInt(info.type == ObjectType::kCompressed
+                          ? info.archive_obj_num
+                          : static_cast<uint64_t>(info.pos),
+                      &result);
+  }
+
+  uint8_t digest[kCrossRefCacheDigestSize];
+  if (!ComputeCrossRefCacheDigest(m_CrossRefSections, result, digest))
+    return std::vector<uint8_t>();
+  result.insert(result.end(), std::begin(digest), std::end(digest));
+  return result;
+}
+
+bool CPDF_Parser::LoadCrossRefCache(pdfium::span<const uint8_t> xref_cache) {
+  if (xref_cache.size() < kCrossRefCacheDigestSize)
+    return false;
+
+  const pdfium::span<const uint8_t> payload =
+      xref_cache.first(xref_cache.size() - kCrossRefCacheDigestSize);
+  const pdfium::span<const uint8_t> digest =
+      xref_cache.subspan(payload.size());
+  CrossRefCacheReader reader(payload);
+  pdfium::span<const uint8_t> magic;
+  uint8_t version;
+  if (!reader.ReadBytes(sizeof(kCrossRefCacheMagic), &magic) ||
+      memcmp(magic.data(), kCrossRefCacheMagic, magic.size()) != 0 ||
+      !reader.ReadByte(&version) || version != kCrossRefCacheVersion) {
+    return false;
+  }
+
+  uint64_t file_size;
+  uint64_t section_count;
+  if (!reader.ReadVarInt(&file_size) ||
+      file_size !=
+          static_cast<uint64_t>(m_pSyntax->GetValidator()->GetSize()) ||
+      !reader.ReadVarInt(&section_count)) {
+    return false;
+  }
+
+  std::vector<CrossRefSection> sections;
+  for (uint64_t i = 0; i < section_count; ++i) {
+    uint64_t offset;
+    uint64_t size;
+    if (!reader.ReadVarInt(&offset) || !reader.ReadVarInt(&size) ||
+        offset > file_size || size > file_size - offset) {
+      return false;
+    }
+    CrossRefSection section;
+    section.offset = static_cast<FX_FILESIZE>(offset);
+    section.size = static_cast<FX_FILESIZE>(size);
+    sections.push_back(section);
+  }
+
+  // Nothing else in the cache is trusted until it matches the digest.
+  uint8_t expected_digest[kCrossRefCacheDigestSize];
+  if (!ComputeCrossRefCacheDigest(sections, payload, expected_digest) ||
+      memcmp(digest.data(), expected_digest, digest.size()) != 0) {
+    return false;
+  }
+
+  uint8_t flags;
+  uint64_t last_xref_offset;
+  uint64_t trailer_size;
+  pdfium::span<const uint8_t> trailer_data;
+  if (!reader.ReadByte(&flags) || !reader.ReadVarInt(&last_xref_offset) ||
+      last_xref_offset > file_size || !reader.ReadVarInt(&trailer_size) ||
+      !reader.ReadBytes(trailer_size, &trailer_data)) {
+    return false;
+  }
+
+  CPDF_SyntaxParser trailer_parser(
+      pdfium::MakeRetain<CFX_ReadOnlyMemoryStream>(trailer_data));
+  RetainPtr<CPDF_Dictionary> trailer =
+      ToDictionary(trailer_parser.GetObjectBody(m_pObjectsHolder.Get()));
+  if (!trailer)
+    return false;
+
+  auto cross_ref_table =
+      std::make_unique<CPDF_CrossRefTable>(std::move(trailer));
+  uint64_t count;
+  if (!reader.ReadVarInt(&count))
+    return false;
+
+  uint64_t obj_num = 0;
+  for (uint64_t i = 0; i < count; ++i) {
+    uint64_t delta;
+    uint8_t type;
+    uint64_t gennum;
+    uint64_t value;
+    if (!reader.ReadVarInt(&delta) || (i > 0 && delta == 0) ||
+        !reader.ReadByte(&type) || !IsValidCrossRefCacheType(type) ||
+        !reader.ReadVarInt(&gennum) || gennum > 0xFFFF ||
+        !reader.ReadVarInt(&value)) {
+      return false;
+    }
+
+    obj_num += delta;
+    if (obj_num >= kMaxObjectNumber)
+      return false;
+
+    ObjectInfo info;
+    info.type = static_cast<ObjectType>(type);
+    info.gennum = static_cast<uint16_t>(gennum);
+    if (info.type == ObjectType::kCompressed) {
+      if (value >= kMaxObjectNumber)
+        return false;
+      info.archive_obj_num = static_cast<uint32_t>(value);
+    } else {
+      if (value > file_size)
+        return false;
+      info.pos = static_cast<FX_FILESIZE>(value);
+    }
+    cross_ref_table->SetObjectInfo(static_cast<uint32_t>(obj_num), info);
+  }
+  if (!reader.IsEmpty())
+    return false;
+
+  m_CrossRefTable = std::move(cross_ref_table);
+  m_CrossRefSections = std::move(sections);
+  m_bXRefStream = !!(flags & kCrossRefCacheXRefStreamFlag);
+  m_bXRefTableRebuilt = !!(flags & kCrossRefCacheRebuiltFlag);
+  m_LastXRefOffset = static_cast<FX_FILESIZE>(last_xref_offset);
+  return true;
+}
+
+bool CPDF_Parser::ComputeCrossRefCacheDigest(
+    const std::vector<CrossRefSection>& sections,
+    pdfium::span<const uint8_t> payload,
+    uint8_t digest[32]) const {
+  const RetainPtr<CPDF_ReadValidator>& validator = m_pSyntax->GetValidator();
+  const FX_FILESIZE file_size = validator->GetSize();
+  const FX_FILESIZE head_size =
+      std::min(file_size, kCrossRefCacheDigestBlockSize);
+  const FX_FILESIZE tail_start =
+      std::max(head_size, file_size - kCrossRefCacheDigestBlockSize);
+
+  std::vector<CrossRefSection> ranges(1);
+  ranges[0].size = head_size;
+  if (tail_start < file_size) {
+    CrossRefSection tail;
+    tail.offset = tail_start;
+    tail.size = file_size - tail_start;
+    ranges.push_back(tail);
+  }
+  ranges.insert(ranges.end(), sections.begin(), sections.end());
+
+  CRYPT_sha2_context context;
+  CRYPT_SHA256Start(&context);
+  std::vector<uint8_t, FxAllocAllocator<uint8_t>> buf(
+      kCrossRefCacheReadBufferSize);
+  for (const CrossRefSection& range : ranges) {
+    FX_FILESIZE offset = range.offset;
+    FX_FILESIZE remaining = range.size;
+    while (remaining > 0) {
+      const size_t read_size = static_cast<size_t>(std::min<FX_FILESIZE>(
+          remaining, kCrossRefCacheReadBufferSize));
+      if (!validator->ReadBlockAtOffset(buf.data(), offset, read_size))
+        return false;
+      CRYPT_SHA256Update(&context, buf.data(), read_size);
+      offset += read_size;
+      remaining -= read_size;
+    }
+  }
+  CRYPT_SHA256Update(&context, payload.data(), payload.size());
+  CRYPT_SHA256Finish(&context, digest);
+  return true;
+}
+
+void CPDF_Parser::AddCrossRefSection(FX_FILESIZE start, FX_FILESIZE end) {
+  if (end <= start)
+    return;
+
+  // The syntax parser's positions are relative to the header offset, but
+  // sections are recorded as file offsets.
+  const FX_FILESIZE header_offset =
+      m_pSyntax->GetValidator()->GetSize() - m_pSyntax->GetDocumentSize();
+  CrossRefSection section;
+  section.offset = start + header_offset;
+  section.size = end - start;
+  m_CrossRefSections.push_back(section);
+}
@@ -8,6 +8,7 @@
 #define CORE_FPDFAPI_PARSER_CPDF_PARSER_H_
 
 #include <limits>
+#include <list>
 #include <map>
 #include <memory>
 #include <set>
@@ -19,6 +20,7 @@
 #include "core/fxcrt/fx_system.h"
 #include "core/fxcrt/retain_ptr.h"
 #include "core/fxcrt/unowned_ptr.h"
+#include "third_party/base/span.h"
 
 class CPDF_Array;
 class CPDF_CryptoHandler;
@@ -55,12 +57,22 @@ class CPDF_Parser {
 
   static constexpr size_t kInvalidPos = std::numeric_limits<size_t>::max();
 
+  // Default limit on the total decoded size of cached object streams.
+  static constexpr size_t kDefaultObjectStreamCacheLimit = 32 * 1024 * 1024;
+
   explicit CPDF_Parser(ParsedObjectsHolder* holder);
   CPDF_Parser();
   ~CPDF_Parser();
 
   Error StartParse(const RetainPtr<IFX_SeekableReadStream>& pFile,
                    const char* password);
+  // Like StartParse(), but restores the cross-reference state from
+  // |xref_cache|, as returned by SerializeCrossRefCache(), instead of parsing
+  // it. Parses normally if the cache is malformed or belongs to another file.
+  Error StartParseWithCrossRefCache(
+      const RetainPtr<IFX_SeekableReadStream>& pFile,
+      const char* password,
+      pdfium::span<const uint8_t> xref_cache);
   Error StartLinearizedParse(const RetainPtr<CPDF_ReadValidator>& validator,
                              const char* password);
 
@@ -118,9 +130,40 @@ class CPDF_Parser {
 
   CPDF_SyntaxParser* GetSyntax() const { return m_pSyntax.get(); }
 
+  // Returns whether data that is not available yet gets requested from an
+  // asynchronous source, which callers able to wait for it should wait for.
+  bool IsDataLoadedAsynchronously() const;
+
+  // Returns whether object |objnum| cannot be parsed only because some of its
+  // data is still being loaded asynchronously. Requests that data as well.
+  // Once the data is there, the object is parsed into the objects holder, so
+  // callers find it when they look it up again.
+  bool IsObjectDataPending(uint32_t objnum);
+
+  // Serializes the resolved cross-reference table and trailer into a compact
+  // binary form, so that reopening the same file can skip parsing them. The
+  // cache is tied to the file size and a digest of the start and end of the
+  // file, where incremental updates land, and of every cross-reference
+  // section the table was read from, or of the whole file if the table had to
+  // be rebuilt. The digest covers the cached data as well. Returns an empty
+  // vector if there is nothing to serialize.
+  std::vector<uint8_t> SerializeCrossRefCache() const;
+  bool loaded_from_cross_ref_cache() const {
+    return m_bLoadedFromCrossRefCache;
+  }
+
   void SetLinearizedHeaderForTesting(
       std::unique_ptr<CPDF_LinearizedHeader> pLinearized);
 
+  // Decoded object streams are kept in a least-recently-used cache. Once the
+  // total decoded size exceeds |limit|, the least recently used streams are
+  // dropped and decoded again if needed. The most recently used stream is
+  // always kept.
+  void SetObjectStreamCacheLimit(size_t limit);
+  size_t GetObjectStreamCacheSizeForTesting() const {
+    return m_ObjectStreamCacheSize;
+  }
+
  protected:
   using ObjectType = CPDF_CrossRefTable::ObjectType;
   using ObjectInfo = CPDF_CrossRefTable::ObjectInfo;
@@ -142,7 +185,25 @@ class CPDF_Parser {
     ObjectInfo info;
   };
 
-  Error StartParseInternal();
+  // Range of file offsets that a cross-reference section was read from.
+  struct CrossRefSection {
+    FX_FILESIZE offset = 0;
+    FX_FILESIZE size = 0;
+  };
+
+  Error StartParseInternal(pdfium::span<const uint8_t> xref_cache);
+  bool LoadCrossRefCache(pdfium::span<const uint8_t> xref_cache);
+  // Hashes the parts of the file that |sections| and the start and end of the
+  // file cover, followed by |payload|, the cache data that the digest protects.
+  bool ComputeCrossRefCacheDigest(const std::vector<CrossRefSection>& sections,
+                                  pdfium::span<const uint8_t> payload,
+                                  uint8_t digest[32]) const;
+  // Records that a cross-reference section spans [start, end) in the
+  // syntax parser's coordinates.
+  void AddCrossRefSection(FX_FILESIZE start, FX_FILESIZE end);
+  RetainPtr<CPDF_Object> ParseIndirectObjectAtInternal(FX_FILESIZE pos,
+                                                       uint32_t objnum,
+                                                       FX_FILESIZE* end_pos);
   FX_FILESIZE ParseStartXRef();
   bool LoadAllCrossRefV4(FX_FILESIZE xref_offset);
   bool LoadAllCrossRefV5(FX_FILESIZE xref_offset);
@@ -154,6 +215,8 @@ class CPDF_Parser {
   bool LoadLinearizedAllCrossRefV5(FX_FILESIZE main_xref_offset);
   Error LoadLinearizedMainXRefTable();
   const CPDF_ObjectStream* GetObjectStream(uint32_t object_number);
+  void TrimObjectStreamCache();
+  void ClearObjectStreamCache();
   std::unique_ptr<CPDF_LinearizedHeader> ParseLinearizedHeader();
   void ShrinkObjectMap(uint32_t size);
   // A simple check whether the cross reference table matches with
@@ -182,17 +245,37 @@ class CPDF_Parser {
   bool m_bHasParsed = false;
   bool m_bXRefStream = false;
   bool m_bXRefTableRebuilt = false;
+  bool m_bLoadedFromCrossRefCache = false;
   int m_FileVersion = 0;
   // m_CrossRefTable must be destroyed after m_pSecurityHandler due to the
   // ownership of the ID array data.
   std::unique_ptr<CPDF_CrossRefTable> m_CrossRefTable;
   FX_FILESIZE m_LastXRefOffset;
+  std::vector<CrossRefSection> m_CrossRefSections;
   RetainPtr<CPDF_SecurityHandler> m_pSecurityHandler;
   ByteString m_Password;
   std::unique_ptr<CPDF_LinearizedHeader> m_pLinearized;
 
-  // A map of object numbers to indirect streams.
-  std::map<uint32_t, std::unique_ptr<CPDF_ObjectStream>> m_ObjectStreamMap;
+  struct ObjectStreamCacheEntry {
+    std::unique_ptr<CPDF_ObjectStream> stream;
+    std::list<uint32_t>::iterator lru_pos;
+  };
+
+  // A map of object numbers to decoded object streams.
+  std::map<uint32_t, ObjectStreamCacheEntry> m_ObjectStreamMap;
+
+  // Object numbers of the streams in |m_ObjectStreamMap|, most recently used
+  // first.
+  std::list<uint32_t> m_ObjectStreamLru;
+
+  // Total decoded size of the streams in |m_ObjectStreamMap|.
+  size_t m_ObjectStreamCacheSize = 0;
+  size_t m_ObjectStreamCacheLimit = kDefaultObjectStreamCacheLimit;
+
+  // Non-zero while an object is being parsed out of a cached object stream.
+  // Parsing can recurse into other object streams, so eviction has to wait
+  // until the outermost parse is done.
+  int m_ObjectStreamUseDepth = 0;
 
   // All indirect object numbers that are being parsed.
   std::set<uint32_t> m_ParsingObjNums;
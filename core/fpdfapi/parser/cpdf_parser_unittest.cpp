@@ -4,9 +4,14 @@
 
 #include "core/fpdfapi/parser/cpdf_parser.h"
 
+#include <stdio.h>
+#include <string.h>
+
 #include <limits>
+#include <map>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "core/fpdfapi/parser/cpdf_linearized_header.h"
@@ -16,6 +21,7 @@
 #include "core/fxcrt/fx_extension.h"
 #include "core/fxcrt/fx_stream.h"
 #include "core/fxcrt/retain_ptr.h"
+#include "core/fxcrt/unowned_ptr.h"
 #include "testing/gtest/include/gtest/gtest.h"
 #include "testing/utils/path_service.h"
 #include "third_party/base/stl_util.h"
@@ -28,6 +34,58 @@ CPDF_CrossRefTable::ObjectInfo GetObjInfo(const CPDF_Parser& parser,
   return info ? *info : CPDF_CrossRefTable::ObjectInfo();
 }
 
+class TestObjectsHolder final : public CPDF_Parser::ParsedObjectsHolder {
+ public:
+  TestObjectsHolder() = default;
+  ~TestObjectsHolder() override = default;
+
+  // CPDF_Parser::ParsedObjectsHolder:
+  bool TryInit() override { return true; }
+
+  void set_parser(CPDF_Parser* parser) { parser_ = parser; }
+
+ protected:
+  // CPDF_IndirectObjectHolder:
+  RetainPtr<CPDF_Object> ParseIndirectObject(uint32_t objnum) override {
+    return parser_->ParseIndirectObject(objnum);
+  }
+
+ private:
+  UnownedPtr<CPDF_Parser> parser_;
+};
+
+std::string XRefEntry(size_t pos) {
+  char buf[21];
+  snprintf(buf, sizeof(buf), "%010zu 00000 n\r\n", pos);
+  return buf;
+}
+
+// Builds a document with an incremental update, padded so that the original
+// cross-reference section is neither at the start nor at the end of the file.
+std::string BuildPaddedIncrementalDocument() {
+  const std::string padding(5000, 'x');
+  std::string doc = "%PDF-1.7\n";
+  const size_t catalog_pos = doc.size();
+  doc += "1 0 obj\n<</Type/Catalog/Pages 2 0 R>>\nendobj\n";
+  const size_t pages_pos = doc.size();
+  doc += "2 0 obj\n<</Type/Pages/Count 0/Kids[]>>\nendobj\n";
+  const size_t first_padding_pos = doc.size();
+  doc += "3 0 obj\n(" + padding + ")\nendobj\n";
+  const size_t first_xref_pos = doc.size();
+  doc += "xref\n0 4\n0000000000 65535 f\r\n" + XRefEntry(catalog_pos) +
+         XRefEntry(pages_pos) + XRefEntry(first_padding_pos) +
+         "trailer\n<</Size 4/Root 1 0 R>>\nstartxref\n" +
+         std::to_string(first_xref_pos) + "\n%%EOF\n";
+  const size_t second_padding_pos = doc.size();
+  doc += "4 0 obj\n(" + padding + ")\nendobj\n";
+  const size_t second_xref_pos = doc.size();
+  doc += "xref\n4 1\n" + XRefEntry(second_padding_pos) +
+         "trailer\n<</Size 5/Root 1 0 R/Prev " +
+         std::to_string(first_xref_pos) + ">>\nstartxref\n" +
+         std::to_string(second_xref_pos) + "\n%%EOF\n";
+  return doc;
+}
+
 }  // namespace
 
 // A wrapper class to help test member functions of CPDF_Parser.
@@ -330,7 +388,192 @@ TEST(cpdf_parser, BadStartXrefShouldNotBuildCrossRefTable) {
       "%%EOF\n";
   CPDF_TestParser parser;
   ASSERT_TRUE(parser.InitTestFromBuffer(kData));
-  EXPECT_EQ(CPDF_Parser::FORMAT_ERROR, parser.StartParseInternal());
+  EXPECT_EQ(CPDF_Parser::FORMAT_ERROR, parser.StartParseInternal({}));
   ASSERT_TRUE(parser.GetCrossRefTable());
   EXPECT_EQ(0u, parser.GetCrossRefTable()->objects_info().size());
 }
+
+TEST(cpdf_parser, ObjectStreamCacheLimit) {
+  std::string test_file;
+  ASSERT_TRUE(PathService::GetTestFilePath("page_labels.pdf", &test_file));
+  RetainPtr<IFX_SeekableReadStream> pFileAccess =
+      IFX_SeekableReadStream::CreateFromFilename(test_file.c_str());
+  ASSERT_TRUE(pFileAccess);
+
+  TestObjectsHolder holder;
+  CPDF_Parser parser(&holder);
+  holder.set_parser(&parser);
+  ASSERT_EQ(CPDF_Parser::SUCCESS, parser.StartParse(pFileAccess, nullptr));
+
+  // Pick one compressed object from each object stream.
+  std::map<uint32_t, uint32_t> obj_stream_to_obj_num;
+  for (const auto& it : parser.GetCrossRefTable()->objects_info()) {
+    if (it.second.type == CPDF_CrossRefTable::ObjectType::kCompressed)
+      obj_stream_to_obj_num.emplace(it.second.archive_obj_num, it.first);
+  }
+  ASSERT_GE(obj_stream_to_obj_num.size(), 2u);
+
+  // With no room in the cache, only the most recently used object stream is
+  // kept, and evicted streams are decoded again on demand.
+  parser.SetObjectStreamCacheLimit(0);
+  EXPECT_EQ(0u, parser.GetObjectStreamCacheSizeForTesting());
+  for (int pass = 0; pass < 2; ++pass) {
+    for (const auto& it : obj_stream_to_obj_num) {
+      EXPECT_TRUE(parser.ParseIndirectObject(it.second));
+      EXPECT_GT(parser.GetObjectStreamCacheSizeForTesting(), 0u);
+    }
+  }
+  const size_t single_stream_size = parser.GetObjectStreamCacheSizeForTesting();
+
+  parser.SetObjectStreamCacheLimit(CPDF_Parser::kDefaultObjectStreamCacheLimit);
+  for (const auto& it : obj_stream_to_obj_num)
+    EXPECT_TRUE(parser.ParseIndirectObject(it.second));
+  EXPECT_GT(parser.GetObjectStreamCacheSizeForTesting(), single_stream_size);
+}
+
+TEST(cpdf_parser, CrossRefCacheRoundTrip) {
+  std::string test_file;
+  ASSERT_TRUE(PathService::GetTestFilePath("page_labels.pdf", &test_file));
+  RetainPtr<IFX_SeekableReadStream> pFileAccess =
+      IFX_SeekableReadStream::CreateFromFilename(test_file.c_str());
+  ASSERT_TRUE(pFileAccess);
+
+  std::vector<uint8_t> cache;
+  std::vector<std::pair<uint32_t, CPDF_CrossRefTable::ObjectInfo>> objects;
+  uint32_t root_obj_num;
+  {
+    TestObjectsHolder holder;
+    CPDF_Parser parser(&holder);
+    holder.set_parser(&parser);
+    ASSERT_EQ(CPDF_Parser::SUCCESS, parser.StartParse(pFileAccess, nullptr));
+    EXPECT_FALSE(parser.loaded_from_cross_ref_cache());
+    for (const auto& it : parser.GetCrossRefTable()->objects_info())
+      objects.emplace_back(it.first, it.second);
+    root_obj_num = parser.GetRootObjNum();
+    cache = parser.SerializeCrossRefCache();
+  }
+  ASSERT_FALSE(cache.empty());
+
+  {
+    TestObjectsHolder holder;
+    CPDF_Parser parser(&holder);
+    holder.set_parser(&parser);
+    ASSERT_EQ(CPDF_Parser::SUCCESS,
+              parser.StartParseWithCrossRefCache(pFileAccess, nullptr, cache));
+    EXPECT_TRUE(parser.loaded_from_cross_ref_cache());
+    EXPECT_TRUE(parser.IsXRefStream());
+    EXPECT_EQ(root_obj_num, parser.GetRootObjNum());
+
+    size_t i = 0;
+    for (const auto& it : parser.GetCrossRefTable()->objects_info()) {
+      ASSERT_LT(i, objects.size());
+      EXPECT_EQ(objects[i].first, it.first);
+      EXPECT_EQ(objects[i].second.type, it.second.type);
+      EXPECT_EQ(objects[i].second.gennum, it.second.gennum);
+      if (it.second.type == CPDF_CrossRefTable::ObjectType::kCompressed)
+        EXPECT_EQ(objects[i].second.archive_obj_num, it.second.archive_obj_num);
+      else
+        EXPECT_EQ(objects[i].second.pos, it.second.pos);
+      ++i;
+    }
+    EXPECT_EQ(objects.size(), i);
+    EXPECT_TRUE(parser.ParseIndirectObject(root_obj_num));
+  }
+
+  // A truncated cache is ignored.
+  {
+    TestObjectsHolder holder;
+    CPDF_Parser parser(&holder);
+    holder.set_parser(&parser);
+    ASSERT_EQ(CPDF_Parser::SUCCESS,
+              parser.StartParseWithCrossRefCache(
+                  pFileAccess, nullptr,
+                  pdfium::make_span(cache).first(cache.size() - 1)));
+    EXPECT_FALSE(parser.loaded_from_cross_ref_cache());
+    EXPECT_EQ(root_obj_num, parser.GetRootObjNum());
+  }
+
+  // A cache whose own data changed is ignored. The byte before the digest is
+  // part of the position or archive object number of the last entry.
+  {
+    std::vector<uint8_t> corrupt_cache = cache;
+    corrupt_cache[corrupt_cache.size() - 33] ^= 1;
+    TestObjectsHolder holder;
+    CPDF_Parser parser(&holder);
+    holder.set_parser(&parser);
+    ASSERT_EQ(CPDF_Parser::SUCCESS, parser.StartParseWithCrossRefCache(
+                                        pFileAccess, nullptr, corrupt_cache));
+    EXPECT_FALSE(parser.loaded_from_cross_ref_cache());
+    EXPECT_EQ(root_obj_num, parser.GetRootObjNum());
+  }
+
+  // A cache made for a different file is ignored.
+  std::string other_file;
+  ASSERT_TRUE(PathService::GetTestFilePath("hello_world.pdf", &other_file));
+  RetainPtr<IFX_SeekableReadStream> pOtherFileAccess =
+      IFX_SeekableReadStream::CreateFromFilename(other_file.c_str());
+  ASSERT_TRUE(pOtherFileAccess);
+  {
+    TestObjectsHolder holder;
+    CPDF_Parser parser(&holder);
+    holder.set_parser(&parser);
+    ASSERT_EQ(CPDF_Parser::SUCCESS, parser.StartParseWithCrossRefCache(
+                                        pOtherFileAccess, nullptr, cache));
+    EXPECT_FALSE(parser.loaded_from_cross_ref_cache());
+    EXPECT_FALSE(parser.IsXRefStream());
+  }
+}
+
+TEST(cpdf_parser, CrossRefCacheCoversCrossRefSections) {
+  std::string doc = BuildPaddedIncrementalDocument();
+  std::vector<uint8_t> cache;
+  {
+    TestObjectsHolder holder;
+    CPDF_Parser parser(&holder);
+    holder.set_parser(&parser);
+    ASSERT_EQ(CPDF_Parser::SUCCESS,
+              parser.StartParse(pdfium::MakeRetain<CFX_ReadOnlyMemoryStream>(
+                                    pdfium::as_bytes(pdfium::make_span(doc))),
+                                nullptr));
+    EXPECT_FALSE(parser.IsXRefStream());
+    EXPECT_FALSE(parser.xref_table_rebuilt());
+    cache = parser.SerializeCrossRefCache();
+  }
+  ASSERT_FALSE(cache.empty());
+
+  {
+    TestObjectsHolder holder;
+    CPDF_Parser parser(&holder);
+    holder.set_parser(&parser);
+    ASSERT_EQ(CPDF_Parser::SUCCESS,
+              parser.StartParseWithCrossRefCache(
+                  pdfium::MakeRetain<CFX_ReadOnlyMemoryStream>(
+                      pdfium::as_bytes(pdfium::make_span(doc))),
+                  nullptr, cache));
+    EXPECT_TRUE(parser.loaded_from_cross_ref_cache());
+  }
+
+  // Change the generation number of object 3 in the original section, which
+  // keeps the file size and the first and last bytes of the file the same.
+  // Entries are 20 bytes each, with the generation number at offset 11.
+  static constexpr char kFirstSection[] = "xref\n0 4\n";
+  const size_t first_xref_pos = doc.find(kFirstSection);
+  ASSERT_NE(std::string::npos, first_xref_pos);
+  ASSERT_GT(first_xref_pos, 4096u);
+  ASSERT_LT(first_xref_pos + 200, doc.size() - 4096);
+  const size_t gennum_pos =
+      first_xref_pos + strlen(kFirstSection) + 3 * 20 + 15;
+  ASSERT_EQ('0', doc[gennum_pos]);
+  doc[gennum_pos] = '1';
+  {
+    TestObjectsHolder holder;
+    CPDF_Parser parser(&holder);
+    holder.set_parser(&parser);
+    ASSERT_EQ(CPDF_Parser::SUCCESS,
+              parser.StartParseWithCrossRefCache(
+                  pdfium::MakeRetain<CFX_ReadOnlyMemoryStream>(
+                      pdfium::as_bytes(pdfium::make_span(doc))),
+                  nullptr, cache));
+    EXPECT_FALSE(parser.loaded_from_cross_ref_cache());
+  }
+}
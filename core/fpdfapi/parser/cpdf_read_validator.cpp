@@ -25,6 +25,20 @@ FX_FILESIZE AlignUp(FX_FILESIZE offset) {
   return safe_result.ValueOrDefault(offset);
 }
 
+// Unavailable segments at most this far apart get requested together, since
+// fetching the gap costs less than another request.
+constexpr FX_FILESIZE kMaxCoalescedGap = 16 * 1024;
+
+// Segments are not coalesced into requests larger than this.
+constexpr FX_FILESIZE kMaxCoalescedRequestSize = 4 * 1024 * 1024;
+
+struct DownloadRequest {
+  FX_FILESIZE start;
+  FX_FILESIZE end;
+  // Index of the highest priority segment in the request.
+  size_t priority;
+};
+
 }  // namespace
 
 CPDF_ReadValidator::ScopedSession::ScopedSession(
@@ -79,9 +93,46 @@ FX_FILESIZE CPDF_ReadValidator::GetSize() {
   return file_size_;
 }
 
+bool CPDF_ReadValidator::NeedToWaitForData(FX_FILESIZE offset, size_t size) {
+  if (!async_hints_)
+    return false;
+
+  FX_SAFE_FILESIZE end_offset = offset;
+  end_offset += size;
+  if (!end_offset.IsValid() || end_offset.ValueOrDie() > file_size_)
+    return false;
+
+  if (IsDataRangeAvailable(offset, size))
+    return false;
+
+  // Data that is on its way is not a read problem.
+  const bool saved_has_unavailable_data = has_unavailable_data_;
+  ScheduleDownload(offset, size);
+  has_unavailable_data_ = saved_has_unavailable_data;
+  return true;
+}
+
+pdfium::span<const uint8_t> CPDF_ReadValidator::GetSpan() {
+  // Only rely on availability that is already known. Asking |file_avail_|
+  // about the whole file would tell the embedder it is needed, or worse,
+  // mark it as available.
+  if (file_avail_ && !whole_file_already_available_)
+    return {};
+
+  pdfium::span<const uint8_t> span = file_read_->GetSpan();
+  if (span.size() != static_cast<size_t>(file_size_))
+    return {};
+  return span;
+}
+
+CPDF_DataAvail::DownloadHints* CPDF_ReadValidator::GetDownloadHints() const {
+  return hints_ ? hints_.Get() : async_hints_.Get();
+}
+
 void CPDF_ReadValidator::ScheduleDownload(FX_FILESIZE offset, size_t size) {
   has_unavailable_data_ = true;
-  if (!hints_ || size == 0)
+  CPDF_DataAvail::DownloadHints* hints = GetDownloadHints();
+  if (!hints || size == 0)
     return;
 
   const FX_FILESIZE start_segment_offset = AlignDown(offset);
@@ -100,7 +151,79 @@ void CPDF_ReadValidator::ScheduleDownload(FX_FILESIZE offset, size_t size) {
     NOTREACHED();
     return;
   }
-  hints_->AddSegment(start_segment_offset, segment_size.ValueOrDie());
+  hints->AddSegment(start_segment_offset, segment_size.ValueOrDie());
+}
+
+void CPDF_ReadValidator::ScheduleDownloads(const std::vector<Range>& segments) {
+  has_unavailable_data_ = true;
+  CPDF_DataAvail::DownloadHints* hints = GetDownloadHints();
+  if (!hints)
+    return;
+
+  std::vector<DownloadRequest> requests;
+  for (size_t i = 0; i < segments.size(); ++i) {
+    const Range& segment = segments[i];
+    FX_SAFE_FILESIZE end_segment_offset = segment.first;
+    end_segment_offset += segment.second;
+    if (segment.second == 0 || !end_segment_offset.IsValid())
+      continue;
+
+    requests.push_back(
+        {AlignDown(segment.first),
+         std::min(file_size_, AlignUp(end_segment_offset.ValueOrDie())), i});
+  }
+  if (requests.empty())
+    return;
+
+  std::sort(requests.begin(), requests.end(),
+            [](const DownloadRequest& a, const DownloadRequest& b) {
+              return a.start < b.start;
+            });
+  std::vector<DownloadRequest> coalesced_requests;
+  coalesced_requests.push_back(requests[0]);
+  for (size_t i = 1; i < requests.size(); ++i) {
+    const DownloadRequest& request = requests[i];
+    DownloadRequest& last = coalesced_requests.back();
+    if (request.end > last.end &&
+        (request.start - last.end > kMaxCoalescedGap ||
+         request.end - last.start > kMaxCoalescedRequestSize)) {
+      coalesced_requests.push_back(request);
+      continue;
+    }
+    last.end = std::max(last.end, request.end);
+    last.priority = std::min(last.priority, request.priority);
+  }
+
+  std::stable_sort(coalesced_requests.begin(), coalesced_requests.end(),
+                   [](const DownloadRequest& a, const DownloadRequest& b) {
+                     return a.priority < b.priority;
+                   });
+  for (const DownloadRequest& request : coalesced_requests) {
+    hints->AddSegment(request.start,
+                       static_cast<size_t>(request.end - request.start));
+  }
+}
+
+Optional<CPDF_ReadValidator::Range> CPDF_ReadValidator::GetSegmentToCheck(
+    FX_FILESIZE offset,
+    size_t size) const {
+  FX_SAFE_FILESIZE end_segment_offset = offset;
+  end_segment_offset += size;
+  // Increase checked range to allow CPDF_SyntaxParser read whole buffer.
+  end_segment_offset += CPDF_Stream::kFileBufSize;
+  if (!end_segment_offset.IsValid()) {
+    NOTREACHED();
+    return pdfium::nullopt;
+  }
+  end_segment_offset = std::min(
+      file_size_, static_cast<FX_FILESIZE>(end_segment_offset.ValueOrDie()));
+  FX_SAFE_SIZE_T segment_size = end_segment_offset;
+  segment_size -= offset;
+  if (!segment_size.IsValid()) {
+    NOTREACHED();
+    return pdfium::nullopt;
+  }
+  return Range(offset, segment_size.ValueOrDie());
 }
 
 bool CPDF_ReadValidator::IsDataRangeAvailable(FX_FILESIZE offset,
@@ -125,27 +248,46 @@ bool CPDF_ReadValidator::CheckDataRangeAndRequestIfUnavailable(
   if (offset > file_size_)
     return true;
 
-  FX_SAFE_FILESIZE end_segment_offset = offset;
-  end_segment_offset += size;
-  // Increase checked range to allow CPDF_SyntaxParser read whole buffer.
-  end_segment_offset += CPDF_Stream::kFileBufSize;
-  if (!end_segment_offset.IsValid()) {
-    NOTREACHED();
+  Optional<Range> segment = GetSegmentToCheck(offset, size);
+  if (!segment.has_value())
     return false;
-  }
-  end_segment_offset = std::min(
-      file_size_, static_cast<FX_FILESIZE>(end_segment_offset.ValueOrDie()));
-  FX_SAFE_SIZE_T segment_size = end_segment_offset;
-  segment_size -= offset;
-  if (!segment_size.IsValid()) {
-    NOTREACHED();
-    return false;
-  }
 
-  if (IsDataRangeAvailable(offset, segment_size.ValueOrDie()))
+  if (IsDataRangeAvailable(segment->first, segment->second))
+    return true;
+
+  ScheduleDownload(segment->first, segment->second);
+  return false;
+}
+
+bool CPDF_ReadValidator::CheckDataRangesAndRequestIfUnavailable(
+    const std::vector<Range>& ranges,
+    const std::vector<Range>& prefetch_ranges) {
+  std::vector<Range> unavailable_segments;
+  for (const Range& range : ranges) {
+    if (range.first > file_size_)
+      continue;
+
+    Optional<Range> segment = GetSegmentToCheck(range.first, range.second);
+    if (!segment.has_value())
+      return false;
+
+    if (!IsDataRangeAvailable(segment->first, segment->second))
+      unavailable_segments.push_back(segment.value());
+  }
+  if (unavailable_segments.empty())
     return true;
 
-  ScheduleDownload(offset, segment_size.ValueOrDie());
+  for (const Range& range : prefetch_ranges) {
+    if (range.first > file_size_)
+      continue;
+
+    Optional<Range> segment = GetSegmentToCheck(range.first, range.second);
+    if (segment.has_value() &&
+        !IsDataRangeAvailable(segment->first, segment->second)) {
+      unavailable_segments.push_back(segment.value());
+    }
+  }
+  ScheduleDownloads(unavailable_segments);
   return false;
 }
 
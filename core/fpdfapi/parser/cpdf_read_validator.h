@@ -5,10 +5,14 @@
 #ifndef CORE_FPDFAPI_PARSER_CPDF_READ_VALIDATOR_H_
 #define CORE_FPDFAPI_PARSER_CPDF_READ_VALIDATOR_H_
 
+#include <utility>
+#include <vector>
+
 #include "core/fpdfapi/parser/cpdf_data_avail.h"
 #include "core/fxcrt/fx_stream.h"
 #include "core/fxcrt/retain_ptr.h"
 #include "core/fxcrt/unowned_ptr.h"
+#include "third_party/base/optional.h"
 
 class CPDF_ReadValidator : public IFX_SeekableReadStream {
  public:
@@ -29,11 +33,23 @@ class CPDF_ReadValidator : public IFX_SeekableReadStream {
     const bool saved_has_unavailable_data_;
   };
 
+  // An offset and a size.
+  using Range = std::pair<FX_FILESIZE, size_t>;
+
   CONSTRUCT_VIA_MAKE_RETAIN;
 
   void SetDownloadHints(CPDF_DataAvail::DownloadHints* hints) {
     hints_ = hints;
   }
+
+  // Sets the hints that receive requests for unavailable data when no hints
+  // are set with SetDownloadHints(). While these are set, NeedToWaitForData()
+  // requests unavailable data and reports that it is worth waiting for.
+  void SetAsyncDownloadHints(CPDF_DataAvail::DownloadHints* hints) {
+    async_hints_ = hints;
+  }
+  bool has_async_download_hints() const { return !!async_hints_; }
+
   bool read_error() const { return read_error_; }
   bool has_unavailable_data() const { return has_unavailable_data_; }
   bool has_read_problems() const {
@@ -43,6 +59,15 @@ class CPDF_ReadValidator : public IFX_SeekableReadStream {
   void ResetErrors();
   bool IsWholeFileAvailable();
   bool CheckDataRangeAndRequestIfUnavailable(FX_FILESIZE offset, size_t size);
+
+  // Checks all of |ranges| like CheckDataRangeAndRequestIfUnavailable(). When
+  // any are unavailable, requests the unavailable parts of both |ranges| and
+  // |prefetch_ranges| at once. Both are in priority order. Ranges close to
+  // each other are coalesced into one request, and requests are made in the
+  // order of the highest priority range each one covers.
+  bool CheckDataRangesAndRequestIfUnavailable(
+      const std::vector<Range>& ranges,
+      const std::vector<Range>& prefetch_ranges);
   bool CheckWholeFileAndRequestIfUnavailable();
 
   // IFX_SeekableReadStream overrides:
@@ -50,6 +75,10 @@ class CPDF_ReadValidator : public IFX_SeekableReadStream {
                          FX_FILESIZE offset,
                          size_t size) override;
   FX_FILESIZE GetSize() override;
+  bool NeedToWaitForData(FX_FILESIZE offset, size_t size) override;
+  // Only exposes the underlying span once the whole file is available, so
+  // direct reads never bypass availability checks.
+  pdfium::span<const uint8_t> GetSpan() override;
 
  protected:
   CPDF_ReadValidator(const RetainPtr<IFX_SeekableReadStream>& file_read,
@@ -57,12 +86,16 @@ class CPDF_ReadValidator : public IFX_SeekableReadStream {
   ~CPDF_ReadValidator() override;
 
  private:
+  CPDF_DataAvail::DownloadHints* GetDownloadHints() const;
   void ScheduleDownload(FX_FILESIZE offset, size_t size);
+  void ScheduleDownloads(const std::vector<Range>& segments);
+  Optional<Range> GetSegmentToCheck(FX_FILESIZE offset, size_t size) const;
   bool IsDataRangeAvailable(FX_FILESIZE offset, size_t size) const;
 
   RetainPtr<IFX_SeekableReadStream> const file_read_;
   UnownedPtr<CPDF_DataAvail::FileAvail> const file_avail_;
   UnownedPtr<CPDF_DataAvail::DownloadHints> hints_;
+  UnownedPtr<CPDF_DataAvail::DownloadHints> async_hints_;
   bool read_error_ = false;
   bool has_unavailable_data_ = false;
   bool whole_file_already_available_ = false;
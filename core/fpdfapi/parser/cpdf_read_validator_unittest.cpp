@@ -50,16 +50,26 @@ class MockDownloadHints final : public CPDF_DataAvail::DownloadHints {
   void AddSegment(FX_FILESIZE offset, size_t size) override {
     last_requested_range_.first = offset;
     last_requested_range_.second = offset + size;
+    requested_ranges_.push_back(last_requested_range_);
   }
 
   const std::pair<FX_FILESIZE, FX_FILESIZE>& GetLastRequstedRange() const {
     return last_requested_range_;
   }
 
-  void Reset() { last_requested_range_ = MakeRange(0, 0); }
+  const std::vector<std::pair<FX_FILESIZE, FX_FILESIZE>>& GetRequestedRanges()
+      const {
+    return requested_ranges_;
+  }
+
+  void Reset() {
+    last_requested_range_ = MakeRange(0, 0);
+    requested_ranges_.clear();
+  }
 
  private:
   std::pair<FX_FILESIZE, FX_FILESIZE> last_requested_range_;
+  std::vector<std::pair<FX_FILESIZE, FX_FILESIZE>> requested_ranges_;
 };
 
 }  // namespace
@@ -294,3 +304,101 @@ TEST(CPDF_ReadValidatorTest, CheckDataRangeAndRequestIfUnavailable) {
 
   validator->SetDownloadHints(nullptr);
 }
+
+TEST(CPDF_ReadValidatorTest, CheckDataRangesAndRequestIfUnavailable) {
+  std::vector<uint8_t, FxAllocAllocator<uint8_t>> test_data(kTestDataSize);
+  auto file = pdfium::MakeRetain<CFX_ReadOnlyMemoryStream>(test_data);
+  MockFileAvail file_avail;
+  auto validator = pdfium::MakeRetain<CPDF_ReadValidator>(file, &file_avail);
+
+  MockDownloadHints hints;
+  validator->SetDownloadHints(&hints);
+
+  const std::vector<CPDF_ReadValidator::Range> ranges = {{20000, 100}};
+  const std::vector<CPDF_ReadValidator::Range> prefetch_ranges = {
+      {21000, 100}, {1000, 100}, {30000, 100}, {50000, 100}};
+  EXPECT_FALSE(validator->CheckDataRangesAndRequestIfUnavailable(
+      ranges, prefetch_ranges));
+  EXPECT_FALSE(validator->read_error());
+  EXPECT_TRUE(validator->has_unavailable_data());
+
+  // Nearby ranges should be coalesced, and the request covering |ranges|
+  // should come first. The rest follow in order of |prefetch_ranges|.
+  ASSERT_EQ(3u, hints.GetRequestedRanges().size());
+  EXPECT_EQ(MakeRange(19968, 30720), hints.GetRequestedRanges()[0]);
+  EXPECT_EQ(MakeRange(512, 2048), hints.GetRequestedRanges()[1]);
+  EXPECT_EQ(MakeRange(49664, 50688), hints.GetRequestedRanges()[2]);
+
+  // Nothing gets prefetched once |ranges| are available.
+  file_avail.SetAvailableRange(19968, 20992);
+  hints.Reset();
+  validator->ResetErrors();
+  EXPECT_TRUE(validator->CheckDataRangesAndRequestIfUnavailable(
+      ranges, prefetch_ranges));
+  EXPECT_TRUE(hints.GetRequestedRanges().empty());
+  EXPECT_FALSE(validator->has_unavailable_data());
+
+  validator->SetDownloadHints(nullptr);
+}
+
+TEST(CPDF_ReadValidatorTest, NeedToWaitForData) {
+  std::vector<uint8_t, FxAllocAllocator<uint8_t>> test_data(kTestDataSize);
+  auto file = pdfium::MakeRetain<CFX_ReadOnlyMemoryStream>(test_data);
+  MockFileAvail file_avail;
+  auto validator = pdfium::MakeRetain<CPDF_ReadValidator>(file, &file_avail);
+
+  // Without async hints, there is nothing to wait for.
+  EXPECT_FALSE(validator->NeedToWaitForData(5000, 100));
+
+  MockDownloadHints async_hints;
+  validator->SetAsyncDownloadHints(&async_hints);
+  EXPECT_TRUE(validator->NeedToWaitForData(5000, 100));
+  EXPECT_EQ(MakeRange(4608, 5120), async_hints.GetLastRequstedRange());
+  // Waiting is not a read problem.
+  EXPECT_FALSE(validator->read_error());
+  EXPECT_FALSE(validator->has_unavailable_data());
+
+  // Failed reads request data through the async hints, unless other hints
+  // are set.
+  async_hints.Reset();
+  std::vector<uint8_t, FxAllocAllocator<uint8_t>> read_buffer(100);
+  EXPECT_FALSE(validator->ReadBlockAtOffset(read_buffer.data(), 8000,
+                                            read_buffer.size()));
+  EXPECT_EQ(MakeRange(7680, 8192), async_hints.GetLastRequstedRange());
+
+  async_hints.Reset();
+  MockDownloadHints hints;
+  validator->SetDownloadHints(&hints);
+  EXPECT_FALSE(validator->ReadBlockAtOffset(read_buffer.data(), 8000,
+                                            read_buffer.size()));
+  EXPECT_EQ(MakeRange(7680, 8192), hints.GetLastRequstedRange());
+  EXPECT_TRUE(async_hints.GetRequestedRanges().empty());
+  validator->SetDownloadHints(nullptr);
+  validator->ResetErrors();
+
+  // Reads that cannot succeed are not worth waiting for.
+  EXPECT_FALSE(validator->NeedToWaitForData(kTestDataSize, 1));
+
+  file_avail.SetAvailableRange(4608, 5120);
+  async_hints.Reset();
+  EXPECT_FALSE(validator->NeedToWaitForData(5000, 100));
+  EXPECT_TRUE(async_hints.GetRequestedRanges().empty());
+
+  validator->SetAsyncDownloadHints(nullptr);
+}
+
+TEST(CPDF_ReadValidatorTest, GetSpan) {
+  std::vector<uint8_t, FxAllocAllocator<uint8_t>> test_data(kTestDataSize);
+  auto file = pdfium::MakeRetain<CFX_ReadOnlyMemoryStream>(test_data);
+  auto validator = pdfium::MakeRetain<CPDF_ReadValidator>(file, nullptr);
+  EXPECT_EQ(kTestDataSize, validator->GetSpan().size());
+
+  // With data availability to check, the span is only exposed once the whole
+  // file is known to be available, and GetSpan() does not check that itself.
+  MockFileAvail file_avail;
+  file_avail.SetAvailableRange(0, kTestDataSize);
+  validator = pdfium::MakeRetain<CPDF_ReadValidator>(file, &file_avail);
+  EXPECT_TRUE(validator->GetSpan().empty());
+  EXPECT_TRUE(validator->CheckWholeFileAndRequestIfUnavailable());
+  EXPECT_EQ(kTestDataSize, validator->GetSpan().size());
+}
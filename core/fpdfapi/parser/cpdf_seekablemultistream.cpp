@@ -45,7 +45,7 @@ bool CPDF_SeekableMultiStream::ReadBlockAtOffset(void* buffer,
   }
   while (index < iCount) {
     const auto& acc = m_Data[index];
-    uint32_t dwSize = acc->GetSize();
+    size_t dwSize = acc->GetSize();
     size_t dwRead = std::min(size, static_cast<size_t>(dwSize - offset));
     memcpy(buffer, acc->GetSpan().subspan(offset, dwRead).data(), dwRead);
     size -= dwRead;
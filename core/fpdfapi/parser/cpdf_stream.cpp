@@ -6,6 +6,7 @@
 
 #include "core/fpdfapi/parser/cpdf_stream.h"
 
+#include <limits>
 #include <utility>
 #include <vector>
 
@@ -27,12 +28,22 @@ bool IsMetaDataStreamDictionary(const CPDF_Dictionary* dict) {
          dict->GetNameFor("Subtype") == "XML";
 }
 
+// PDF integers, and thus CPDF_Number, cannot hold the sizes of the largest
+// streams. Leave /Length out for those rather than record a truncated value.
+void SetLengthInDict(CPDF_Dictionary* pDict, size_t size) {
+  if (size > static_cast<size_t>(std::numeric_limits<int>::max())) {
+    pDict->RemoveFor("Length");
+    return;
+  }
+  pDict->SetNewFor<CPDF_Number>("Length", static_cast<int>(size));
+}
+
 }  // namespace
 
 CPDF_Stream::CPDF_Stream() = default;
 
 CPDF_Stream::CPDF_Stream(std::unique_ptr<uint8_t, FxFreeDeleter> pData,
-                         uint32_t size,
+                         size_t size,
                          RetainPtr<CPDF_Dictionary> pDict)
     : m_pDict(std::move(pDict)) {
   TakeData(std::move(pData), size);
@@ -78,11 +89,12 @@ void CPDF_Stream::InitStreamFromFile(
     const RetainPtr<IFX_SeekableReadStream>& pFile,
     RetainPtr<CPDF_Dictionary> pDict) {
   m_bMemoryBased = false;
+  ++m_DataVersion;
   m_pDataBuf.reset();
   m_pFile = pFile;
-  m_dwSize = pdfium::base::checked_cast<uint32_t>(pFile->GetSize());
+  m_RawSize = pdfium::base::checked_cast<size_t>(pFile->GetSize());
   m_pDict = std::move(pDict);
-  m_pDict->SetNewFor<CPDF_Number>("Length", static_cast<int>(m_dwSize));
+  SetLengthInDict(m_pDict.Get(), m_RawSize);
 }
 
 RetainPtr<CPDF_Object> CPDF_Stream::Clone() const {
@@ -96,7 +108,7 @@ RetainPtr<CPDF_Object> CPDF_Stream::CloneNonCyclic(
   auto pAcc = pdfium::MakeRetain<CPDF_StreamAcc>(this);
   pAcc->LoadAllDataRaw();
 
-  uint32_t streamSize = pAcc->GetSize();
+  size_t streamSize = pAcc->GetSize();
   const CPDF_Dictionary* pDict = GetDict();
   RetainPtr<CPDF_Dictionary> pNewDict;
   if (pDict && !pdfium::Contains(*pVisited, pDict)) {
@@ -136,14 +148,15 @@ void CPDF_Stream::SetData(pdfium::span<const uint8_t> pData) {
 }
 
 void CPDF_Stream::TakeData(std::unique_ptr<uint8_t, FxFreeDeleter> pData,
-                           uint32_t size) {
+                           size_t size) {
   m_bMemoryBased = true;
+  ++m_DataVersion;
   m_pFile = nullptr;
   m_pDataBuf = std::move(pData);
-  m_dwSize = size;
+  m_RawSize = size;
   if (!m_pDict)
     m_pDict = pdfium::MakeRetain<CPDF_Dictionary>();
-  m_pDict->SetNewFor<CPDF_Number>("Length", static_cast<int>(size));
+  SetLengthInDict(m_pDict.Get(), size);
 }
 
 void CPDF_Stream::SetDataFromStringstream(std::ostringstream* stream) {
@@ -157,7 +170,7 @@ void CPDF_Stream::SetDataFromStringstream(std::ostringstream* stream) {
 
 bool CPDF_Stream::ReadRawData(FX_FILESIZE offset,
                               uint8_t* buf,
-                              uint32_t size) const {
+                              size_t size) const {
   if (!m_bMemoryBased && m_pFile)
     return m_pFile->ReadBlockAtOffset(buf, offset, size);
 
@@ -167,6 +180,21 @@ bool CPDF_Stream::ReadRawData(FX_FILESIZE offset,
   return true;
 }
 
+pdfium::span<const uint8_t> CPDF_Stream::GetRawSpanFromFile() const {
+  if (m_bMemoryBased || !m_pFile)
+    return {};
+
+  pdfium::span<const uint8_t> span = m_pFile->GetSpan();
+  if (span.size() != m_RawSize)
+    return {};
+  return span;
+}
+
+bool CPDF_Stream::NeedToWaitForRawData() const {
+  return !m_bMemoryBased && m_pFile &&
+         m_pFile->NeedToWaitForData(0, m_RawSize);
+}
+
 bool CPDF_Stream::HasFilter() const {
   return m_pDict && m_pDict->KeyExist("Filter");
 }
@@ -190,7 +218,11 @@ bool CPDF_Stream::WriteTo(IFX_ArchiveStream* archive,
     data = encrypted_data;
   }
 
+  // /Length must be a PDF integer.
   size_t size = data.size();
+  if (size > static_cast<size_t>(std::numeric_limits<int>::max()))
+    return false;
+
   if (static_cast<size_t>(encoder.GetDict()->GetIntegerFor("Length")) != size) {
     encoder.CloneDict();
     encoder.GetClonedDict()->SetNewFor<CPDF_Number>("Length",
@@ -15,6 +15,7 @@
 #include "core/fxcrt/fx_memory_wrappers.h"
 #include "core/fxcrt/fx_stream.h"
 #include "core/fxcrt/retain_ptr.h"
+#include "third_party/base/span.h"
 
 class CPDF_Stream final : public CPDF_Object {
  public:
@@ -34,7 +35,7 @@ class CPDF_Stream final : public CPDF_Object {
   bool WriteTo(IFX_ArchiveStream* archive,
                const CPDF_Encryptor* encryptor) const override;
 
-  uint32_t GetRawSize() const { return m_dwSize; }
+  size_t GetRawSize() const { return m_RawSize; }
   // Will be null in case when stream is not memory based.
   // Use CPDF_StreamAcc to data access in all cases.
   uint8_t* GetInMemoryRawData() const { return m_pDataBuf.get(); }
@@ -42,7 +43,7 @@ class CPDF_Stream final : public CPDF_Object {
   // Copies span into internally-owned buffer.
   void SetData(pdfium::span<const uint8_t> pData);
 
-  void TakeData(std::unique_ptr<uint8_t, FxFreeDeleter> pData, uint32_t size);
+  void TakeData(std::unique_ptr<uint8_t, FxFreeDeleter> pData, size_t size);
 
   void SetDataFromStringstream(std::ostringstream* stream);
 
@@ -56,15 +57,28 @@ class CPDF_Stream final : public CPDF_Object {
   void InitStreamFromFile(const RetainPtr<IFX_SeekableReadStream>& pFile,
                           RetainPtr<CPDF_Dictionary> pDict);
 
-  bool ReadRawData(FX_FILESIZE offset, uint8_t* pBuf, uint32_t buf_size) const;
+  bool ReadRawData(FX_FILESIZE offset, uint8_t* pBuf, size_t buf_size) const;
+
+  // For streams that are not memory based, returns the raw data in place if
+  // the underlying file is directly addressable, e.g. memory-mapped. Returns
+  // an empty span otherwise.
+  pdfium::span<const uint8_t> GetRawSpanFromFile() const;
+
+  // Returns true if the raw data of a stream that is not memory based has
+  // been requested from an asynchronous source, but is not available yet.
+  bool NeedToWaitForRawData() const;
 
   bool IsMemoryBased() const { return m_bMemoryBased; }
   bool HasFilter() const;
 
+  // Changes whenever the stream's data is replaced, so that caches of the
+  // decoded data can tell when they are stale.
+  uint32_t GetDataVersion() const { return m_DataVersion; }
+
  private:
   CPDF_Stream();
   CPDF_Stream(std::unique_ptr<uint8_t, FxFreeDeleter> pData,
-              uint32_t size,
+              size_t size,
               RetainPtr<CPDF_Dictionary> pDict);
   ~CPDF_Stream() override;
 
@@ -73,7 +87,8 @@ class CPDF_Stream final : public CPDF_Object {
       std::set<const CPDF_Object*>* pVisited) const override;
 
   bool m_bMemoryBased = true;
-  uint32_t m_dwSize = 0;
+  uint32_t m_DataVersion = 0;
+  size_t m_RawSize = 0;
   RetainPtr<CPDF_Dictionary> m_pDict;
   std::unique_ptr<uint8_t, FxFreeDeleter> m_pDataBuf;
   RetainPtr<IFX_SeekableReadStream> m_pFile;
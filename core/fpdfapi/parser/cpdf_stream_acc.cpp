@@ -6,6 +6,8 @@
 
 #include "core/fpdfapi/parser/cpdf_stream_acc.h"
 
+#include <algorithm>
+#include <limits>
 #include <utility>
 #include <vector>
 
@@ -13,8 +15,55 @@
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
 #include "core/fpdfapi/parser/cpdf_stream.h"
 #include "core/fpdfapi/parser/fpdf_parser_decode.h"
+#include "core/fxcodec/chunked_decoder.h"
 #include "third_party/base/check.h"
 
+namespace {
+
+// Reads the raw data of a stream, in place if it is in memory or in a mapped
+// file, and through the file otherwise.
+class RawStreamChunkedDecoder final : public fxcodec::ChunkedDecoder {
+ public:
+  explicit RawStreamChunkedDecoder(RetainPtr<const CPDF_Stream> pStream)
+      : m_pStream(std::move(pStream)),
+        m_dwRemaining(m_pStream->GetRawSize()) {
+    if (m_pStream->IsMemoryBased())
+      m_RawSpan = {m_pStream->GetInMemoryRawData(), m_dwRemaining};
+    else
+      m_RawSpan = m_pStream->GetRawSpanFromFile();
+  }
+  ~RawStreamChunkedDecoder() override = default;
+
+  // fxcodec::ChunkedDecoder:
+  size_t Read(pdfium::span<uint8_t> dest) override {
+    size_t size = std::min(dest.size(), m_dwRemaining);
+    if (size == 0)
+      return 0;
+
+    if (!m_RawSpan.empty()) {
+      memcpy(dest.data(), m_RawSpan.data() + m_dwOffset, size);
+    } else if (!m_pStream->ReadRawData(m_dwOffset, dest.data(), size)) {
+      m_bError = true;
+      m_dwRemaining = 0;
+      return 0;
+    }
+    m_dwOffset += size;
+    m_dwRemaining -= size;
+    return size;
+  }
+
+  bool HasError() const override { return m_bError; }
+
+ private:
+  RetainPtr<const CPDF_Stream> const m_pStream;
+  pdfium::span<const uint8_t> m_RawSpan;
+  size_t m_dwOffset = 0;
+  size_t m_dwRemaining;
+  bool m_bError = false;
+};
+
+}  // namespace
+
 CPDF_StreamAcc::CPDF_StreamAcc(const CPDF_Stream* pStream)
     : m_pStream(pStream) {}
 
@@ -65,7 +114,7 @@ uint8_t* CPDF_StreamAcc::GetData() const {
   return m_pStream ? m_pStream->GetInMemoryRawData() : nullptr;
 }
 
-uint32_t CPDF_StreamAcc::GetSize() const {
+size_t CPDF_StreamAcc::GetSize() const {
   if (m_pData.IsOwned())
     return m_dwSize;
   return (m_pStream && m_pStream->IsMemoryBased()) ? m_pStream->GetRawSize()
@@ -82,7 +131,17 @@ pdfium::span<const uint8_t> CPDF_StreamAcc::GetSpan() const {
 
 ByteString CPDF_StreamAcc::ComputeDigest() const {
   uint8_t digest[20];
-  CRYPT_SHA1Generate(GetData(), GetSize(), digest);
+  CRYPT_sha1_context context;
+  CRYPT_SHA1Start(&context);
+  pdfium::span<const uint8_t> remaining = GetSpan();
+  while (!remaining.empty()) {
+    // CRYPT_SHA1Update() takes 32-bit sizes.
+    const size_t chunk_size = std::min<size_t>(
+        remaining.size(), std::numeric_limits<uint32_t>::max());
+    CRYPT_SHA1Update(&context, remaining.data(), chunk_size);
+    remaining = remaining.subspan(chunk_size);
+  }
+  CRYPT_SHA1Finish(&context, digest);
   return ByteString(digest, 20);
 }
 
@@ -97,8 +156,22 @@ std::unique_ptr<uint8_t, FxFreeDeleter> CPDF_StreamAcc::DetachData() {
   return p;
 }
 
+std::unique_ptr<fxcodec::ChunkedDecoder>
+CPDF_StreamAcc::CreateFilteredDecoder() const {
+  if (!m_pStream)
+    return nullptr;
+
+  Optional<DecoderArray> decoder_array = GetDecoderArray(m_pStream->GetDict());
+  if (!decoder_array.has_value())
+    return nullptr;
+
+  return CreateChunkedDataDecoder(
+      std::make_unique<RawStreamChunkedDecoder>(m_pStream),
+      decoder_array.value());
+}
+
 void CPDF_StreamAcc::ProcessRawData() {
-  uint32_t dwSrcSize = m_pStream->GetRawSize();
+  size_t dwSrcSize = m_pStream->GetRawSize();
   if (dwSrcSize == 0)
     return;
 
@@ -118,50 +191,69 @@ void CPDF_StreamAcc::ProcessRawData() {
 
 void CPDF_StreamAcc::ProcessFilteredData(uint32_t estimated_size,
                                          bool bImageAcc) {
-  uint32_t dwSrcSize = m_pStream->GetRawSize();
+  size_t dwSrcSize = m_pStream->GetRawSize();
   if (dwSrcSize == 0)
     return;
 
+  // Decode straight out of the file when it is directly addressable, and
+  // only copy the raw data if it turns out to be needed undecoded.
   MaybeOwned<uint8_t, FxFreeDeleter> pSrcData;
+  pdfium::span<const uint8_t> src_span;
   if (m_pStream->IsMemoryBased()) {
     pSrcData = m_pStream->GetInMemoryRawData();
+    src_span = {pSrcData.Get(), dwSrcSize};
   } else {
-    std::unique_ptr<uint8_t, FxFreeDeleter> pTempSrcData = ReadRawStream();
-    if (!pTempSrcData)
-      return;
-
-    pSrcData = std::move(pTempSrcData);
+    src_span = m_pStream->GetRawSpanFromFile();
+    if (src_span.empty()) {
+      std::unique_ptr<uint8_t, FxFreeDeleter> pTempSrcData = ReadRawStream();
+      if (!pTempSrcData)
+        return;
+
+      pSrcData = std::move(pTempSrcData);
+      src_span = {pSrcData.Get(), dwSrcSize};
+    }
   }
 
   std::unique_ptr<uint8_t, FxFreeDeleter> pDecodedData;
-  uint32_t dwDecodedSize = 0;
+  size_t dwDecodedSize = 0;
 
   Optional<std::vector<std::pair<ByteString, const CPDF_Object*>>>
       decoder_array = GetDecoderArray(m_pStream->GetDict());
   if (!decoder_array.has_value() || decoder_array.value().empty() ||
-      !PDF_DataDecode({pSrcData.Get(), dwSrcSize}, estimated_size, bImageAcc,
+      !PDF_DataDecode(src_span, estimated_size, bImageAcc,
                       decoder_array.value(), &pDecodedData, &dwDecodedSize,
                       &m_ImageDecoder, &m_pImageParam)) {
-    m_pData = std::move(pSrcData);
-    m_dwSize = dwSrcSize;
+    TakeSrcData(std::move(pSrcData), src_span);
     return;
   }
 
   if (pDecodedData) {
-    DCHECK(pDecodedData.get() != pSrcData.Get());
+    DCHECK(pDecodedData.get() != src_span.data());
     m_pData = std::move(pDecodedData);
     m_dwSize = dwDecodedSize;
   } else {
-    m_pData = std::move(pSrcData);
-    m_dwSize = dwSrcSize;
+    TakeSrcData(std::move(pSrcData), src_span);
+  }
+}
+
+void CPDF_StreamAcc::TakeSrcData(MaybeOwned<uint8_t, FxFreeDeleter> pSrcData,
+                                 pdfium::span<const uint8_t> src_span) {
+  if (!m_pStream->IsMemoryBased() && !pSrcData.IsOwned()) {
+    // |src_span| points into the file, which the accessor must not expose as
+    // writable data, so take a copy.
+    pSrcData = std::unique_ptr<uint8_t, FxFreeDeleter>(
+        FX_AllocUninit(uint8_t, src_span.size()));
+    memcpy(pSrcData.Get(), src_span.data(), src_span.size());
   }
+  m_pData = std::move(pSrcData);
+  m_dwSize = src_span.size();
 }
 
 std::unique_ptr<uint8_t, FxFreeDeleter> CPDF_StreamAcc::ReadRawStream() const {
   DCHECK(m_pStream);
   DCHECK(!m_pStream->IsMemoryBased());
 
-  uint32_t dwSrcSize = m_pStream->GetRawSize();
+  size_t dwSrcSize = m_pStream->GetRawSize();
   DCHECK(dwSrcSize);
   std::unique_ptr<uint8_t, FxFreeDeleter> pSrcData(
       FX_Alloc(uint8_t, dwSrcSize));
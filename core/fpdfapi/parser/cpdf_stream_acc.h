@@ -19,6 +19,10 @@
 class CPDF_Dictionary;
 class CPDF_Stream;
 
+namespace fxcodec {
+class ChunkedDecoder;
+}
+
 class CPDF_StreamAcc final : public Retainable {
  public:
   CONSTRUCT_VIA_MAKE_RETAIN;
@@ -35,7 +39,7 @@ class CPDF_StreamAcc final : public Retainable {
   const CPDF_Dictionary* GetDict() const;
 
   uint8_t* GetData() const;
-  uint32_t GetSize() const;
+  size_t GetSize() const;
   pdfium::span<uint8_t> GetSpan();
   pdfium::span<const uint8_t> GetSpan() const;
   ByteString ComputeDigest() const;
@@ -43,6 +47,12 @@ class CPDF_StreamAcc final : public Retainable {
   const CPDF_Dictionary* GetImageParam() const { return m_pImageParam.Get(); }
   std::unique_ptr<uint8_t, FxFreeDeleter> DetachData();
 
+  // Returns a decoder that produces the same data as LoadAllDataFiltered()
+  // one chunk at a time, without loading it into the accessor. Returns nullptr
+  // if the filters cannot be applied that way, e.g. for images. If the decoder
+  // reports an error, LoadAllDataFiltered() falls back to the raw data.
+  std::unique_ptr<fxcodec::ChunkedDecoder> CreateFilteredDecoder() const;
+
  private:
   explicit CPDF_StreamAcc(const CPDF_Stream* pStream);
   ~CPDF_StreamAcc() override;
@@ -50,12 +60,17 @@ class CPDF_StreamAcc final : public Retainable {
   void LoadAllData(bool bRawAccess, uint32_t estimated_size, bool bImageAcc);
   void ProcessRawData();
   void ProcessFilteredData(uint32_t estimated_size, bool bImageAcc);
+  // Makes the undecoded |src_span| the accessor's data. |pSrcData| owns or
+  // points to it, unless it lives in the stream's file, in which case it is
+  // copied.
+  void TakeSrcData(MaybeOwned<uint8_t, FxFreeDeleter> pSrcData,
+                   pdfium::span<const uint8_t> src_span);
 
   // Reads the raw data from |m_pStream|, or return nullptr on failure.
   std::unique_ptr<uint8_t, FxFreeDeleter> ReadRawStream() const;
 
   MaybeOwned<uint8_t, FxFreeDeleter> m_pData;
-  uint32_t m_dwSize = 0;
+  size_t m_dwSize = 0;
   ByteString m_ImageDecoder;
   RetainPtr<const CPDF_Dictionary> m_pImageParam;
   RetainPtr<const CPDF_Stream> const m_pStream;
@@ -6,6 +6,8 @@
 
 #include "core/fpdfapi/parser/cpdf_syntax_parser.h"
 
+#include <string.h>
+
 #include <algorithm>
 #include <sstream>
 #include <utility>
@@ -66,16 +68,57 @@ class ReadableSubStream final : public IFX_SeekableReadStream {
 
   FX_FILESIZE GetSize() override { return m_PartSize; }
 
+  bool NeedToWaitForData(FX_FILESIZE offset, size_t size) override {
+    FX_SAFE_FILESIZE safe_end = offset;
+    safe_end += size;
+    if (!safe_end.IsValid() || safe_end.ValueOrDie() > m_PartSize)
+      return false;
+
+    return m_pFileRead->NeedToWaitForData(m_PartOffset + offset, size);
+  }
+
+  pdfium::span<const uint8_t> GetSpan() override {
+    pdfium::span<const uint8_t> span = m_pFileRead->GetSpan();
+    FX_SAFE_SIZE_T safe_end = m_PartOffset;
+    safe_end += m_PartSize;
+    if (span.empty() || !safe_end.IsValid() ||
+        safe_end.ValueOrDie() > span.size()) {
+      return {};
+    }
+    return span.subspan(m_PartOffset, m_PartSize);
+  }
+
  private:
   RetainPtr<IFX_SeekableReadStream> m_pFileRead;
   FX_FILESIZE m_PartOffset;
   FX_FILESIZE m_PartSize;
 };
 
+// Returns the first occurrence of |tag| in |buf|, or nullptr. memchr() skips
+// ahead to candidate positions far faster than a byte-by-byte match.
+const uint8_t* FindTagInBuffer(pdfium::span<const uint8_t> buf,
+                               ByteStringView tag) {
+  const size_t taglen = tag.GetLength();
+  if (buf.size() < taglen)
+    return nullptr;
+
+  const uint8_t* pos = buf.data();
+  const uint8_t* const last = buf.data() + buf.size() - taglen;
+  while (pos <= last) {
+    pos = static_cast<const uint8_t*>(memchr(pos, tag[0], last - pos + 1));
+    if (!pos)
+      return nullptr;
+    if (memcmp(pos + 1, tag.raw_str() + 1, taglen - 1) == 0)
+      return pos;
+    ++pos;
+  }
+  return nullptr;
+}
+
 }  // namespace
 
 // static
-int CPDF_SyntaxParser::s_CurrentRecursionDepth = 0;
+thread_local int CPDF_SyntaxParser::s_CurrentRecursionDepth = 0;
 
 // static
 std::unique_ptr<CPDF_SyntaxParser> CPDF_SyntaxParser::CreateForTesting(
@@ -110,7 +153,7 @@ bool CPDF_SyntaxParser::GetCharAt(FX_FILESIZE pos, uint8_t& ch) {
 }
 
 bool CPDF_SyntaxParser::ReadBlockAt(FX_FILESIZE read_pos) {
-  if (read_pos >= m_FileLen)
+  if (read_pos < 0 || read_pos >= m_FileLen)
     return false;
   size_t read_size = m_ReadBufferSize;
   FX_SAFE_FILESIZE safe_end = read_pos;
@@ -118,17 +161,47 @@ bool CPDF_SyntaxParser::ReadBlockAt(FX_FILESIZE read_pos) {
   if (!safe_end.IsValid() || safe_end.ValueOrDie() > m_FileLen)
     read_size = m_FileLen - read_pos;
 
+  // When the whole file is addressable, e.g. because it is memory-mapped,
+  // use it as the buffer instead of copying it block by block.
+  pdfium::span<const uint8_t> file_span = m_pFileAccess->GetSpan();
+  if (!file_span.empty()) {
+    m_pFileBuf.clear();
+    m_BufSpan = file_span;
+    m_BufOffset = 0;
+    return true;
+  }
+
   m_pFileBuf.resize(read_size);
   if (!m_pFileAccess->ReadBlockAtOffset(m_pFileBuf.data(), read_pos,
                                         read_size)) {
     m_pFileBuf.clear();
+    m_BufSpan = {};
     return false;
   }
 
+  m_BufSpan = m_pFileBuf;
   m_BufOffset = read_pos;
   return true;
 }
 
+template <typename Predicate>
+bool CPDF_SyntaxParser::SkipWhile(Predicate pred) {
+  while (1) {
+    const FX_FILESIZE pos = m_Pos + m_HeaderOffset;
+    if (pos >= m_FileLen)
+      return false;
+
+    if (!IsPositionRead(pos) && !ReadBlockAt(pos))
+      return false;
+
+    pdfium::span<const uint8_t> buf = m_BufSpan.subspan(pos - m_BufOffset);
+    const uint8_t* it = std::find_if_not(buf.begin(), buf.end(), pred);
+    m_Pos += it - buf.begin();
+    if (it != buf.end())
+      return true;
+  }
+}
+
 bool CPDF_SyntaxParser::GetNextChar(uint8_t& ch) {
   FX_FILESIZE pos = m_Pos + m_HeaderOffset;
   if (pos >= m_FileLen)
@@ -137,7 +210,7 @@ bool CPDF_SyntaxParser::GetNextChar(uint8_t& ch) {
   if (!IsPositionRead(pos) && !ReadBlockAt(pos))
     return false;
 
-  ch = m_pFileBuf[pos - m_BufOffset];
+  ch = m_BufSpan[pos - m_BufOffset];
   m_Pos++;
   return true;
 }
@@ -158,7 +231,7 @@ bool CPDF_SyntaxParser::GetCharAtBackward(FX_FILESIZE pos, uint8_t* ch) {
     if (!ReadBlockAt(block_start) || !IsPositionRead(pos))
       return false;
   }
-  *ch = m_pFileBuf[pos - m_BufOffset];
+  *ch = m_BufSpan[pos - m_BufOffset];
   return true;
 }
 
@@ -185,18 +258,13 @@ void CPDF_SyntaxParser::GetNextWordInternal(bool* bIsNumber) {
 
     m_WordBuffer[m_WordSize++] = ch;
     if (ch == '/') {
-      while (1) {
-        if (!GetNextChar(ch))
-          return;
-
-        if (!PDFCharIsOther(ch) && !PDFCharIsNumeric(ch)) {
-          m_Pos--;
-          return;
-        }
-
+      SkipWhile([this](uint8_t c) {
+        if (!PDFCharIsOther(c) && !PDFCharIsNumeric(c))
+          return false;
         if (m_WordSize < sizeof(m_WordBuffer) - 1)
-          m_WordBuffer[m_WordSize++] = ch;
-      }
+          m_WordBuffer[m_WordSize++] = c;
+        return true;
+      });
     } else if (ch == '<') {
       if (!GetNextChar(ch))
         return;
@@ -217,23 +285,22 @@ void CPDF_SyntaxParser::GetNextWordInternal(bool* bIsNumber) {
     return;
   }
 
-  while (1) {
+  auto append_word_char = [this, bIsNumber](uint8_t c) {
     if (m_WordSize < sizeof(m_WordBuffer) - 1)
-      m_WordBuffer[m_WordSize++] = ch;
+      m_WordBuffer[m_WordSize++] = c;
 
-    if (!PDFCharIsNumeric(ch)) {
+    if (!PDFCharIsNumeric(c)) {
       if (bIsNumber)
         *bIsNumber = false;
     }
-
-    if (!GetNextChar(ch))
-      return;
-
-    if (PDFCharIsDelimiter(ch) || PDFCharIsWhitespace(ch)) {
-      m_Pos--;
-      break;
-    }
-  }
+  };
+  append_word_char(ch);
+  SkipWhile([&append_word_char](uint8_t c) {
+    if (PDFCharIsDelimiter(c) || PDFCharIsWhitespace(c))
+      return false;
+    append_word_char(c);
+    return true;
+  });
 }
 
 ByteString CPDF_SyntaxParser::ReadString() {
@@ -376,27 +443,24 @@ void CPDF_SyntaxParser::ToNextWord() {
     return;
   }
 
-  uint8_t ch;
-  if (!GetNextChar(ch))
-    return;
-
   while (1) {
-    while (PDFCharIsWhitespace(ch)) {
-      if (!GetNextChar(ch))
-        return;
-    }
+    if (!SkipWhile([](uint8_t c) { return PDFCharIsWhitespace(c); }))
+      return;
 
-    if (ch != '%')
-      break;
+    uint8_t ch;
+    if (!GetNextChar(ch))
+      return;
 
-    while (1) {
-      if (!GetNextChar(ch))
-        return;
-      if (PDFCharIsLineEnding(ch))
-        break;
+    if (ch != '%') {
+      m_Pos--;
+      return;
     }
+
+    // Skip the comment, including the line ending that terminates it.
+    if (!SkipWhile([](uint8_t c) { return !PDFCharIsLineEnding(c); }))
+      return;
+    m_Pos++;
   }
-  m_Pos--;
 }
 
 // A state machine which goes % -> E -> O -> F -> line ending.
@@ -465,12 +529,15 @@ void CPDF_SyntaxParser::RecordingToNextWord() {
 }
 
 ByteString CPDF_SyntaxParser::GetNextWord(bool* bIsNumber) {
+  return ByteString(GetNextWordView(bIsNumber));
+}
+
+ByteStringView CPDF_SyntaxParser::GetNextWordView(bool* bIsNumber) {
   CPDF_ReadValidator::ScopedSession read_session(GetValidator());
   GetNextWordInternal(bIsNumber);
-  ByteString ret;
-  if (!GetValidator()->has_read_problems())
-    ret = ByteString(m_WordBuffer, m_WordSize);
-  return ret;
+  if (GetValidator()->has_read_problems())
+    return ByteStringView();
+  return ByteStringView(m_WordBuffer, m_WordSize);
 }
 
 ByteString CPDF_SyntaxParser::PeekNextWord(bool* bIsNumber) {
@@ -504,22 +571,23 @@ RetainPtr<CPDF_Object> CPDF_SyntaxParser::GetObjectBodyInternal(
 
   FX_FILESIZE SavedObjPos = m_Pos;
   bool bIsNumber;
-  ByteString word = GetNextWord(&bIsNumber);
+  // Views into |m_WordBuffer|, so |word| must not be used after reading on.
+  ByteStringView word = GetNextWordView(&bIsNumber);
   if (word.IsEmpty())
     return nullptr;
 
   if (bIsNumber) {
+    const ByteString number(word);
     AutoRestorer<FX_FILESIZE> pos_restorer(&m_Pos);
-    ByteString nextword = GetNextWord(&bIsNumber);
+    GetNextWordView(&bIsNumber);
     if (!bIsNumber)
-      return pdfium::MakeRetain<CPDF_Number>(word.AsStringView());
+      return pdfium::MakeRetain<CPDF_Number>(number.AsStringView());
 
-    ByteString nextword2 = GetNextWord(nullptr);
-    if (nextword2 != "R")
-      return pdfium::MakeRetain<CPDF_Number>(word.AsStringView());
+    if (GetNextWordView(nullptr) != "R")
+      return pdfium::MakeRetain<CPDF_Number>(number.AsStringView());
 
     pos_restorer.AbandonRestoration();
-    uint32_t refnum = FXSYS_atoui(word.c_str());
+    uint32_t refnum = FXSYS_atoui(number.c_str());
     if (refnum == CPDF_Object::kInvalidObjNum)
       return nullptr;
 
@@ -559,7 +627,7 @@ RetainPtr<CPDF_Object> CPDF_SyntaxParser::GetObjectBodyInternal(
     RetainPtr<CPDF_Dictionary> pDict =
         pdfium::MakeRetain<CPDF_Dictionary>(m_pPool);
     while (1) {
-      ByteString inner_word = GetNextWord(nullptr);
+      ByteStringView inner_word = GetNextWordView(nullptr);
       if (inner_word.IsEmpty())
         return nullptr;
 
@@ -574,7 +642,7 @@ RetainPtr<CPDF_Object> CPDF_SyntaxParser::GetObjectBodyInternal(
       if (inner_word[0] != '/')
         continue;
 
-      ByteString key = PDF_NameDecode(inner_word.AsStringView());
+      ByteString key = PDF_NameDecode(inner_word);
       if (key.IsEmpty() && parse_type == ParseType::kLoose)
         continue;
 
@@ -595,7 +663,7 @@ RetainPtr<CPDF_Object> CPDF_SyntaxParser::GetObjectBodyInternal(
     }
 
     AutoRestorer<FX_FILESIZE> pos_restorer(&m_Pos);
-    if (GetNextWord(nullptr) != "stream")
+    if (GetNextWordView(nullptr) != "stream")
       return pDict;
     pos_restorer.AbandonRestoration();
     return ReadStream(std::move(pDict));
@@ -784,6 +852,11 @@ RetainPtr<CPDF_Stream> CPDF_SyntaxParser::ReadStream(
     }
   }
 
+  // Streams hold their size as size_t, which may be narrower than the file
+  // offsets on 32-bit platforms.
+  if (!pdfium::base::IsValueInRangeForNumericType<size_t>(len))
+    return nullptr;
+
   auto pStream = pdfium::MakeRetain<CPDF_Stream>();
   if (data) {
     pStream->InitStreamFromFile(data, std::move(pDict));
@@ -889,6 +962,41 @@ FX_FILESIZE CPDF_SyntaxParser::FindTag(ByteStringView tag) {
   const int32_t taglen = tag.GetLength();
   DCHECK(taglen > 0);
 
+  // Search the read buffer directly, as long as a freshly read block can
+  // hold the whole tag.
+  if (static_cast<uint32_t>(taglen) <= m_ReadBufferSize) {
+    while (1) {
+      const FX_FILESIZE pos = m_Pos + m_HeaderOffset;
+      if (pos >= m_FileLen)
+        return -1;
+
+      if (!IsPositionRead(pos) && !ReadBlockAt(pos))
+        return -1;
+
+      pdfium::span<const uint8_t> buf = m_BufSpan.subspan(pos - m_BufOffset);
+      const uint8_t* found = FindTagInBuffer(buf, tag);
+      if (found) {
+        m_Pos += found - buf.data() + taglen;
+        return GetPos() - startpos - taglen;
+      }
+
+      if (m_BufOffset + static_cast<FX_FILESIZE>(m_BufSpan.size()) >=
+          m_FileLen) {
+        m_Pos = m_FileLen - m_HeaderOffset;
+        return -1;
+      }
+
+      // Move past every position that was fully checked. The remaining tail
+      // is shorter than |tag|, so start a new block there, which makes a
+      // match straddling the block boundary visible.
+      if (buf.size() >= static_cast<size_t>(taglen)) {
+        m_Pos += buf.size() - taglen + 1;
+      } else if (!ReadBlockAt(pos)) {
+        return -1;
+      }
+    }
+  }
+
   int32_t match = 0;
   while (1) {
     uint8_t ch;
@@ -908,5 +1016,5 @@ FX_FILESIZE CPDF_SyntaxParser::FindTag(ByteStringView tag) {
 
 bool CPDF_SyntaxParser::IsPositionRead(FX_FILESIZE pos) const {
   return m_BufOffset <= pos &&
-         pos < static_cast<FX_FILESIZE>(m_BufOffset + m_pFileBuf.size());
+         pos < static_cast<FX_FILESIZE>(m_BufOffset + m_BufSpan.size());
 }
@@ -17,6 +17,7 @@
 #include "core/fxcrt/string_pool_template.h"
 #include "core/fxcrt/unowned_ptr.h"
 #include "core/fxcrt/weak_ptr.h"
+#include "third_party/base/span.h"
 
 class CPDF_CryptoHandler;
 class CPDF_Dictionary;
@@ -89,11 +90,23 @@ class CPDF_SyntaxParser {
   friend class cpdf_syntax_parser_ReadHexString_Test;
 
   static constexpr int kParserMaxRecursionDepth = 64;
-  static int s_CurrentRecursionDepth;
+
+  // Shared by all parsers on the current thread, since parsing an object can
+  // re-enter a different parser (e.g. for object streams). Thread-local so
+  // that independent documents may be parsed on different threads.
+  static thread_local int s_CurrentRecursionDepth;
 
   bool ReadBlockAt(FX_FILESIZE read_pos);
+  // Advances past the bytes for which |pred| holds, scanning the read buffer
+  // directly rather than a byte at a time. Returns false at the end of file.
+  template <typename Predicate>
+  bool SkipWhile(Predicate pred);
   bool GetCharAtBackward(FX_FILESIZE pos, uint8_t* ch);
   void GetNextWordInternal(bool* bIsNumber);
+  // Like GetNextWord(), but returns a view of |m_WordBuffer| that is only
+  // valid until the next read, so callers that merely compare the word need
+  // not allocate.
+  ByteStringView GetNextWordView(bool* bIsNumber);
   bool IsWholeWord(FX_FILESIZE startpos,
                    FX_FILESIZE limit,
                    ByteStringView tag,
@@ -119,6 +132,8 @@ class CPDF_SyntaxParser {
   FX_FILESIZE m_Pos = 0;
   WeakPtr<ByteStringPool> m_pPool;
   std::vector<uint8_t, FxAllocAllocator<uint8_t>> m_pFileBuf;
+  // Either |m_pFileBuf| or, when it is directly addressable, the whole file.
+  pdfium::span<const uint8_t> m_BufSpan;
   FX_FILESIZE m_BufOffset = 0;
   uint32_t m_WordSize = 0;
   uint8_t m_WordBuffer[257];
@@ -3,15 +3,43 @@
 // found in the LICENSE file.
 
 #include <limits>
+#include <string>
 
 #include "core/fpdfapi/parser/cpdf_object.h"
 #include "core/fpdfapi/parser/cpdf_parser.h"
+#include "core/fpdfapi/parser/cpdf_stream.h"
 #include "core/fpdfapi/parser/cpdf_syntax_parser.h"
 #include "core/fxcrt/cfx_readonlymemorystream.h"
 #include "core/fxcrt/fx_extension.h"
 #include "testing/gtest/include/gtest/gtest.h"
 #include "testing/utils/path_service.h"
 
+namespace {
+
+// Serves reads from memory without exposing the data as a span, so the
+// parser has to read it block by block, as it does for regular files.
+class BlockReadStream final : public IFX_SeekableReadStream {
+ public:
+  CONSTRUCT_VIA_MAKE_RETAIN;
+
+  // IFX_SeekableReadStream:
+  FX_FILESIZE GetSize() override { return m_pStream->GetSize(); }
+  bool ReadBlockAtOffset(void* buffer,
+                         FX_FILESIZE offset,
+                         size_t size) override {
+    return m_pStream->ReadBlockAtOffset(buffer, offset, size);
+  }
+
+ private:
+  explicit BlockReadStream(pdfium::span<const uint8_t> data)
+      : m_pStream(pdfium::MakeRetain<CFX_ReadOnlyMemoryStream>(data)) {}
+  ~BlockReadStream() override = default;
+
+  RetainPtr<CFX_ReadOnlyMemoryStream> const m_pStream;
+};
+
+}  // namespace
+
 TEST(cpdf_syntax_parser, ReadHexString) {
   {
     // Empty string.
@@ -159,3 +187,43 @@ TEST(cpdf_syntax_parser, PeekNextWord) {
   EXPECT_EQ("WORD", parser.PeekNextWord(nullptr));
   EXPECT_EQ("WORD", parser.GetNextWord(nullptr));
 }
+
+TEST(cpdf_syntax_parser, ToNextWordSkipsWhitespaceAndComments) {
+  static const uint8_t data[] = " \r\n%comment\r\n\t% another\n  word";
+  CPDF_SyntaxParser parser(pdfium::MakeRetain<CFX_ReadOnlyMemoryStream>(
+      pdfium::make_span(data, sizeof(data) - 1)));
+  parser.ToNextWord();
+  EXPECT_EQ(static_cast<FX_FILESIZE>(sizeof(data) - 5), parser.GetPos());
+  EXPECT_EQ("word", parser.GetNextWord(nullptr));
+
+  // Stops at the end of the file in the middle of a comment.
+  static const uint8_t comment[] = "  % unterminated";
+  CPDF_SyntaxParser comment_parser(
+      pdfium::MakeRetain<CFX_ReadOnlyMemoryStream>(
+          pdfium::make_span(comment, sizeof(comment) - 1)));
+  comment_parser.ToNextWord();
+  EXPECT_EQ(static_cast<FX_FILESIZE>(sizeof(comment) - 1),
+            comment_parser.GetPos());
+}
+
+TEST(cpdf_syntax_parser, FindTagAcrossReadBlocks) {
+  // Place the tag so that it straddles a read block boundary, for both
+  // in-memory data and a stream that must be read block by block.
+  std::string data(CPDF_Stream::kFileBufSize * 3, 'x');
+  data.replace(CPDF_Stream::kFileBufSize * 2 - 4, 9, "endstream");
+  pdfium::span<const uint8_t> span(
+      reinterpret_cast<const uint8_t*>(data.data()), data.size());
+  const FX_FILESIZE expected = CPDF_Stream::kFileBufSize * 2 - 4;
+
+  RetainPtr<IFX_SeekableReadStream> streams[] = {
+      pdfium::MakeRetain<CFX_ReadOnlyMemoryStream>(span),
+      pdfium::MakeRetain<BlockReadStream>(span)};
+  for (const auto& stream : streams) {
+    CPDF_SyntaxParser parser(stream);
+    parser.SetPos(10);
+    EXPECT_EQ(expected - 10, parser.FindTag("endstream"));
+    EXPECT_EQ(expected + 9, parser.GetPos());
+    EXPECT_EQ(-1, parser.FindTag("endstream"));
+    EXPECT_EQ(static_cast<FX_FILESIZE>(data.size()), parser.GetPos());
+  }
+}
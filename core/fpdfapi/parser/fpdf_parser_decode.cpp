@@ -17,6 +17,7 @@
 #include "core/fpdfapi/parser/cpdf_array.h"
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
 #include "core/fpdfapi/parser/fpdf_parser_utility.h"
+#include "core/fxcodec/chunked_decoder.h"
 #include "core/fxcodec/fax/faxmodule.h"
 #include "core/fxcodec/flate/flatemodule.h"
 #include "core/fxcodec/fx_codec.h"
@@ -55,6 +56,209 @@ uint8_t GetA85Result(uint32_t res, size_t i) {
   return static_cast<uint8_t>(res >> (3 - i) * 8);
 }
 
+// Base class for the decoders below, which produce at most a few bytes of
+// output at a time.
+class SmallOutputChunkedDecoder : public fxcodec::FilterChunkedDecoder {
+ public:
+  ~SmallOutputChunkedDecoder() override = default;
+
+  // fxcodec::ChunkedDecoder:
+  size_t Read(pdfium::span<uint8_t> dest) override {
+    size_t written = 0;
+    while (written < dest.size()) {
+      if (output_pos_ < output_size_) {
+        dest[written++] = output_[output_pos_++];
+        continue;
+      }
+      if (ended_)
+        break;
+      output_pos_ = 0;
+      output_size_ = 0;
+      DecodeNext();
+    }
+    return written;
+  }
+
+ protected:
+  explicit SmallOutputChunkedDecoder(
+      std::unique_ptr<fxcodec::ChunkedDecoder> source)
+      : fxcodec::FilterChunkedDecoder(std::move(source)) {}
+
+  // Consumes input, appending any output with Output(), or sets |ended_|.
+  virtual void DecodeNext() = 0;
+
+  void Output(uint8_t byte) { output_[output_size_++] = byte; }
+
+  bool ended_ = false;
+
+ private:
+  uint8_t output_[4];
+  size_t output_pos_ = 0;
+  size_t output_size_ = 0;
+};
+
+// Produces the same output as A85Decode().
+class A85ChunkedDecoder final : public SmallOutputChunkedDecoder {
+ public:
+  explicit A85ChunkedDecoder(std::unique_ptr<fxcodec::ChunkedDecoder> source)
+      : SmallOutputChunkedDecoder(std::move(source)) {}
+  ~A85ChunkedDecoder() override = default;
+
+ private:
+  // SmallOutputChunkedDecoder:
+  void DecodeNext() override {
+    uint8_t ch;
+    if (!ReadInputByte(&ch)) {
+      End();
+      return;
+    }
+    if (PDFCharIsLineEnding(ch) || ch == ' ' || ch == '\t')
+      return;
+
+    if (ch == 'z') {
+      for (size_t i = 0; i < 4; ++i)
+        Output(0);
+      state_ = 0;
+      res_ = 0;
+      return;
+    }
+
+    // Check for the end or illegal character.
+    if (ch < '!' || ch > 'u') {
+      End();
+      return;
+    }
+
+    res_ = res_ * 85 + ch - 33;
+    if (state_ < 4) {
+      ++state_;
+      return;
+    }
+
+    for (size_t i = 0; i < 4; ++i)
+      Output(GetA85Result(res_, i));
+    state_ = 0;
+    res_ = 0;
+  }
+
+  void End() {
+    ended_ = true;
+    // Handle partial group.
+    if (!state_)
+      return;
+    for (size_t i = state_; i < 5; ++i)
+      res_ = res_ * 85 + 84;
+    for (size_t i = 0; i < state_ - 1; ++i)
+      Output(GetA85Result(res_, i));
+  }
+
+  size_t state_ = 0;
+  uint32_t res_ = 0;
+};
+
+// Produces the same output as HexDecode().
+class HexChunkedDecoder final : public SmallOutputChunkedDecoder {
+ public:
+  explicit HexChunkedDecoder(std::unique_ptr<fxcodec::ChunkedDecoder> source)
+      : SmallOutputChunkedDecoder(std::move(source)) {}
+  ~HexChunkedDecoder() override = default;
+
+ private:
+  // SmallOutputChunkedDecoder:
+  void DecodeNext() override {
+    uint8_t ch;
+    if (!ReadInputByte(&ch) || ch == '>') {
+      ended_ = true;
+      if (!bFirst_)
+        Output(pending_);
+      return;
+    }
+    if (!std::isxdigit(ch))
+      return;
+
+    int digit = FXSYS_HexCharToInt(ch);
+    if (bFirst_)
+      pending_ = digit * 16;
+    else
+      Output(pending_ + digit);
+    bFirst_ = !bFirst_;
+  }
+
+  bool bFirst_ = true;
+  uint8_t pending_ = 0;
+};
+
+// Produces the same output as RunLengthDecode(), and fails the same way once
+// the output reaches kMaxStreamSize.
+class RunLengthChunkedDecoder final : public fxcodec::FilterChunkedDecoder {
+ public:
+  explicit RunLengthChunkedDecoder(
+      std::unique_ptr<fxcodec::ChunkedDecoder> source)
+      : fxcodec::FilterChunkedDecoder(std::move(source)) {}
+  ~RunLengthChunkedDecoder() override = default;
+
+  // fxcodec::ChunkedDecoder:
+  size_t Read(pdfium::span<uint8_t> dest) override {
+    // Never write past kMaxStreamSize, so reaching it means the data is too
+    // large.
+    if (dest.size() > kMaxStreamSize - total_written_)
+      dest = dest.first(kMaxStreamSize - total_written_);
+
+    size_t written = 0;
+    while (written < dest.size()) {
+      if (copy_left_) {
+        size_t size = std::min(dest.size() - written, copy_left_);
+        size_t copied = ReadInput(dest.subspan(written, size));
+        written += copied;
+        copy_left_ -= copied;
+        if (copied < size) {
+          // Zero-fill the rest of a run truncated by the end of the input.
+          fill_left_ = copy_left_;
+          fill_ = 0;
+          copy_left_ = 0;
+          ended_ = true;
+        }
+        continue;
+      }
+      if (fill_left_) {
+        size_t size = std::min(dest.size() - written, fill_left_);
+        memset(dest.data() + written, fill_, size);
+        written += size;
+        fill_left_ -= size;
+        continue;
+      }
+      uint8_t length;
+      if (ended_ || !ReadInputByte(&length) || length == 128)
+        break;
+
+      if (length < 128) {
+        copy_left_ = length + 1;
+      } else {
+        fill_left_ = 257 - length;
+        if (!ReadInputByte(&fill_)) {
+          fill_ = 0;
+          ended_ = true;
+        }
+      }
+    }
+    if (written < dest.size())
+      ended_ = true;
+    total_written_ += written;
+    if (total_written_ == kMaxStreamSize) {
+      SetError();
+      ended_ = true;
+    }
+    return written;
+  }
+
+ private:
+  size_t total_written_ = 0;
+  size_t copy_left_ = 0;
+  size_t fill_left_ = 0;
+  uint8_t fill_ = 0;
+  bool ended_ = false;
+};
+
 }  // namespace
 
 const uint16_t PDFDocEncoding[256] = {
@@ -365,6 +569,49 @@ uint32_t FlateOrLZWDecode(bool bLZW,
                                        estimated_size, dest_buf, dest_size);
 }
 
+std::unique_ptr<fxcodec::ChunkedDecoder> CreateChunkedDataDecoder(
+    std::unique_ptr<fxcodec::ChunkedDecoder> source,
+    const DecoderArray& decoder_array) {
+  std::unique_ptr<fxcodec::ChunkedDecoder> decoder = std::move(source);
+  for (const auto& item : decoder_array) {
+    const ByteString& name = item.first;
+    const CPDF_Dictionary* pParams = ToDictionary(item.second);
+    if (name == "Crypt")
+      continue;
+
+    const bool bLZW = name == "LZWDecode" || name == "LZW";
+    if (bLZW || name == "FlateDecode" || name == "Fl") {
+      int predictor = 0;
+      int Colors = 0;
+      int BitsPerComponent = 0;
+      int Columns = 0;
+      bool bEarlyChange = true;
+      if (pParams) {
+        predictor = pParams->GetIntegerFor("Predictor");
+        bEarlyChange = !!pParams->GetIntegerFor("EarlyChange", 1);
+        Colors = pParams->GetIntegerFor("Colors", 1);
+        BitsPerComponent = pParams->GetIntegerFor("BitsPerComponent", 8);
+        Columns = pParams->GetIntegerFor("Columns", 1);
+        if (!CheckFlateDecodeParams(Colors, BitsPerComponent, Columns))
+          return nullptr;
+      }
+      decoder = FlateModule::CreateChunkedDecoder(
+          bLZW, std::move(decoder), bEarlyChange, predictor, Colors,
+          BitsPerComponent, Columns);
+    } else if (name == "ASCII85Decode" || name == "A85") {
+      decoder = std::make_unique<A85ChunkedDecoder>(std::move(decoder));
+    } else if (name == "ASCIIHexDecode" || name == "AHx") {
+      decoder = std::make_unique<HexChunkedDecoder>(std::move(decoder));
+    } else if (name == "RunLengthDecode" || name == "RL") {
+      decoder = std::make_unique<RunLengthChunkedDecoder>(std::move(decoder));
+    } else {
+      // Image decoders only work on whole images.
+      return nullptr;
+    }
+  }
+  return decoder;
+}
+
 Optional<DecoderArray> GetDecoderArray(const CPDF_Dictionary* pDict) {
   const CPDF_Object* pFilter = pDict->GetDirectObjectFor("Filter");
   if (!pFilter)
@@ -402,7 +649,7 @@ bool PDF_DataDecode(
     bool bImageAcc,
     const std::vector<std::pair<ByteString, const CPDF_Object*>>& decoder_array,
     std::unique_ptr<uint8_t, FxFreeDeleter>* dest_buf,
-    uint32_t* dest_size,
+    size_t* dest_size,
     ByteString* ImageEncoding,
     RetainPtr<const CPDF_Dictionary>* pImageParams) {
   std::unique_ptr<uint8_t, FxFreeDeleter> result;
@@ -419,6 +666,10 @@ bool PDF_DataDecode(
     uint32_t offset = FX_INVALID_OFFSET;
     if (decoder == "Crypt")
       continue;
+
+    // The filters decoded here work with 32-bit sizes and offsets. Larger
+    // data can still be handed to the image decoders below.
+    const bool fits_decoders = last_span.size() < FX_INVALID_OFFSET;
     if (decoder == "FlateDecode" || decoder == "Fl") {
       if (bImageAcc && i == nSize - 1) {
         *ImageEncoding = "FlateDecode";
@@ -427,14 +678,22 @@ bool PDF_DataDecode(
         pImageParams->Reset(pParam);
         return true;
       }
+      if (!fits_decoders)
+        return false;
       offset = FlateOrLZWDecode(false, last_span, pParam, estimated_size,
                                 &new_buf, &new_size);
     } else if (decoder == "LZWDecode" || decoder == "LZW") {
+      if (!fits_decoders)
+        return false;
       offset = FlateOrLZWDecode(true, last_span, pParam, estimated_size,
                                 &new_buf, &new_size);
     } else if (decoder == "ASCII85Decode" || decoder == "A85") {
+      if (!fits_decoders)
+        return false;
       offset = A85Decode(last_span, &new_buf, &new_size);
     } else if (decoder == "ASCIIHexDecode" || decoder == "AHx") {
+      if (!fits_decoders)
+        return false;
       offset = HexDecode(last_span, &new_buf, &new_size);
     } else if (decoder == "RunLengthDecode" || decoder == "RL") {
       if (bImageAcc && i == nSize - 1) {
@@ -444,6 +703,8 @@ bool PDF_DataDecode(
         pImageParams->Reset(pParam);
         return true;
       }
+      if (!fits_decoders)
+        return false;
       offset = RunLengthDecode(last_span, &new_buf, &new_size);
     } else {
       // If we get here, assume it's an image decoder.
@@ -22,6 +22,7 @@ class CPDF_Dictionary;
 class CPDF_Object;
 
 namespace fxcodec {
+class ChunkedDecoder;
 class ScanlineDecoder;
 }
 
@@ -83,12 +84,20 @@ uint32_t FlateOrLZWDecode(bool bLZW,
 using DecoderArray = std::vector<std::pair<ByteString, const CPDF_Object*>>;
 Optional<DecoderArray> GetDecoderArray(const CPDF_Dictionary* pDict);
 
+// Returns a decoder that applies the filters in |decoder_array| to the output
+// of |source|, producing the same data as PDF_DataDecode() one chunk at a
+// time. Returns nullptr if the parameters are invalid, or if a filter can only
+// decode whole images.
+std::unique_ptr<fxcodec::ChunkedDecoder> CreateChunkedDataDecoder(
+    std::unique_ptr<fxcodec::ChunkedDecoder> source,
+    const DecoderArray& decoder_array);
+
 bool PDF_DataDecode(pdfium::span<const uint8_t> src_span,
                     uint32_t estimated_size,
                     bool bImageAcc,
                     const DecoderArray& decoder_array,
                     std::unique_ptr<uint8_t, FxFreeDeleter>* dest_buf,
-                    uint32_t* dest_size,
+                    size_t* dest_size,
                     ByteString* ImageEncoding,
                     RetainPtr<const CPDF_Dictionary>* pImageParams);
 
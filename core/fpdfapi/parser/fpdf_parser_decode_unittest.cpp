@@ -4,15 +4,136 @@
 
 #include "core/fpdfapi/parser/fpdf_parser_decode.h"
 
+#include <algorithm>
+#include <memory>
+#include <vector>
+
 #include "core/fpdfapi/parser/cpdf_array.h"
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
 #include "core/fpdfapi/parser/cpdf_name.h"
+#include "core/fpdfapi/parser/cpdf_number.h"
 #include "core/fpdfapi/parser/cpdf_string.h"
+#include "core/fxcodec/chunked_decoder.h"
+#include "core/fxcodec/flate/flatemodule.h"
 #include "core/fxcrt/fx_memory_wrappers.h"
 #include "testing/gtest/include/gtest/gtest.h"
 #include "testing/test_support.h"
 #include "third_party/base/stl_util.h"
 
+namespace {
+
+std::unique_ptr<fxcodec::ChunkedDecoder> CreateChunkedDataDecoderForTest(
+    pdfium::span<const uint8_t> src_span,
+    const DecoderArray& decoder_array) {
+  return CreateChunkedDataDecoder(
+      std::make_unique<fxcodec::SpanChunkedDecoder>(src_span), decoder_array);
+}
+
+// Reads a few bytes at a time, so that every decoder state gets to span reads.
+std::vector<uint8_t> ReadAllInSmallChunks(fxcodec::ChunkedDecoder* decoder) {
+  std::vector<uint8_t> result;
+  uint8_t chunk[3];
+  while (size_t size = decoder->Read(chunk))
+    result.insert(result.end(), chunk, chunk + size);
+  return result;
+}
+
+// Builds a zlib stream of stored blocks, with an empty stored block, as
+// written by a full flush, after every 1 MiB of |data|.
+std::vector<uint8_t> StoredZlibStreamWithFlushPoints(
+    const std::vector<uint8_t>& data) {
+  std::vector<uint8_t> stream = {0x78, 0x01};
+  auto append_stored_block = [&stream](bool final, const uint8_t* block,
+                                       uint16_t size) {
+    stream.push_back(final ? 0x01 : 0x00);
+    stream.push_back(size & 0xff);
+    stream.push_back(size >> 8);
+    stream.push_back(~size & 0xff);
+    stream.push_back((~size >> 8) & 0xff);
+    stream.insert(stream.end(), block, block + size);
+  };
+  constexpr size_t kFlushInterval = 1024 * 1024;
+  for (size_t pos = 0; pos < data.size();) {
+    const uint16_t size =
+        static_cast<uint16_t>(std::min<size_t>(0xffff, data.size() - pos));
+    append_stored_block(false, data.data() + pos, size);
+    if ((pos + size) / kFlushInterval != pos / kFlushInterval)
+      append_stored_block(false, nullptr, 0);
+    pos += size;
+  }
+  append_stored_block(true, nullptr, 0);
+
+  uint32_t a = 1;
+  uint32_t b = 0;
+  for (uint8_t byte : data) {
+    a = (a + byte) % 65521;
+    b = (b + a) % 65521;
+  }
+  const uint32_t adler = (b << 16) | a;
+  stream.push_back(adler >> 24);
+  stream.push_back((adler >> 16) & 0xff);
+  stream.push_back((adler >> 8) & 0xff);
+  stream.push_back(adler & 0xff);
+  return stream;
+}
+
+// Turns on parallel Flate decoding with a fixed number of threads for the
+// lifetime of the scope.
+class ScopedParallelFlateDecode {
+ public:
+  explicit ScopedParallelFlateDecode(unsigned int thread_count) {
+    FlateModule::SetParallelDecodeEnabled(true);
+    FlateModule::SetParallelDecodeThreadCountForTesting(thread_count);
+  }
+  ~ScopedParallelFlateDecode() {
+    FlateModule::SetParallelDecodeThreadCountForTesting(0);
+    FlateModule::SetParallelDecodeEnabled(false);
+  }
+};
+
+// Builds a small zlib stream that inflates to |size| zeros, using one fixed
+// Huffman block of literal zeros followed by 258-byte back references.
+std::vector<uint8_t> ZlibStreamOfZeros(size_t size) {
+  std::vector<uint8_t> stream = {0x78, 0x01};
+  uint32_t bit_buf = 0;
+  int bit_count = 0;
+  auto write_bits = [&](uint32_t value, int count) {
+    bit_buf |= value << bit_count;
+    bit_count += count;
+    while (bit_count >= 8) {
+      stream.push_back(bit_buf & 0xff);
+      bit_buf >>= 8;
+      bit_count -= 8;
+    }
+  };
+  // Huffman codes are stored starting from their most significant bit.
+  auto write_code = [&](uint32_t code, int count) {
+    for (int i = count - 1; i >= 0; --i)
+      write_bits((code >> i) & 1, 1);
+  };
+
+  write_bits(1, 1);  // Final block.
+  write_bits(1, 2);  // Fixed Huffman codes.
+  const size_t literals = size ? 1 + (size - 1) % 258 : 0;
+  for (size_t i = 0; i < literals; ++i)
+    write_code(0x30, 8);  // Literal 0.
+  for (size_t i = 0; i < (size - literals) / 258; ++i) {
+    write_code(0xc5, 8);  // Length 258.
+    write_code(0x00, 5);  // Distance 1.
+  }
+  write_code(0x00, 7);  // End of block.
+  write_bits(0, 7);     // Pad to a byte boundary.
+
+  const uint32_t adler = static_cast<uint32_t>(size % 65521) << 16 | 1;
+  stream.push_back(adler >> 24);
+  stream.push_back((adler >> 16) & 0xff);
+  stream.push_back((adler >> 8) & 0xff);
+  stream.push_back(adler & 0xff);
+  return stream;
+}
+
+}  // namespace
+
 TEST(fpdf_parser_decode, ValidateDecoderPipeline) {
   {
     // Empty decoder list is always valid.
@@ -255,6 +376,42 @@ TEST(FPDFParserDecodeEmbedderTest, FlateDecode) {
   }
 }
 
+TEST(fpdf_parser_decode, FlateDecodeWithFlushPoints) {
+  // Enough threads to decode in parallel on any machine.
+  ScopedParallelFlateDecode parallel_decode(4);
+
+  // Large enough to be split at flush points and inflated in parallel.
+  constexpr size_t kDataSize = 6 * 1024 * 1024;
+  std::vector<uint8_t> expected(kDataSize);
+  for (size_t i = 0; i < kDataSize; ++i)
+    expected[i] = static_cast<uint8_t>(i * 7 + (i >> 9));
+
+  for (int with_fake_flushes = 0; with_fake_flushes < 2; ++with_fake_flushes) {
+    if (with_fake_flushes) {
+      // Bytes that look like the end of a flush, inside the data.
+      for (size_t i = 1000; i + 4 <= kDataSize; i += 50000) {
+        expected[i] = 0x00;
+        expected[i + 1] = 0x00;
+        expected[i + 2] = 0xff;
+        expected[i + 3] = 0xff;
+      }
+    }
+    std::vector<uint8_t> input = StoredZlibStreamWithFlushPoints(expected);
+
+    std::unique_ptr<uint8_t, FxFreeDeleter> buf;
+    uint32_t buf_size;
+    EXPECT_EQ(input.size(), FlateDecode(input, &buf, &buf_size));
+    ASSERT_EQ(kDataSize, buf_size);
+    EXPECT_EQ(0, memcmp(expected.data(), buf.get(), kDataSize));
+
+    // Splitting at a fake flush fails, so the data is inflated serially.
+    if (with_fake_flushes)
+      EXPECT_EQ(0u, FlateModule::GetParallelDecodeSegmentCountForTesting());
+    else
+      EXPECT_GT(FlateModule::GetParallelDecodeSegmentCountForTesting(), 1u);
+  }
+}
+
 TEST(fpdf_parser_decode, FlateEncode) {
   static const pdfium::StrFuncTestData flate_encode_cases[] = {
       STR_IN_OUT_CASE("", "\x78\x9c\x03\x00\x00\x00\x00\x01"),
@@ -322,6 +479,141 @@ TEST(fpdf_parser_decode, HexDecode) {
   }
 }
 
+TEST(fpdf_parser_decode, ChunkedDataDecoder) {
+  struct {
+    const char* filter;
+    pdfium::DecodeTestData data;
+  } const kTestData[] = {
+      {"A85", STR_IN_OUT_CASE("", "", 0)},
+      {"A85", STR_IN_OUT_CASE("\t F C\r\n \tf N 8 ~>", "test", 0)},
+      {"A85", STR_IN_OUT_CASE("@3B0)DJj_BF*)>@Gp#-s", "a funny story :)", 0)},
+      {"A85", STR_IN_OUT_CASE("12A", "2k", 0)},
+      {"A85", STR_IN_OUT_CASE("FCfN8FCfN8vw", "testtest", 0)},
+      {"AHx", STR_IN_OUT_CASE("12 Ac\t02\r\nBF>zzz>", "\x12\xac\x02\xbf", 0)},
+      {"AHx", STR_IN_OUT_CASE("12A>zzz", "\x12\xa0", 0)},
+      {"AHx", STR_IN_OUT_CASE("12tk  \tAc>zzz", "\x12\xac", 0)},
+      {"RL", STR_IN_OUT_CASE("\x02" "abc\xfdx\x80zz", "abcxxxx", 0)},
+      // Truncated runs are padded with zeros.
+      {"RL", STR_IN_OUT_CASE("\x04" "ab", "ab\x00\x00\x00", 0)},
+      {"RL", STR_IN_OUT_CASE("\xff", "\x00\x00", 0)},
+      {"Fl", STR_IN_OUT_CASE("\x78\x9c\x33\x34\x32\x06\x00\01\x2d\x00\x97",
+                             "123", 0)},
+      // Corrupt Flate data ends the output rather than failing.
+      {"Fl", STR_IN_OUT_CASE("preposterous nonsense", "", 0)},
+  };
+  for (const auto& test_case : kTestData) {
+    const pdfium::DecodeTestData& data = test_case.data;
+    DecoderArray decoder_array = {{test_case.filter, nullptr}};
+    std::unique_ptr<fxcodec::ChunkedDecoder> decoder =
+        CreateChunkedDataDecoderForTest({data.input, data.input_size},
+                                        decoder_array);
+    ASSERT_TRUE(decoder);
+    std::vector<uint8_t> result = ReadAllInSmallChunks(decoder.get());
+    EXPECT_FALSE(decoder->HasError()) << "for case " << data.input;
+    EXPECT_EQ(std::vector<uint8_t>(data.expected,
+                                   data.expected + data.expected_size),
+              result)
+        << "for case " << data.input;
+  }
+}
+
+TEST(fpdf_parser_decode, ChunkedDataDecoderChain) {
+  // "123", Flate encoded and then hex encoded.
+  static const char kInput[] = "789c333432060001 2d0097>";
+  DecoderArray decoder_array = {{"AHx", nullptr}, {"FlateDecode", nullptr}};
+  std::unique_ptr<fxcodec::ChunkedDecoder> decoder =
+      CreateChunkedDataDecoderForTest(
+          {reinterpret_cast<const uint8_t*>(kInput), sizeof(kInput) - 1},
+          decoder_array);
+  ASSERT_TRUE(decoder);
+  EXPECT_EQ((std::vector<uint8_t>{'1', '2', '3'}),
+            ReadAllInSmallChunks(decoder.get()));
+  EXPECT_FALSE(decoder->HasError());
+}
+
+TEST(fpdf_parser_decode, ChunkedDataDecoderRunLengthLimit) {
+  // Runs of 128 zeros, adding up to 20 MiB, which RunLengthDecode() rejects.
+  std::vector<uint8_t> input;
+  for (size_t i = 0; i < 20 * 1024 * 1024 / 128; ++i) {
+    input.push_back(0x81);
+    input.push_back(0);
+  }
+  DecoderArray decoder_array = {{"RunLengthDecode", nullptr}};
+  std::unique_ptr<fxcodec::ChunkedDecoder> decoder =
+      CreateChunkedDataDecoderForTest(input, decoder_array);
+  ASSERT_TRUE(decoder);
+  std::vector<uint8_t> chunk(64 * 1024);
+  while (decoder->Read(chunk)) {
+  }
+  EXPECT_TRUE(decoder->HasError());
+
+  // One run less is fine.
+  input.resize(input.size() - 2);
+  decoder = CreateChunkedDataDecoderForTest(input, decoder_array);
+  ASSERT_TRUE(decoder);
+  size_t total = 0;
+  while (size_t size = decoder->Read(chunk))
+    total += size;
+  EXPECT_FALSE(decoder->HasError());
+  EXPECT_EQ(20u * 1024 * 1024 - 128, total);
+}
+
+TEST(fpdf_parser_decode, ChunkedDataDecoderFlateLimit) {
+  DecoderArray decoder_array = {{"FlateDecode", nullptr}};
+  std::vector<uint8_t> input = ZlibStreamOfZeros(1000);
+  std::unique_ptr<fxcodec::ChunkedDecoder> decoder =
+      CreateChunkedDataDecoderForTest(input, decoder_array);
+  ASSERT_TRUE(decoder);
+  EXPECT_EQ(std::vector<uint8_t>(1000), ReadAllInSmallChunks(decoder.get()));
+  EXPECT_FALSE(decoder->HasError());
+
+  // 1 GiB is the most FlateUncompress() produces.
+  constexpr size_t kLimit = 1024 * 1024 * 1024;
+  input = ZlibStreamOfZeros(kLimit + 1);
+  decoder = CreateChunkedDataDecoderForTest(input, decoder_array);
+  ASSERT_TRUE(decoder);
+  std::vector<uint8_t> chunk(1024 * 1024);
+  size_t total = 0;
+  while (size_t size = decoder->Read(chunk))
+    total += size;
+  EXPECT_TRUE(decoder->HasError());
+  EXPECT_EQ(kLimit, total);
+}
+
+TEST(fpdf_parser_decode, ChunkedDataDecoderPngPredictor) {
+  // Rows of 3 bytes using the Up, Up and Sub predictors, Flate encoded.
+  static const uint8_t kInput[] = {0x78, 0x9c, 0x63, 0x62, 0x64, 0x62,
+                                   0x66, 0x62, 0x04, 0x02, 0x56, 0x46,
+                                   0x46, 0x00, 0x00, 0x96, 0x00, 0x16};
+  auto params = pdfium::MakeRetain<CPDF_Dictionary>();
+  params->SetNewFor<CPDF_Number>("Predictor", 12);
+  params->SetNewFor<CPDF_Number>("Columns", 3);
+  DecoderArray decoder_array = {{"FlateDecode", params.Get()}};
+  std::unique_ptr<fxcodec::ChunkedDecoder> decoder =
+      CreateChunkedDataDecoderForTest(kInput, decoder_array);
+  ASSERT_TRUE(decoder);
+  EXPECT_EQ((std::vector<uint8_t>{1, 2, 3, 2, 3, 4, 5, 6, 7}),
+            ReadAllInSmallChunks(decoder.get()));
+  EXPECT_FALSE(decoder->HasError());
+
+  // Without any data, there are no rows to predict.
+  decoder = CreateChunkedDataDecoderForTest({}, decoder_array);
+  ASSERT_TRUE(decoder);
+  EXPECT_TRUE(ReadAllInSmallChunks(decoder.get()).empty());
+  EXPECT_TRUE(decoder->HasError());
+}
+
+TEST(fpdf_parser_decode, ChunkedDataDecoderUnsupported) {
+  // Image decoders only work on whole images.
+  DecoderArray decoder_array = {{"FlateDecode", nullptr}, {"DCT", nullptr}};
+  EXPECT_FALSE(CreateChunkedDataDecoderForTest({}, decoder_array));
+
+  auto params = pdfium::MakeRetain<CPDF_Dictionary>();
+  params->SetNewFor<CPDF_Number>("Colors", -1);
+  decoder_array = {{"FlateDecode", params.Get()}};
+  EXPECT_FALSE(CreateChunkedDataDecoderForTest({}, decoder_array));
+}
+
 TEST(fpdf_parser_decode, DecodeText) {
   const struct DecodeTestData {
     const char* input;
@@ -46,7 +46,7 @@ void CPDF_ProgressiveRenderer::Continue(PauseIndicatorIface* pPause) {
         return;
       }
       m_pCurrentLayer = m_pContext->GetLayer(m_LayerIndex);
-      m_LastObjectRendered = m_pCurrentLayer->m_pObjectHolder->end();
+      m_NextObject = 0;
       m_pRenderStatus = std::make_unique<CPDF_RenderStatus>(m_pContext.Get(),
                                                             m_pDevice.Get());
       if (m_pOptions)
@@ -57,58 +57,63 @@ void CPDF_ProgressiveRenderer::Continue(PauseIndicatorIface* pPause) {
       m_pDevice->SaveState();
       m_ClipRect = m_pCurrentLayer->m_Matrix.GetInverse().TransformRect(
           CFX_FloatRect(m_pDevice->GetClipBox()));
-    }
-    CPDF_PageObjectHolder::const_iterator iter;
-    CPDF_PageObjectHolder::const_iterator iterEnd =
-        m_pCurrentLayer->m_pObjectHolder->end();
-    if (m_LastObjectRendered != iterEnd) {
-      iter = m_LastObjectRendered;
-      ++iter;
-    } else {
-      iter = m_pCurrentLayer->m_pObjectHolder->begin();
+      const CPDF_PageObjectHolder* pHolder =
+          m_pCurrentLayer->m_pObjectHolder.Get();
+      m_bHasVisibleObjects = pHolder->GetParseState() ==
+                             CPDF_PageObjectHolder::ParseState::kParsed;
+      if (m_bHasVisibleObjects) {
+        m_VisibleObjects = pHolder->GetPageObjectsInRect(m_ClipRect);
+        m_NextVisibleObject = 0;
+      }
     }
     int nObjsToGo = kStepLimit;
     bool is_mask = false;
-    while (iter != iterEnd) {
-      CPDF_PageObject* pCurObj = iter->get();
-      if (pCurObj && pCurObj->GetRect().left <= m_ClipRect.right &&
-          pCurObj->GetRect().right >= m_ClipRect.left &&
-          pCurObj->GetRect().bottom <= m_ClipRect.top &&
-          pCurObj->GetRect().top >= m_ClipRect.bottom) {
-        if (m_pOptions->GetOptions().bBreakForMasks && pCurObj->IsImage() &&
-            pCurObj->AsImage()->GetImage()->IsMask()) {
-          if (m_pDevice->GetDeviceType() == DeviceType::kPrinter) {
-            m_LastObjectRendered = iter;
-            m_pRenderStatus->ProcessClipPath(pCurObj->m_ClipPath,
-                                             m_pCurrentLayer->m_Matrix);
+    if (m_bHasVisibleObjects) {
+      while (m_NextVisibleObject < m_VisibleObjects.size()) {
+        ObjectStatus status =
+            RenderObject(m_VisibleObjects[m_NextVisibleObject], pPause,
+                         &nObjsToGo, &is_mask);
+        if (status == ObjectStatus::kStopBefore)
+          return;
+        ++m_NextVisibleObject;
+        if (status == ObjectStatus::kStopAfter)
+          return;
+        if (nObjsToGo == 0) {
+          if (pPause && pPause->NeedToPauseNow())
             return;
-          }
-          is_mask = true;
+          nObjsToGo = kStepLimit;
         }
-        if (m_pRenderStatus->ContinueSingleObject(
-                pCurObj, m_pCurrentLayer->m_Matrix, pPause)) {
+        if (is_mask && m_NextVisibleObject < m_VisibleObjects.size())
           return;
+      }
+    } else {
+      // Objects may still be appended while this runs, so track them by index.
+      const CPDF_PageObjectHolder* pHolder =
+          m_pCurrentLayer->m_pObjectHolder.Get();
+      while (m_NextObject < pHolder->GetPageObjectCount()) {
+        CPDF_PageObject* pCurObj = pHolder->GetPageObjectByIndex(m_NextObject);
+        if (pCurObj && pCurObj->GetRect().left <= m_ClipRect.right &&
+            pCurObj->GetRect().right >= m_ClipRect.left &&
+            pCurObj->GetRect().bottom <= m_ClipRect.top &&
+            pCurObj->GetRect().top >= m_ClipRect.bottom) {
+          ObjectStatus status =
+              RenderObject(pCurObj, pPause, &nObjsToGo, &is_mask);
+          if (status == ObjectStatus::kStopBefore)
+            return;
+          if (status == ObjectStatus::kStopAfter) {
+            ++m_NextObject;
+            return;
+          }
         }
-        if (pCurObj->IsImage() && m_pRenderStatus->GetRenderOptions()
-                                      .GetOptions()
-                                      .bLimitedImageCache) {
-          m_pContext->GetPageCache()->CacheOptimization(
-              m_pRenderStatus->GetRenderOptions().GetCacheSizeLimit());
+        ++m_NextObject;
+        if (nObjsToGo == 0) {
+          if (pPause && pPause->NeedToPauseNow())
+            return;
+          nObjsToGo = kStepLimit;
         }
-        if (pCurObj->IsForm() || pCurObj->IsShading())
-          nObjsToGo = 0;
-        else
-          --nObjsToGo;
-      }
-      m_LastObjectRendered = iter;
-      if (nObjsToGo == 0) {
-        if (pPause && pPause->NeedToPauseNow())
+        if (is_mask && m_NextObject < pHolder->GetPageObjectCount())
           return;
-        nObjsToGo = kStepLimit;
       }
-      ++iter;
-      if (is_mask && iter != iterEnd)
-        return;
     }
     if (m_pCurrentLayer->m_pObjectHolder->GetParseState() ==
         CPDF_PageObjectHolder::ParseState::kParsed) {
@@ -129,3 +134,33 @@ void CPDF_ProgressiveRenderer::Continue(PauseIndicatorIface* pPause) {
     }
   }
 }
+
+CPDF_ProgressiveRenderer::ObjectStatus CPDF_ProgressiveRenderer::RenderObject(
+    CPDF_PageObject* pCurObj,
+    PauseIndicatorIface* pPause,
+    int* nObjsToGo,
+    bool* is_mask) {
+  if (m_pOptions->GetOptions().bBreakForMasks && pCurObj->IsImage() &&
+      pCurObj->AsImage()->GetImage()->IsMask()) {
+    if (m_pDevice->GetDeviceType() == DeviceType::kPrinter) {
+      m_pRenderStatus->ProcessClipPath(pCurObj->m_ClipPath,
+                                       m_pCurrentLayer->m_Matrix);
+      return ObjectStatus::kStopAfter;
+    }
+    *is_mask = true;
+  }
+  if (m_pRenderStatus->ContinueSingleObject(pCurObj, m_pCurrentLayer->m_Matrix,
+                                            pPause)) {
+    return ObjectStatus::kStopBefore;
+  }
+  if (pCurObj->IsImage() &&
+      m_pRenderStatus->GetRenderOptions().GetOptions().bLimitedImageCache) {
+    m_pContext->GetPageCache()->CacheOptimization(
+        m_pRenderStatus->GetRenderOptions().GetCacheSizeLimit());
+  }
+  if (pCurObj->IsForm() || pCurObj->IsShading())
+    *nObjsToGo = 0;
+  else
+    --*nObjsToGo;
+  return ObjectStatus::kRendered;
+}
@@ -8,6 +8,7 @@
 #define CORE_FPDFAPI_RENDER_CPDF_PROGRESSIVERENDERER_H_
 
 #include <memory>
+#include <vector>
 
 #include "core/fpdfapi/page/cpdf_pageobjectholder.h"
 #include "core/fpdfapi/render/cpdf_rendercontext.h"
@@ -15,6 +16,7 @@
 #include "core/fxcrt/fx_system.h"
 #include "core/fxcrt/unowned_ptr.h"
 
+class CPDF_PageObject;
 class CPDF_RenderOptions;
 class CPDF_RenderStatus;
 class CFX_RenderDevice;
@@ -45,6 +47,17 @@ class CPDF_ProgressiveRenderer {
   // Maximum page objects to render before checking for pause.
   static constexpr int kStepLimit = 100;
 
+  enum class ObjectStatus {
+    kRendered,    // Move on to the next object.
+    kStopBefore,  // Return, and continue with this object.
+    kStopAfter,   // Return, and continue with the next object.
+  };
+
+  ObjectStatus RenderObject(CPDF_PageObject* pCurObj,
+                            PauseIndicatorIface* pPause,
+                            int* nObjsToGo,
+                            bool* is_mask);
+
   Status m_Status = kReady;
   UnownedPtr<CPDF_RenderContext> const m_pContext;
   UnownedPtr<CFX_RenderDevice> const m_pDevice;
@@ -53,7 +66,15 @@ class CPDF_ProgressiveRenderer {
   CFX_FloatRect m_ClipRect;
   uint32_t m_LayerIndex = 0;
   CPDF_RenderContext::Layer* m_pCurrentLayer = nullptr;
-  CPDF_PageObjectHolder::const_iterator m_LastObjectRendered;
+  // For layers that are still being parsed, the index of the next object to
+  // consider.
+  size_t m_NextObject = 0;
+
+  // For layers that are fully parsed when rendering starts, the objects that
+  // intersect |m_ClipRect|, in paint order, and the next one to render.
+  bool m_bHasVisibleObjects = false;
+  std::vector<CPDF_PageObject*> m_VisibleObjects;
+  size_t m_NextVisibleObject = 0;
 };
 
 #endif  // CORE_FPDFAPI_RENDER_CPDF_PROGRESSIVERENDERER_H_
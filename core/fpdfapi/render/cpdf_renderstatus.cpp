@@ -74,7 +74,7 @@
 namespace {
 
 constexpr int kRenderMaxRecursionDepth = 64;
-int g_CurrentRecursionDepth = 0;
+thread_local int g_CurrentRecursionDepth = 0;
 
 CFX_FillRenderOptions GetFillOptionsForDrawPathWithBlend(
     const CPDF_RenderOptions::Options& options,
@@ -159,6 +159,21 @@ class ScopedSkiaDeviceFlush {
 };
 #endif
 
+// Returns the glyphs of |textobj|. They are laid out in text space, so the
+// object keeps them for later renders at any matrix.
+const std::vector<TextCharPos>& GetTextCharPosList(
+    const CPDF_TextObject* textobj) {
+  const std::vector<TextCharPos>* pCharPosList =
+      textobj->GetCachedCharPosList();
+  if (pCharPosList)
+    return *pCharPosList;
+
+  textobj->SetCachedCharPosList(GetCharPosList(
+      textobj->GetCharCodes(), textobj->GetCharPositions(),
+      textobj->GetFont().Get(), textobj->GetFontSize()));
+  return *textobj->GetCachedCharPosList();
+}
+
 }  // namespace
 
 CPDF_RenderStatus::CPDF_RenderStatus(CPDF_RenderContext* pContext,
@@ -200,23 +215,33 @@ void CPDF_RenderStatus::RenderObjectList(
 #endif
   CFX_FloatRect clip_rect = mtObj2Device.GetInverse().TransformRect(
       CFX_FloatRect(m_pDevice->GetClipBox()));
-  for (const auto& pCurObj : *pObjectHolder) {
-    if (pCurObj.get() == m_pStopObj) {
-      m_bStopped = true;
-      return;
+  if (!m_pStopObj) {
+    // Let the holder skip the objects outside the clip without visiting each.
+    for (CPDF_PageObject* pCurObj :
+         pObjectHolder->GetPageObjectsInRect(clip_rect)) {
+      RenderSingleObject(pCurObj, mtObj2Device);
+      if (m_bStopped)
+        return;
     }
-    if (!pCurObj)
-      continue;
-
-    if (pCurObj->GetRect().left > clip_rect.right ||
-        pCurObj->GetRect().right < clip_rect.left ||
-        pCurObj->GetRect().bottom > clip_rect.top ||
-        pCurObj->GetRect().top < clip_rect.bottom) {
-      continue;
+  } else {
+    for (const auto& pCurObj : *pObjectHolder) {
+      if (pCurObj.get() == m_pStopObj) {
+        m_bStopped = true;
+        return;
+      }
+      if (!pCurObj)
+        continue;
+
+      if (pCurObj->GetRect().left > clip_rect.right ||
+          pCurObj->GetRect().right < clip_rect.left ||
+          pCurObj->GetRect().bottom > clip_rect.top ||
+          pCurObj->GetRect().top < clip_rect.bottom) {
+        continue;
+      }
+      RenderSingleObject(pCurObj.get(), mtObj2Device);
+      if (m_bStopped)
+        return;
     }
-    RenderSingleObject(pCurObj.get(), mtObj2Device);
-    if (m_bStopped)
-      return;
   }
 #if defined(_SKIA_SUPPORT_)
   DebugVerifyDeviceIsPreMultiplied();
@@ -676,7 +701,7 @@ bool CPDF_RenderStatus::ProcessTransparency(CPDF_PageObject* pPageObj,
 
       // TODO(thestig): Should we check the return value here?
       CPDF_TextRenderer::DrawTextPath(
-          &text_device, textobj->GetCharCodes(), textobj->GetCharPositions(),
+          &text_device, GetTextCharPosList(textobj),
           textobj->m_TextState.GetFont().Get(),
           textobj->m_TextState.GetFontSize(), textobj->GetTextMatrix(),
           &new_matrix, textobj->m_GraphState.GetObject(), 0xffffffff, 0,
@@ -886,17 +911,16 @@ bool CPDF_RenderStatus::ProcessText(CPDF_TextObject* textobj,
       }
     }
     return CPDF_TextRenderer::DrawTextPath(
-        m_pDevice, textobj->GetCharCodes(), textobj->GetCharPositions(),
-        pFont.Get(), font_size, text_matrix, pDeviceMatrix,
-        textobj->m_GraphState.GetObject(), fill_argb, stroke_argb,
-        clipping_path,
+        m_pDevice, GetTextCharPosList(textobj), pFont.Get(), font_size,
+        text_matrix, pDeviceMatrix, textobj->m_GraphState.GetObject(),
+        fill_argb, stroke_argb, clipping_path,
         GetFillOptionsForDrawTextPath(m_Options.GetOptions(), textobj,
                                       is_stroke, is_fill));
   }
   text_matrix.Concat(mtObj2Device);
   return CPDF_TextRenderer::DrawNormalText(
-      m_pDevice, textobj->GetCharCodes(), textobj->GetCharPositions(),
-      pFont.Get(), font_size, text_matrix, fill_argb, m_Options);
+      m_pDevice, GetTextCharPosList(textobj), pFont.Get(), font_size,
+      text_matrix, fill_argb, m_Options);
 }
 
 // TODO(npm): Font fallback for type 3 fonts? (Completely separate code!!)
@@ -1096,9 +1120,7 @@ void CPDF_RenderStatus::DrawTextPathWithPattern(const CPDF_TextObject* textobj,
     return;
   }
 
-  std::vector<TextCharPos> char_pos_list = GetCharPosList(
-      textobj->GetCharCodes(), textobj->GetCharPositions(), pFont, font_size);
-  for (const TextCharPos& charpos : char_pos_list) {
+  for (const TextCharPos& charpos : GetTextCharPosList(textobj)) {
     auto* font = charpos.m_FallbackFontPosition == -1
                      ? pFont->GetFont()
                      : pFont->GetFontFallback(charpos.m_FallbackFontPosition);
@@ -49,8 +49,7 @@ CFX_TextRenderOptions GetTextRenderOptionsHelper(
 // static
 bool CPDF_TextRenderer::DrawTextPath(
     CFX_RenderDevice* pDevice,
-    pdfium::span<const uint32_t> char_codes,
-    pdfium::span<const float> char_pos,
+    pdfium::span<const TextCharPos> pos,
     CPDF_Font* pFont,
     float font_size,
     const CFX_Matrix& mtText2User,
@@ -60,8 +59,6 @@ bool CPDF_TextRenderer::DrawTextPath(
     FX_ARGB stroke_argb,
     CFX_PathData* pClippingPath,
     const CFX_FillRenderOptions& fill_options) {
-  std::vector<TextCharPos> pos =
-      GetCharPosList(char_codes, char_pos, pFont, font_size);
   if (pos.empty())
     return true;
 
@@ -125,21 +122,20 @@ void CPDF_TextRenderer::DrawTextString(CFX_RenderDevice* pDevice,
   CFX_Matrix new_matrix = matrix;
   new_matrix.e = origin_x;
   new_matrix.f = origin_y;
-  DrawNormalText(pDevice, codes, positions, pFont, font_size, new_matrix,
-                 fill_argb, options);
+  std::vector<TextCharPos> pos =
+      GetCharPosList(codes, positions, pFont, font_size);
+  DrawNormalText(pDevice, pos, pFont, font_size, new_matrix, fill_argb,
+                 options);
 }
 
 // static
 bool CPDF_TextRenderer::DrawNormalText(CFX_RenderDevice* pDevice,
-                                       pdfium::span<const uint32_t> char_codes,
-                                       pdfium::span<const float> char_pos,
+                                       pdfium::span<const TextCharPos> pos,
                                        CPDF_Font* pFont,
                                        float font_size,
                                        const CFX_Matrix& mtText2Device,
                                        FX_ARGB fill_argb,
                                        const CPDF_RenderOptions& options) {
-  std::vector<TextCharPos> pos =
-      GetCharPosList(char_codes, char_pos, pFont, font_size);
   if (pos.empty())
     return true;
 
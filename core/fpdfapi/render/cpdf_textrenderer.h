@@ -18,6 +18,7 @@ class CFX_GraphStateData;
 class CFX_PathData;
 class CPDF_RenderOptions;
 class CPDF_Font;
+class TextCharPos;
 struct CFX_FillRenderOptions;
 
 class CPDF_TextRenderer {
@@ -32,9 +33,9 @@ class CPDF_TextRenderer {
                              FX_ARGB fill_argb,
                              const CPDF_RenderOptions& options);
 
+  // |pos| holds glyphs already laid out by GetCharPosList().
   static bool DrawTextPath(CFX_RenderDevice* pDevice,
-                           pdfium::span<const uint32_t> char_codes,
-                           pdfium::span<const float> char_pos,
+                           pdfium::span<const TextCharPos> pos,
                            CPDF_Font* pFont,
                            float font_size,
                            const CFX_Matrix& mtText2User,
@@ -45,9 +46,9 @@ class CPDF_TextRenderer {
                            CFX_PathData* pClippingPath,
                            const CFX_FillRenderOptions& fill_options);
 
+  // |pos| holds glyphs already laid out by GetCharPosList().
   static bool DrawNormalText(CFX_RenderDevice* pDevice,
-                             pdfium::span<const uint32_t> char_codes,
-                             pdfium::span<const float> char_pos,
+                             pdfium::span<const TextCharPos> pos,
                              CPDF_Font* pFont,
                              float font_size,
                              const CFX_Matrix& mtText2Device,
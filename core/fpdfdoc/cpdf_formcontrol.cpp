@@ -10,6 +10,7 @@
 #include "core/fpdfapi/page/cpdf_docpagedata.h"
 #include "core/fpdfapi/parser/cpdf_array.h"
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
+#include "core/fpdfapi/parser/cpdf_document.h"
 #include "core/fpdfapi/parser/cpdf_name.h"
 #include "core/fpdfapi/parser/cpdf_stream.h"
 #include "core/fpdfapi/parser/fpdf_parser_decode.h"
@@ -123,6 +124,7 @@ void CPDF_FormControl::CheckControl(bool bChecked) {
   if (csOldAS == csAS)
     return;
   m_pWidgetDict->SetNewFor<CPDF_Name>("AS", csAS);
+  m_pForm->GetDocument()->MarkIndirectObjectDirty(m_pWidgetDict->GetObjNum());
 }
 
 CPDF_FormControl::HighlightingMode CPDF_FormControl::GetHighlightingMode()
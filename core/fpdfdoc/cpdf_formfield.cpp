@@ -18,6 +18,7 @@
 #include "core/fpdfapi/parser/cfdf_document.h"
 #include "core/fpdfapi/parser/cpdf_array.h"
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
+#include "core/fpdfapi/parser/cpdf_document.h"
 #include "core/fpdfapi/parser/cpdf_name.h"
 #include "core/fpdfapi/parser/cpdf_number.h"
 #include "core/fpdfapi/parser/cpdf_string.h"
@@ -211,6 +212,7 @@ bool CPDF_FormField::ResetField() {
         m_pDict->RemoveFor(pdfium::form_fields::kV);
         m_pDict->RemoveFor("RV");
       }
+      MarkDictDirty();
       NotifyAfterValueChange();
       break;
     }
@@ -288,6 +290,7 @@ ByteString CPDF_FormField::GetDefaultStyle() const {
 
 void CPDF_FormField::SetOpt(RetainPtr<CPDF_Object> pOpt) {
   m_pDict->SetFor("Opt", std::move(pOpt));
+  MarkDictDirty();
 }
 
 WideString CPDF_FormField::GetValue(bool bDefault) const {
@@ -359,6 +362,7 @@ bool CPDF_FormField::SetValue(const WideString& value,
           SetItemSelection(iIndex, NotificationOption::kDoNotNotify);
         }
       }
+      MarkDictDirty();
       if (notify == NotificationOption::kNotify)
         NotifyAfterValueChange();
       break;
@@ -465,6 +469,7 @@ bool CPDF_FormField::ClearSelection(NotificationOption notify) {
   }
   m_pDict->RemoveFor(pdfium::form_fields::kV);
   m_pDict->RemoveFor("I");
+  MarkDictDirty();
   if (notify == NotificationOption::kNotify)
     NotifyListOrComboBoxAfterChange();
   return true;
@@ -492,6 +497,7 @@ bool CPDF_FormField::SetItemSelection(int index, NotificationOption notify) {
   }
 
   SetItemSelectionSelected(index, opt_value);
+  MarkDictDirty();
 
   // UseSelectedIndicesObject() has a non-trivial linearithmic run-time, so run
   // only if necessary.
@@ -633,6 +639,7 @@ bool CPDF_FormField::CheckControl(int iControlIndex,
     m_pDict->SetNewFor<CPDF_Name>(pdfium::form_fields::kV,
                                   ByteString::Format("%d", iControlIndex));
   }
+  MarkDictDirty();
   if (notify == NotificationOption::kNotify && m_pForm->GetFormNotify())
     m_pForm->GetFormNotify()->AfterCheckedStatusChange(this);
   return true;
@@ -780,12 +787,17 @@ bool CPDF_FormField::SelectOption(int iOptIndex,
     if (pArray->IsEmpty())
       m_pDict->RemoveFor("I");
   }
+  MarkDictDirty();
   if (notify == NotificationOption::kNotify)
     NotifyListOrComboBoxAfterChange();
 
   return true;
 }
 
+void CPDF_FormField::MarkDictDirty() {
+  m_pForm->GetDocument()->MarkIndirectObjectDirty(m_pDict->GetObjNum());
+}
+
 bool CPDF_FormField::UseSelectedIndicesObject() const {
   DCHECK(GetType() == kComboBox || GetType() == kListBox);
 
@@ -168,6 +168,9 @@ class CPDF_FormField {
   bool NotifyListOrComboBoxBeforeChange(const WideString& value);
   void NotifyListOrComboBoxAfterChange();
 
+  // Records that |m_pDict| changed, so that incremental saves write it.
+  void MarkDictDirty();
+
   const CPDF_Object* GetDefaultValueObject() const;
   const CPDF_Object* GetValueObject() const;
 
@@ -0,0 +1,85 @@
+// Copyright 2021 PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxcodec/chunked_decoder.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <utility>
+
+#include "third_party/base/check.h"
+
+namespace fxcodec {
+
+namespace {
+
+constexpr size_t kInputBufferSize = 16 * 1024;
+
+}  // namespace
+
+ChunkedDecoder::~ChunkedDecoder() = default;
+
+bool ChunkedDecoder::HasError() const {
+  return false;
+}
+
+SpanChunkedDecoder::SpanChunkedDecoder(pdfium::span<const uint8_t> src_span)
+    : remaining_(src_span) {}
+
+SpanChunkedDecoder::~SpanChunkedDecoder() = default;
+
+size_t SpanChunkedDecoder::Read(pdfium::span<uint8_t> dest) {
+  size_t size = std::min(dest.size(), remaining_.size());
+  if (size) {
+    memcpy(dest.data(), remaining_.data(), size);
+    remaining_ = remaining_.subspan(size);
+  }
+  return size;
+}
+
+FilterChunkedDecoder::FilterChunkedDecoder(
+    std::unique_ptr<ChunkedDecoder> source)
+    : source_(std::move(source)), input_buf_(kInputBufferSize) {}
+
+FilterChunkedDecoder::~FilterChunkedDecoder() = default;
+
+bool FilterChunkedDecoder::HasError() const {
+  return error_ || source_->HasError();
+}
+
+size_t FilterChunkedDecoder::ReadInput(pdfium::span<uint8_t> dest) {
+  size_t written = 0;
+  while (written < dest.size()) {
+    pdfium::span<const uint8_t> input = PeekInput();
+    if (input.empty())
+      break;
+
+    size_t size = std::min(dest.size() - written, input.size());
+    memcpy(dest.data() + written, input.data(), size);
+    ConsumeInput(size);
+    written += size;
+  }
+  return written;
+}
+
+pdfium::span<const uint8_t> FilterChunkedDecoder::PeekInput() {
+  if (input_pos_ == input_size_ && !FillInput())
+    return {};
+  return pdfium::make_span(input_buf_).subspan(input_pos_,
+                                               input_size_ - input_pos_);
+}
+
+void FilterChunkedDecoder::ConsumeInput(size_t size) {
+  DCHECK(size <= input_size_ - input_pos_);
+  input_pos_ += size;
+}
+
+bool FilterChunkedDecoder::FillInput() {
+  input_pos_ = 0;
+  input_size_ = source_->Read(pdfium::make_span(input_buf_));
+  return input_size_ > 0;
+}
+
+}  // namespace fxcodec
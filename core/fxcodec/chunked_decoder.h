@@ -0,0 +1,90 @@
+// Copyright 2021 PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FXCODEC_CHUNKED_DECODER_H_
+#define CORE_FXCODEC_CHUNKED_DECODER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <vector>
+
+#include "core/fxcrt/fx_memory_wrappers.h"
+#include "third_party/base/span.h"
+
+namespace fxcodec {
+
+// Produces decoded data a chunk at a time. Decoders for stream filters pull
+// their input from another ChunkedDecoder, so a whole filter chain can run
+// without materializing the input, output, or any intermediate data.
+class ChunkedDecoder {
+ public:
+  virtual ~ChunkedDecoder();
+
+  // Fills |dest| with decoded data. Returns the number of bytes written, which
+  // is less than |dest.size()| only once the data has ended.
+  virtual size_t Read(pdfium::span<uint8_t> dest) = 0;
+
+  // Returns whether decoding stopped because the data is invalid. The data
+  // already read is then incomplete.
+  virtual bool HasError() const;
+};
+
+// Passes through the bytes of |src_span|, which must outlive the decoder.
+class SpanChunkedDecoder final : public ChunkedDecoder {
+ public:
+  explicit SpanChunkedDecoder(pdfium::span<const uint8_t> src_span);
+  ~SpanChunkedDecoder() override;
+
+  // ChunkedDecoder:
+  size_t Read(pdfium::span<uint8_t> dest) override;
+
+ private:
+  pdfium::span<const uint8_t> remaining_;
+};
+
+// Base class for decoders that read their input from another decoder.
+class FilterChunkedDecoder : public ChunkedDecoder {
+ public:
+  ~FilterChunkedDecoder() override;
+
+  // ChunkedDecoder:
+  bool HasError() const override;
+
+ protected:
+  explicit FilterChunkedDecoder(std::unique_ptr<ChunkedDecoder> source);
+
+  // Returns false at the end of the input.
+  bool ReadInputByte(uint8_t* byte) {
+    if (input_pos_ == input_size_ && !FillInput())
+      return false;
+    *byte = input_buf_[input_pos_++];
+    return true;
+  }
+
+  // Fills |dest| with input. Returns the number of bytes written, which is
+  // less than |dest.size()| only at the end of the input.
+  size_t ReadInput(pdfium::span<uint8_t> dest);
+
+  // Returns the buffered input, refilling the buffer first if it is empty.
+  // Returns an empty span at the end of the input.
+  pdfium::span<const uint8_t> PeekInput();
+  void ConsumeInput(size_t size);
+
+  void SetError() { error_ = true; }
+
+ private:
+  bool FillInput();
+
+  std::unique_ptr<ChunkedDecoder> const source_;
+  std::vector<uint8_t, FxAllocAllocator<uint8_t>> input_buf_;
+  size_t input_pos_ = 0;
+  size_t input_size_ = 0;
+  bool error_ = false;
+};
+
+}  // namespace fxcodec
+
+#endif  // CORE_FXCODEC_CHUNKED_DECODER_H_
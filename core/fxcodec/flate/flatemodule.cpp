@@ -7,15 +7,21 @@
 #include "core/fxcodec/flate/flatemodule.h"
 
 #include <algorithm>
+#include <atomic>
+#include <functional>
 #include <limits>
 #include <memory>
+#include <thread>
 #include <utility>
 #include <vector>
 
+#include "core/fxcodec/chunked_decoder.h"
+#include "core/fxcodec/flate/predictor.h"
 #include "core/fxcodec/fx_codec.h"
 #include "core/fxcodec/scanlinedecoder.h"
 #include "core/fxcrt/fx_extension.h"
 #include "core/fxcrt/fx_memory_wrappers.h"
+#include "core/fxcrt/fx_safe_types.h"
 #include "third_party/base/check.h"
 #include "third_party/base/notreached.h"
 #include "third_party/base/numerics/safe_conversions.h"
@@ -63,14 +69,19 @@ bool FlateCompress(unsigned char* dest_buf,
   return compress(dest_buf, dest_size, src_buf, src_size) == Z_OK;
 }
 
-z_stream* FlateInit() {
+// Negative |window_bits| inflate raw deflate data, without a zlib header.
+z_stream* FlateInitWithWindowBits(int window_bits) {
   z_stream* p = FX_Alloc(z_stream, 1);
   p->zalloc = my_alloc_func;
   p->zfree = my_free_func;
-  inflateInit(p);
+  inflateInit2(p, window_bits);
   return p;
 }
 
+z_stream* FlateInit() {
+  return FlateInitWithWindowBits(MAX_WBITS);
+}
+
 void FlateInput(z_stream* context, pdfium::span<const uint8_t> src_buf) {
   context->next_in = const_cast<unsigned char*>(src_buf.data());
   context->avail_in = static_cast<uint32_t>(src_buf.size());
@@ -108,40 +119,41 @@ struct FlateDeleter {
   inline void operator()(z_stream* context) { FlateEnd(context); }
 };
 
-class CLZWDecoder {
+// The string table of an LZW decoder, which turns codes into the bytes they
+// stand for.
+class LZWCodeTable {
  public:
-  CLZWDecoder(pdfium::span<const uint8_t> src_span, bool early_change);
+  enum class Status { kContinue, kEnd, kError };
 
-  bool Decode();
-  uint32_t GetSrcSize() const { return (src_bit_pos_ + 7) / 8; }
-  uint32_t GetDestSize() const { return dest_byte_pos_; }
-  std::unique_ptr<uint8_t, FxFreeDeleter> TakeDestBuf() {
-    return std::move(dest_buf_);
+  explicit LZWCodeTable(bool early_change);
+
+  uint8_t code_len() const { return code_len_; }
+
+  // Decodes |code|. Unless there is an error, the bytes it stands for, if any,
+  // are then in |GetReversedOutput()|, last byte first.
+  Status DecodeCode(uint32_t code);
+  pdfium::span<const uint8_t> GetReversedOutput() const {
+    return {decode_stack_, stack_len_};
   }
 
  private:
   void AddCode(uint32_t prefix_code, uint8_t append_char);
   void DecodeString(uint32_t code);
-  void ExpandDestBuf(uint32_t additional_size);
 
-  pdfium::span<const uint8_t> const src_span_;
-  std::unique_ptr<uint8_t, FxFreeDeleter> dest_buf_;
-  uint32_t src_bit_pos_ = 0;
-  uint32_t dest_buf_size_ = 0;  // Actual allocated size.
-  uint32_t dest_byte_pos_ = 0;  // Size used.
   uint32_t stack_len_ = 0;
   uint8_t decode_stack_[4000];
   const uint8_t early_change_;
   uint8_t code_len_ = 9;
+  uint8_t last_char_ = 0;
+  uint32_t old_code_ = 0xFFFFFFFF;
   uint32_t current_code_ = 0;
   uint32_t codes_[5021];
 };
 
-CLZWDecoder::CLZWDecoder(pdfium::span<const uint8_t> src_span,
-                         bool early_change)
-    : src_span_(src_span), early_change_(early_change ? 1 : 0) {}
+LZWCodeTable::LZWCodeTable(bool early_change)
+    : early_change_(early_change ? 1 : 0) {}
 
-void CLZWDecoder::AddCode(uint32_t prefix_code, uint8_t append_char) {
+void LZWCodeTable::AddCode(uint32_t prefix_code, uint8_t append_char) {
   if (current_code_ + early_change_ == 4094)
     return;
 
@@ -154,7 +166,7 @@ void CLZWDecoder::AddCode(uint32_t prefix_code, uint8_t append_char) {
     code_len_ = 12;
 }
 
-void CLZWDecoder::DecodeString(uint32_t code) {
+void LZWCodeTable::DecodeString(uint32_t code) {
   while (1) {
     int index = code - 258;
     if (index < 0 || static_cast<uint32_t>(index) >= current_code_)
@@ -173,6 +185,95 @@ void CLZWDecoder::DecodeString(uint32_t code) {
   decode_stack_[stack_len_++] = static_cast<uint8_t>(code);
 }
 
+LZWCodeTable::Status LZWCodeTable::DecodeCode(uint32_t code) {
+  stack_len_ = 0;
+  if (code < 256) {
+    decode_stack_[stack_len_++] = static_cast<uint8_t>(code);
+    last_char_ = static_cast<uint8_t>(code);
+    if (old_code_ != 0xFFFFFFFF)
+      AddCode(old_code_, last_char_);
+    old_code_ = code;
+    return Status::kContinue;
+  }
+  if (code == 256) {
+    code_len_ = 9;
+    current_code_ = 0;
+    old_code_ = 0xFFFFFFFF;
+    return Status::kContinue;
+  }
+  if (code == 257)
+    return Status::kEnd;
+
+  // Case where |code| is 258 or greater.
+  if (old_code_ == 0xFFFFFFFF)
+    return Status::kError;
+
+  DCHECK(old_code_ < 256 || old_code_ >= 258);
+  if (code - 258 >= current_code_) {
+    decode_stack_[stack_len_++] = last_char_;
+    DecodeString(old_code_);
+  } else {
+    DecodeString(code);
+  }
+
+  last_char_ = decode_stack_[stack_len_ - 1];
+  if (old_code_ >= 258 && old_code_ - 258 >= current_code_)
+    return Status::kEnd;
+
+  AddCode(old_code_, last_char_);
+  old_code_ = code;
+  return Status::kContinue;
+}
+
+class CLZWDecoder {
+ public:
+  CLZWDecoder(pdfium::span<const uint8_t> src_span, bool early_change);
+
+  bool Decode();
+  uint32_t GetSrcSize() const { return (src_bit_pos_ + 7) / 8; }
+  uint32_t GetDestSize() const { return dest_byte_pos_; }
+  std::unique_ptr<uint8_t, FxFreeDeleter> TakeDestBuf() {
+    return std::move(dest_buf_);
+  }
+
+ private:
+  uint32_t ReadCode();
+  void ExpandDestBuf(uint32_t additional_size);
+
+  pdfium::span<const uint8_t> const src_span_;
+  std::unique_ptr<uint8_t, FxFreeDeleter> dest_buf_;
+  uint32_t src_bit_pos_ = 0;
+  uint32_t dest_buf_size_ = 0;  // Actual allocated size.
+  uint32_t dest_byte_pos_ = 0;  // Size used.
+  LZWCodeTable code_table_;
+};
+
+CLZWDecoder::CLZWDecoder(pdfium::span<const uint8_t> src_span,
+                         bool early_change)
+    : src_span_(src_span), code_table_(early_change) {}
+
+uint32_t CLZWDecoder::ReadCode() {
+  const uint8_t code_len = code_table_.code_len();
+  int byte_pos = src_bit_pos_ / 8;
+  int bit_pos = src_bit_pos_ % 8;
+  uint8_t bit_left = code_len;
+  uint32_t code = 0;
+  if (bit_pos) {
+    bit_left -= 8 - bit_pos;
+    code = (src_span_[byte_pos++] & ((1 << (8 - bit_pos)) - 1)) << bit_left;
+  }
+  if (bit_left < 8) {
+    code |= src_span_[byte_pos] >> (8 - bit_left);
+  } else {
+    bit_left -= 8;
+    code |= src_span_[byte_pos++] << bit_left;
+    if (bit_left)
+      code |= src_span_[byte_pos] >> (8 - bit_left);
+  }
+  src_bit_pos_ += code_len;
+  return code;
+}
+
 void CLZWDecoder::ExpandDestBuf(uint32_t additional_size) {
   FX_SAFE_UINT32 new_size = std::max(dest_buf_size_ / 2, additional_size);
   new_size += dest_buf_size_;
@@ -186,75 +287,18 @@ void CLZWDecoder::ExpandDestBuf(uint32_t additional_size) {
 }
 
 bool CLZWDecoder::Decode() {
-  uint32_t old_code = 0xFFFFFFFF;
-  uint8_t last_char = 0;
-
   // In one PDF test set, 40% of Decode() calls did not need to realloc with
   // this size.
   dest_buf_size_ = 512;
   dest_buf_.reset(FX_Alloc(uint8_t, dest_buf_size_));
-  while (1) {
-    if (src_bit_pos_ + code_len_ > src_span_.size() * 8)
-      break;
-
-    int byte_pos = src_bit_pos_ / 8;
-    int bit_pos = src_bit_pos_ % 8;
-    uint8_t bit_left = code_len_;
-    uint32_t code = 0;
-    if (bit_pos) {
-      bit_left -= 8 - bit_pos;
-      code = (src_span_[byte_pos++] & ((1 << (8 - bit_pos)) - 1)) << bit_left;
-    }
-    if (bit_left < 8) {
-      code |= src_span_[byte_pos] >> (8 - bit_left);
-    } else {
-      bit_left -= 8;
-      code |= src_span_[byte_pos++] << bit_left;
-      if (bit_left)
-        code |= src_span_[byte_pos] >> (8 - bit_left);
-    }
-    src_bit_pos_ += code_len_;
-
-    if (code < 256) {
-      if (dest_byte_pos_ >= dest_buf_size_) {
-        ExpandDestBuf(dest_byte_pos_ - dest_buf_size_ + 1);
-        if (!dest_buf_)
-          return false;
-      }
-
-      dest_buf_.get()[dest_byte_pos_] = (uint8_t)code;
-      dest_byte_pos_++;
-      last_char = (uint8_t)code;
-      if (old_code != 0xFFFFFFFF)
-        AddCode(old_code, last_char);
-      old_code = code;
-      continue;
-    }
-    if (code == 256) {
-      code_len_ = 9;
-      current_code_ = 0;
-      old_code = 0xFFFFFFFF;
-      continue;
-    }
-    if (code == 257)
-      break;
-
-    // Case where |code| is 258 or greater.
-    if (old_code == 0xFFFFFFFF)
+  while (src_bit_pos_ + code_table_.code_len() <= src_span_.size() * 8) {
+    LZWCodeTable::Status status = code_table_.DecodeCode(ReadCode());
+    if (status == LZWCodeTable::Status::kError)
       return false;
 
-    DCHECK(old_code < 256 || old_code >= 258);
-    stack_len_ = 0;
-    if (code - 258 >= current_code_) {
-      if (stack_len_ < sizeof(decode_stack_))
-        decode_stack_[stack_len_++] = last_char;
-      DecodeString(old_code);
-    } else {
-      DecodeString(code);
-    }
-
+    pdfium::span<const uint8_t> output = code_table_.GetReversedOutput();
     FX_SAFE_UINT32 safe_required_size = dest_byte_pos_;
-    safe_required_size += stack_len_;
+    safe_required_size += output.size();
     if (!safe_required_size.IsValid())
       return false;
 
@@ -265,31 +309,15 @@ bool CLZWDecoder::Decode() {
         return false;
     }
 
-    for (uint32_t i = 0; i < stack_len_; i++)
-      dest_buf_.get()[dest_byte_pos_ + i] = decode_stack_[stack_len_ - i - 1];
-    dest_byte_pos_ += stack_len_;
-    last_char = decode_stack_[stack_len_ - 1];
-    if (old_code >= 258 && old_code - 258 >= current_code_)
+    for (size_t i = 0; i < output.size(); i++)
+      dest_buf_.get()[dest_byte_pos_ + i] = output[output.size() - i - 1];
+    dest_byte_pos_ += output.size();
+    if (status == LZWCodeTable::Status::kEnd)
       break;
-
-    AddCode(old_code, last_char);
-    old_code = code;
   }
   return dest_byte_pos_ != 0;
 }
 
-uint8_t PathPredictor(int a, int b, int c) {
-  int p = a + b - c;
-  int pa = abs(p - a);
-  int pb = abs(p - b);
-  int pc = abs(p - c);
-  if (pa <= pb && pa <= pc)
-    return (uint8_t)a;
-  if (pb <= pc)
-    return (uint8_t)b;
-  return (uint8_t)c;
-}
-
 void PNG_PredictLine(uint8_t* pDestData,
                      const uint8_t* pSrcData,
                      const uint8_t* pLastLine,
@@ -298,63 +326,12 @@ void PNG_PredictLine(uint8_t* pDestData,
                      int nPixels) {
   const uint32_t row_size = CalculatePitch8(bpc, nColors, nPixels).ValueOrDie();
   const uint32_t BytesPerPixel = (bpc * nColors + 7) / 8;
-  uint8_t tag = pSrcData[0];
-  if (tag == 0) {
-    memmove(pDestData, pSrcData + 1, row_size);
-    return;
-  }
-  for (uint32_t byte = 0; byte < row_size; ++byte) {
-    uint8_t raw_byte = pSrcData[byte + 1];
-    switch (tag) {
-      case 1: {
-        uint8_t left = 0;
-        if (byte >= BytesPerPixel) {
-          left = pDestData[byte - BytesPerPixel];
-        }
-        pDestData[byte] = raw_byte + left;
-        break;
-      }
-      case 2: {
-        uint8_t up = 0;
-        if (pLastLine) {
-          up = pLastLine[byte];
-        }
-        pDestData[byte] = raw_byte + up;
-        break;
-      }
-      case 3: {
-        uint8_t left = 0;
-        if (byte >= BytesPerPixel) {
-          left = pDestData[byte - BytesPerPixel];
-        }
-        uint8_t up = 0;
-        if (pLastLine) {
-          up = pLastLine[byte];
-        }
-        pDestData[byte] = raw_byte + (up + left) / 2;
-        break;
-      }
-      case 4: {
-        uint8_t left = 0;
-        if (byte >= BytesPerPixel) {
-          left = pDestData[byte - BytesPerPixel];
-        }
-        uint8_t up = 0;
-        if (pLastLine) {
-          up = pLastLine[byte];
-        }
-        uint8_t upper_left = 0;
-        if (byte >= BytesPerPixel && pLastLine) {
-          upper_left = pLastLine[byte - BytesPerPixel];
-        }
-        pDestData[byte] = raw_byte + PathPredictor(left, up, upper_left);
-        break;
-      }
-      default:
-        pDestData[byte] = raw_byte;
-        break;
-    }
-  }
+  pdfium::span<const uint8_t> last_line;
+  if (pLastLine)
+    last_line = pdfium::make_span(pLastLine, row_size);
+  PngUnfilterRow(pSrcData[0], pdfium::make_span(pSrcData + 1, row_size),
+                 last_line, BytesPerPixel,
+                 pdfium::make_span(pDestData, row_size));
 }
 
 bool PNG_Predictor(int Colors,
@@ -379,70 +356,14 @@ bool PNG_Predictor(int Colors,
   for (int row = 0; row < row_count; row++) {
     uint8_t tag = pSrcData[0];
     byte_cnt++;
-    if (tag == 0) {
-      int move_size = row_size;
-      if ((row + 1) * (move_size + 1) > static_cast<int>(*data_size)) {
-        move_size = last_row_size - 1;
-      }
-      memcpy(pDestData, pSrcData + 1, move_size);
-      pSrcData += move_size + 1;
-      pDestData += move_size;
-      byte_cnt += move_size;
-      continue;
-    }
-    for (int byte = 0; byte < row_size && byte_cnt < *data_size;
-         ++byte, ++byte_cnt) {
-      uint8_t raw_byte = pSrcData[byte + 1];
-      switch (tag) {
-        case 1: {
-          uint8_t left = 0;
-          if (byte >= BytesPerPixel) {
-            left = pDestData[byte - BytesPerPixel];
-          }
-          pDestData[byte] = raw_byte + left;
-          break;
-        }
-        case 2: {
-          uint8_t up = 0;
-          if (row) {
-            up = pDestData[byte - row_size];
-          }
-          pDestData[byte] = raw_byte + up;
-          break;
-        }
-        case 3: {
-          uint8_t left = 0;
-          if (byte >= BytesPerPixel) {
-            left = pDestData[byte - BytesPerPixel];
-          }
-          uint8_t up = 0;
-          if (row) {
-            up = pDestData[byte - row_size];
-          }
-          pDestData[byte] = raw_byte + (up + left) / 2;
-          break;
-        }
-        case 4: {
-          uint8_t left = 0;
-          if (byte >= BytesPerPixel) {
-            left = pDestData[byte - BytesPerPixel];
-          }
-          uint8_t up = 0;
-          if (row) {
-            up = pDestData[byte - row_size];
-          }
-          uint8_t upper_left = 0;
-          if (byte >= BytesPerPixel && row) {
-            upper_left = pDestData[byte - row_size - BytesPerPixel];
-          }
-          pDestData[byte] = raw_byte + PathPredictor(left, up, upper_left);
-          break;
-        }
-        default:
-          pDestData[byte] = raw_byte;
-          break;
-      }
-    }
+    // The last row may be truncated.
+    const uint32_t size = std::min<uint32_t>(row_size, *data_size - byte_cnt);
+    pdfium::span<const uint8_t> last_row;
+    if (row)
+      last_row = pdfium::make_span(pDestData - row_size, size);
+    PngUnfilterRow(tag, pdfium::make_span(pSrcData + 1, size), last_row,
+                   BytesPerPixel, pdfium::make_span(pDestData, size));
+    byte_cnt += size;
     pSrcData += row_size + 1;
     pDestData += row_size;
   }
@@ -485,6 +406,8 @@ void TIFF_PredictLine(uint8_t* dest_buf,
       dest_buf[i] = pixel >> 8;
       dest_buf[i + 1] = (uint8_t)pixel;
     }
+  } else if (BitsPerComponent == 8) {
+    TiffUnpredictRow8(pdfium::make_span(dest_buf, row_size), BytesPerPixel);
   } else {
     for (uint32_t i = BytesPerPixel; i < row_size; i++) {
       dest_buf[i] += dest_buf[i - BytesPerPixel];
@@ -512,6 +435,246 @@ bool TIFF_Predictor(int Colors,
   return true;
 }
 
+// Inflating data with flush points in parallel.
+//
+// Z_SYNC_FLUSH and Z_FULL_FLUSH end the deflate data written so far with an
+// empty stored block, whose last four bytes are |kFlushMarker|. Inflation can
+// restart right after one. Only a full flush also stops later data from
+// referring back to the output before it. So large streams are split after
+// markers, and the segments are inflated as raw deflate data concurrently.
+//
+// The same bytes can also occur inside compressed data, so a split only
+// counts if the segment before it ends exactly at a block boundary. A segment
+// that refers back past its start fails to inflate. Either way, the whole
+// stream is inflated serially instead, so the output is always identical.
+//
+// The segments are inflated twice: once to learn the size of their output,
+// and once more straight into their place in the result. So this needs
+// enough threads to beat a single serial pass, and is off unless enabled.
+constexpr size_t kMinParallelInflateSize = 4 * 1024 * 1024;
+constexpr size_t kParallelInflateSegmentSize = 1024 * 1024;
+constexpr unsigned int kMinParallelInflateThreads = 4;
+constexpr unsigned int kMaxParallelInflateThreads = 8;
+constexpr size_t kSizingBufferSize = 256 * 1024;
+constexpr size_t kProbeOutputSize = 64 * 1024;
+constexpr uint8_t kFlushMarker[] = {0x00, 0x00, 0xff, 0xff};
+
+// |z_stream::data_type| when inflate() is waiting for the header of a block
+// that is not the last one, with no unused bits left in the last input byte.
+constexpr int kAtBlockBoundary = 128;
+
+bool g_bParallelDecodeEnabled = false;
+unsigned int g_ParallelDecodeThreadCountForTesting = 0;
+thread_local size_t g_LastParallelDecodeSegmentCount = 0;
+
+struct InflateSegment {
+  pdfium::span<const uint8_t> input;
+  bool is_first;
+  bool is_last;
+  // Set when sizing the output.
+  size_t output_size = 0;
+  size_t output_offset = 0;
+  // Input consumed by the last segment, including a partial final byte.
+  size_t consumed = 0;
+};
+
+std::vector<InflateSegment> SplitAtFlushMarkers(
+    pdfium::span<const uint8_t> src_buf) {
+  std::vector<InflateSegment> segments;
+  size_t start = 0;
+  while (start + kParallelInflateSegmentSize < src_buf.size()) {
+    const uint8_t* search_begin =
+        src_buf.data() + start + kParallelInflateSegmentSize;
+    const uint8_t* marker =
+        std::search(search_begin, src_buf.data() + src_buf.size(),
+                    std::begin(kFlushMarker), std::end(kFlushMarker));
+    const size_t end = marker - src_buf.data() + sizeof(kFlushMarker);
+    if (end >= src_buf.size())
+      break;
+
+    segments.push_back({src_buf.subspan(start, end - start), start == 0,
+                        /*is_last=*/false});
+    start = end;
+  }
+  segments.push_back({src_buf.subspan(start), start == 0, /*is_last=*/true});
+  return segments;
+}
+
+// Inflates the start of every segment but the first with no history. Sync
+// flushes and chance markers almost always refer back right away, so this
+// rules them out before any thread is started.
+bool SegmentsStartWithoutHistory(const std::vector<InflateSegment>& segments) {
+  std::vector<uint8_t, FxAllocAllocator<uint8_t>> output(kProbeOutputSize);
+  for (size_t i = 1; i < segments.size(); ++i) {
+    std::unique_ptr<z_stream, FlateDeleter> context(
+        FlateInitWithWindowBits(-MAX_WBITS));
+    FlateInput(context.get(), segments[i].input);
+    context->next_out = output.data();
+    context->avail_out = static_cast<uint32_t>(output.size());
+    int ret = inflate(context.get(), Z_NO_FLUSH);
+    if (ret != Z_OK && ret != Z_STREAM_END && ret != Z_BUF_ERROR)
+      return false;
+  }
+  return true;
+}
+
+// Inflates |segment|. If |sizing|, the output goes to |dest| over and over
+// and only its size is recorded. Otherwise |dest| is the segment's place in
+// the result, which must match the recorded size. Returns whether |segment|
+// decoded to the same output that serial inflation produces for it.
+bool InflateSegmentData(InflateSegment* segment,
+                        pdfium::span<uint8_t> dest,
+                        bool sizing,
+                        const std::atomic<bool>& cancelled) {
+  std::unique_ptr<z_stream, FlateDeleter> context(
+      FlateInitWithWindowBits(segment->is_first ? MAX_WBITS : -MAX_WBITS));
+  FlateInput(context.get(), segment->input);
+
+  size_t output_size = 0;
+  // Receives any output beyond the recorded size, which makes this fail.
+  uint8_t overflow;
+  int ret;
+  while (true) {
+    if (cancelled)
+      return false;
+
+    pdfium::span<uint8_t> window = sizing ? dest : dest.subspan(output_size);
+    if (window.empty())
+      window = {&overflow, 1};
+    const uint32_t avail_out = static_cast<uint32_t>(window.size());
+    context->next_out = window.data();
+    context->avail_out = avail_out;
+    // Z_BLOCK stops at block boundaries, so |data_type| tells whether the
+    // input ended at one.
+    ret = inflate(context.get(), Z_BLOCK);
+    output_size += avail_out - context->avail_out;
+    if (output_size > (sizing ? kMaxTotalOutSize : dest.size()))
+      return false;
+    if (ret == Z_STREAM_END)
+      break;
+    if (ret != Z_OK && ret != Z_BUF_ERROR)
+      return false;
+    if (context->avail_out != 0 &&
+        (context->avail_in == 0 || ret == Z_BUF_ERROR)) {
+      break;
+    }
+  }
+  if (sizing)
+    segment->output_size = output_size;
+  else if (output_size != segment->output_size)
+    return false;
+
+  if (segment->is_last) {
+    segment->consumed = FlateGetPossiblyTruncatedTotalIn(context.get());
+    return ret == Z_STREAM_END;
+  }
+  return ret != Z_STREAM_END && context->avail_in == 0 &&
+         context->data_type == kAtBlockBoundary;
+}
+
+// Calls |inflate_segment| for every segment, on up to |thread_count| threads
+// including the calling one. Returns false as soon as any call fails.
+bool InflateSegmentsInParallel(
+    std::vector<InflateSegment>* segments,
+    unsigned int thread_count,
+    const std::function<bool(InflateSegment*, const std::atomic<bool>&)>&
+        inflate_segment) {
+  std::atomic<size_t> next_segment(0);
+  std::atomic<bool> failed(false);
+  auto inflate_segments = [segments, &inflate_segment, &next_segment,
+                           &failed]() {
+    for (size_t i = next_segment++; i < segments->size(); i = next_segment++) {
+      if (!inflate_segment(&(*segments)[i], failed)) {
+        failed = true;
+        return;
+      }
+    }
+  };
+  std::vector<std::thread> threads;
+  const size_t extra_threads =
+      std::min<size_t>(thread_count, segments->size()) - 1;
+  for (size_t i = 0; i < extra_threads; ++i)
+    threads.emplace_back(inflate_segments);
+  inflate_segments();
+  for (std::thread& thread : threads)
+    thread.join();
+  return !failed;
+}
+
+bool ParallelFlateUncompress(pdfium::span<const uint8_t> src_buf,
+                             std::unique_ptr<uint8_t, FxFreeDeleter>* dest_buf,
+                             uint32_t* dest_size,
+                             uint32_t* offset) {
+  g_LastParallelDecodeSegmentCount = 0;
+  if (!g_bParallelDecodeEnabled || src_buf.size() < kMinParallelInflateSize)
+    return false;
+
+  // Only handle a plain zlib header with a 32 KiB window, so raw segments
+  // accept exactly the back references that serial inflation does.
+  if (src_buf[0] != 0x78 || (src_buf[1] & 0x20) ||
+      ((src_buf[0] << 8) | src_buf[1]) % 31 != 0) {
+    return false;
+  }
+
+  const unsigned int thread_count =
+      g_ParallelDecodeThreadCountForTesting
+          ? g_ParallelDecodeThreadCountForTesting
+          : std::min(std::thread::hardware_concurrency(),
+                     kMaxParallelInflateThreads);
+  if (thread_count < kMinParallelInflateThreads)
+    return false;
+
+  std::vector<InflateSegment> segments = SplitAtFlushMarkers(src_buf);
+  if (segments.size() < 2 || !SegmentsStartWithoutHistory(segments))
+    return false;
+
+  bool sized = InflateSegmentsInParallel(
+      &segments, thread_count,
+      [](InflateSegment* segment, const std::atomic<bool>& cancelled) {
+        std::vector<uint8_t, FxAllocAllocator<uint8_t>> buffer(
+            kSizingBufferSize);
+        return InflateSegmentData(segment, buffer, /*sizing=*/true,
+                                  cancelled);
+      });
+  if (!sized)
+    return false;
+
+  FX_SAFE_SIZE_T total_size = 0;
+  for (InflateSegment& segment : segments) {
+    segment.output_offset = total_size.ValueOrDefault(0);
+    total_size += segment.output_size;
+  }
+  if (!total_size.IsValid() || total_size.ValueOrDie() > kMaxTotalOutSize)
+    return false;
+
+  const size_t result_size = total_size.ValueOrDie();
+  std::unique_ptr<uint8_t, FxFreeDeleter> result_buf(
+      FX_Alloc(uint8_t, std::max<size_t>(result_size, 1)));
+  pdfium::span<uint8_t> result(result_buf.get(), result_size);
+  bool inflated = InflateSegmentsInParallel(
+      &segments, thread_count,
+      [result](InflateSegment* segment, const std::atomic<bool>& cancelled) {
+        return InflateSegmentData(
+            segment,
+            result.subspan(segment->output_offset, segment->output_size),
+            /*sizing=*/false, cancelled);
+      });
+  if (!inflated)
+    return false;
+
+  // Account for the Adler-32 checksum after the deflate data, like inflate().
+  const InflateSegment& last = segments.back();
+  const size_t last_start = last.input.data() - src_buf.data();
+  const size_t end = last_start + last.consumed;
+  const size_t checksum_size = std::min<size_t>(4, src_buf.size() - end);
+
+  *dest_buf = std::move(result_buf);
+  *dest_size = static_cast<uint32_t>(result_size);
+  *offset = pdfium::base::saturated_cast<uint32_t>(end + checksum_size);
+  g_LastParallelDecodeSegmentCount = segments.size();
+  return true;
+}
+
 void FlateUncompress(pdfium::span<const uint8_t> src_buf,
                      uint32_t orig_size,
                      std::unique_ptr<uint8_t, FxFreeDeleter>* dest_buf,
@@ -520,6 +683,9 @@ void FlateUncompress(pdfium::span<const uint8_t> src_buf,
   dest_buf->reset();
   *dest_size = 0;
 
+  if (ParallelFlateUncompress(src_buf, dest_buf, dest_size, offset))
+    return;
+
   std::unique_ptr<z_stream, FlateDeleter> context(FlateInit());
   if (!context)
     return;
@@ -591,6 +757,262 @@ static PredictorType GetPredictor(int predictor) {
   return PredictorType::kNone;
 }
 
+// Decodes Flate data from another decoder. Like FlateUncompress(), it treats
+// corrupt or truncated data as ending early rather than as an error.
+class FlateChunkedDecoder final : public FilterChunkedDecoder {
+ public:
+  explicit FlateChunkedDecoder(std::unique_ptr<ChunkedDecoder> source)
+      : FilterChunkedDecoder(std::move(source)), context_(FlateInit()) {}
+  ~FlateChunkedDecoder() override = default;
+
+  // ChunkedDecoder:
+  size_t Read(pdfium::span<uint8_t> dest) override {
+    // Like FlateUncompress(), fail once the output exceeds kMaxTotalOutSize.
+    if (dest.size() > kMaxTotalOutSize - total_out_)
+      dest = dest.first(kMaxTotalOutSize - total_out_);
+
+    size_t written = Inflate(dest);
+    total_out_ += written;
+    if (total_out_ == kMaxTotalOutSize && !ended_) {
+      uint8_t extra;
+      if (Inflate({&extra, 1}))
+        SetError();
+      ended_ = true;
+    }
+    return written;
+  }
+
+ private:
+  size_t Inflate(pdfium::span<uint8_t> dest) {
+    size_t written = 0;
+    while (written < dest.size() && !ended_) {
+      pdfium::span<const uint8_t> input = PeekInput();
+      FlateInput(context_.get(), input);
+      context_->next_out = dest.data() + written;
+      context_->avail_out = pdfium::base::saturated_cast<uint32_t>(
+          dest.size() - written);
+      const uint32_t avail_out = context_->avail_out;
+      int ret = inflate(context_.get(), Z_SYNC_FLUSH);
+      written += avail_out - context_->avail_out;
+      ConsumeInput(input.size() - context_->avail_in);
+      // Z_BUF_ERROR means no progress was possible, which with room left in
+      // |dest| can only happen once the input has run out.
+      if (ret != Z_OK)
+        ended_ = true;
+    }
+    return written;
+  }
+
+  std::unique_ptr<z_stream, FlateDeleter> const context_;
+  size_t total_out_ = 0;
+  bool ended_ = false;
+};
+
+class LZWChunkedDecoder final : public FilterChunkedDecoder {
+ public:
+  LZWChunkedDecoder(std::unique_ptr<ChunkedDecoder> source, bool early_change)
+      : FilterChunkedDecoder(std::move(source)), code_table_(early_change) {}
+  ~LZWChunkedDecoder() override = default;
+
+  // ChunkedDecoder:
+  size_t Read(pdfium::span<uint8_t> dest) override {
+    size_t written = 0;
+    while (written < dest.size()) {
+      if (pending_) {
+        pdfium::span<const uint8_t> output = code_table_.GetReversedOutput();
+        while (pending_ && written < dest.size())
+          dest[written++] = output[--pending_];
+        continue;
+      }
+      if (ended_)
+        break;
+
+      uint32_t code;
+      if (!ReadCode(&code)) {
+        End();
+        break;
+      }
+      LZWCodeTable::Status status = code_table_.DecodeCode(code);
+      if (status == LZWCodeTable::Status::kError) {
+        SetError();
+        ended_ = true;
+        break;
+      }
+      pending_ = code_table_.GetReversedOutput().size();
+      total_size_ += pending_;
+      if (status == LZWCodeTable::Status::kEnd)
+        End();
+    }
+    return written;
+  }
+
+ private:
+  bool ReadCode(uint32_t* code) {
+    const uint8_t code_len = code_table_.code_len();
+    while (bit_count_ < code_len) {
+      uint8_t byte;
+      if (!ReadInputByte(&byte))
+        return false;
+      bit_buf_ = (bit_buf_ << 8) | byte;
+      bit_count_ += 8;
+    }
+    bit_count_ -= code_len;
+    *code = (bit_buf_ >> bit_count_) & ((1 << code_len) - 1);
+    return true;
+  }
+
+  void End() {
+    ended_ = true;
+    // Matches CLZWDecoder, which fails when there is no output at all.
+    if (total_size_ == 0)
+      SetError();
+  }
+
+  LZWCodeTable code_table_;
+  size_t pending_ = 0;
+  size_t total_size_ = 0;
+  uint32_t bit_buf_ = 0;
+  uint8_t bit_count_ = 0;
+  bool ended_ = false;
+};
+
+// Base class for the predictors, which decode their input a row at a time.
+class PredictorChunkedDecoder : public FilterChunkedDecoder {
+ public:
+  ~PredictorChunkedDecoder() override = default;
+
+  // ChunkedDecoder:
+  size_t Read(pdfium::span<uint8_t> dest) override {
+    size_t written = 0;
+    while (written < dest.size()) {
+      if (row_pos_ < row_.size()) {
+        size_t size = std::min(dest.size() - written, row_.size() - row_pos_);
+        memcpy(dest.data() + written, row_.data() + row_pos_, size);
+        row_pos_ += size;
+        written += size;
+        continue;
+      }
+      if (ended_ || !DecodeNextRow())
+        break;
+    }
+    return written;
+  }
+
+ protected:
+  PredictorChunkedDecoder(std::unique_ptr<ChunkedDecoder> source,
+                          int Colors,
+                          int BitsPerComponent,
+                          int Columns)
+      : FilterChunkedDecoder(std::move(source)),
+        colors_(Colors),
+        bits_per_component_(BitsPerComponent),
+        columns_(Columns),
+        row_size_((Colors * BitsPerComponent * Columns + 7) / 8) {}
+
+  // Puts the next row of output into |row_|. Returns false and sets |ended_|
+  // if there is none.
+  virtual bool DecodeNextRow() = 0;
+
+  const int colors_;
+  const int bits_per_component_;
+  const int columns_;
+  const int row_size_;
+  std::vector<uint8_t, FxAllocAllocator<uint8_t>> row_;
+  size_t row_pos_ = 0;
+  bool ended_ = false;
+};
+
+// Reverses PNG prediction, with the same handling of a partial last row as
+// PNG_Predictor().
+class PngPredictorChunkedDecoder final : public PredictorChunkedDecoder {
+ public:
+  PngPredictorChunkedDecoder(std::unique_ptr<ChunkedDecoder> source,
+                             int Colors,
+                             int BitsPerComponent,
+                             int Columns)
+      : PredictorChunkedDecoder(std::move(source),
+                                Colors,
+                                BitsPerComponent,
+                                Columns) {}
+  ~PngPredictorChunkedDecoder() override = default;
+
+ private:
+  // PredictorChunkedDecoder:
+  bool DecodeNextRow() override {
+    ended_ = true;
+    if (row_size_ <= 0) {
+      SetError();
+      return false;
+    }
+
+    raw_row_.resize(row_size_ + 1);
+    size_t raw_size = ReadInput(pdfium::make_span(raw_row_));
+    if (raw_size == 0) {
+      if (!has_last_row_)
+        SetError();
+      return false;
+    }
+    if (raw_size < raw_row_.size())
+      std::fill(raw_row_.begin() + raw_size, raw_row_.end(), 0);
+    else
+      ended_ = false;
+
+    last_row_.swap(row_);
+    row_.resize(row_size_);
+    PNG_PredictLine(row_.data(), raw_row_.data(),
+                    has_last_row_ ? last_row_.data() : nullptr,
+                    bits_per_component_, colors_, columns_);
+    has_last_row_ = true;
+    // A partial row is the last one, and its tag byte yields no output.
+    if (ended_)
+      row_.resize(raw_size - 1);
+    row_pos_ = 0;
+    return true;
+  }
+
+  std::vector<uint8_t, FxAllocAllocator<uint8_t>> raw_row_;
+  std::vector<uint8_t, FxAllocAllocator<uint8_t>> last_row_;
+  bool has_last_row_ = false;
+};
+
+// Reverses TIFF prediction, with the same handling of a partial last row as
+// TIFF_Predictor().
+class TiffPredictorChunkedDecoder final : public PredictorChunkedDecoder {
+ public:
+  TiffPredictorChunkedDecoder(std::unique_ptr<ChunkedDecoder> source,
+                              int Colors,
+                              int BitsPerComponent,
+                              int Columns)
+      : PredictorChunkedDecoder(std::move(source),
+                                Colors,
+                                BitsPerComponent,
+                                Columns) {}
+  ~TiffPredictorChunkedDecoder() override = default;
+
+ private:
+  // PredictorChunkedDecoder:
+  bool DecodeNextRow() override {
+    if (row_size_ == 0) {
+      SetError();
+      ended_ = true;
+      return false;
+    }
+
+    row_.resize(row_size_);
+    size_t size = ReadInput(pdfium::make_span(row_));
+    if (size < row_.size()) {
+      ended_ = true;
+      row_.resize(size);
+      if (size == 0)
+        return false;
+    }
+    TIFF_PredictLine(row_.data(), row_.size(), bits_per_component_, colors_,
+                     columns_);
+    row_pos_ = 0;
+    return true;
+  }
+};
+
 class FlateScanlineDecoder : public ScanlineDecoder {
  public:
   FlateScanlineDecoder(pdfium::span<const uint8_t> src_span,
@@ -849,6 +1271,51 @@ uint32_t FlateModule::FlateOrLZWDecode(
   return ret ? offset : FX_INVALID_OFFSET;
 }
 
+// static
+std::unique_ptr<ChunkedDecoder> FlateModule::CreateChunkedDecoder(
+    bool bLZW,
+    std::unique_ptr<ChunkedDecoder> source,
+    bool bEarlyChange,
+    int predictor,
+    int Colors,
+    int BitsPerComponent,
+    int Columns) {
+  std::unique_ptr<ChunkedDecoder> decoder;
+  if (bLZW)
+    decoder = std::make_unique<LZWChunkedDecoder>(std::move(source),
+                                                  bEarlyChange);
+  else
+    decoder = std::make_unique<FlateChunkedDecoder>(std::move(source));
+
+  switch (GetPredictor(predictor)) {
+    case PredictorType::kNone:
+      return decoder;
+    case PredictorType::kPng:
+      return std::make_unique<PngPredictorChunkedDecoder>(
+          std::move(decoder), Colors, BitsPerComponent, Columns);
+    case PredictorType::kFlate:
+      return std::make_unique<TiffPredictorChunkedDecoder>(
+          std::move(decoder), Colors, BitsPerComponent, Columns);
+  }
+  NOTREACHED();
+  return nullptr;
+}
+
+// static
+void FlateModule::SetParallelDecodeEnabled(bool enabled) {
+  g_bParallelDecodeEnabled = enabled;
+}
+
+// static
+void FlateModule::SetParallelDecodeThreadCountForTesting(unsigned int count) {
+  g_ParallelDecodeThreadCountForTesting = count;
+}
+
+// static
+size_t FlateModule::GetParallelDecodeSegmentCountForTesting() {
+  return g_LastParallelDecodeSegmentCount;
+}
+
 // static
 bool FlateModule::Encode(const uint8_t* src_buf,
                          uint32_t src_size,
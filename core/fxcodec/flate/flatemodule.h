@@ -15,6 +15,7 @@
 
 namespace fxcodec {
 
+class ChunkedDecoder;
 class ScanlineDecoder;
 
 class FlateModule {
@@ -42,6 +43,29 @@ class FlateModule {
       std::unique_ptr<uint8_t, FxFreeDeleter>* dest_buf,
       uint32_t* dest_size);
 
+  // Returns a decoder that produces the same data as FlateOrLZWDecode() from
+  // the output of |source|, one chunk at a time.
+  static std::unique_ptr<ChunkedDecoder> CreateChunkedDecoder(
+      bool bLZW,
+      std::unique_ptr<ChunkedDecoder> source,
+      bool bEarlyChange,
+      int predictor,
+      int Colors,
+      int BitsPerComponent,
+      int Columns);
+
+  // Lets large streams written with full flushes be inflated on several
+  // threads. Off by default.
+  static void SetParallelDecodeEnabled(bool enabled);
+
+  // Uses |count| threads for parallel decoding regardless of the hardware.
+  // 0 goes back to the hardware concurrency.
+  static void SetParallelDecodeThreadCountForTesting(unsigned int count);
+
+  // Returns how many segments the last decode on the calling thread inflated
+  // in parallel, or 0 if it inflated the data serially.
+  static size_t GetParallelDecodeSegmentCountForTesting();
+
   static bool Encode(const uint8_t* src_buf,
                      uint32_t src_size,
                      std::unique_ptr<uint8_t, FxFreeDeleter>* dest_buf,
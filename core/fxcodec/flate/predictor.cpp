@@ -0,0 +1,298 @@
+// Copyright 2021 PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxcodec/flate/predictor.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+
+#include "third_party/base/check.h"
+
+// SSE2 is part of the x86-64 baseline, so it needs no runtime detection.
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PREDICTOR_USE_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace fxcodec {
+
+namespace {
+
+enum PngFilterType : uint8_t {
+  kPngFilterNone = 0,
+  kPngFilterSub = 1,
+  kPngFilterUp = 2,
+  kPngFilterAverage = 3,
+  kPngFilterPaeth = 4,
+};
+
+uint8_t PaethPredictor(int a, int b, int c) {
+  int p = a + b - c;
+  int pa = abs(p - a);
+  int pb = abs(p - b);
+  int pc = abs(p - c);
+  if (pa <= pb && pa <= pc)
+    return static_cast<uint8_t>(a);
+  if (pb <= pc)
+    return static_cast<uint8_t>(b);
+  return static_cast<uint8_t>(c);
+}
+
+// Unfilters bytes [|begin|, |size|) of a row, given the bytes before |begin|.
+void PngUnfilterBytes(uint8_t filter_type,
+                      const uint8_t* src,
+                      const uint8_t* prev,
+                      uint32_t bytes_per_pixel,
+                      uint8_t* dest,
+                      size_t begin,
+                      size_t size) {
+  switch (filter_type) {
+    case kPngFilterSub:
+      for (size_t i = begin; i < size; ++i) {
+        uint8_t left = i >= bytes_per_pixel ? dest[i - bytes_per_pixel] : 0;
+        dest[i] = src[i] + left;
+      }
+      return;
+    case kPngFilterUp:
+      for (size_t i = begin; i < size; ++i)
+        dest[i] = src[i] + (prev ? prev[i] : 0);
+      return;
+    case kPngFilterAverage:
+      for (size_t i = begin; i < size; ++i) {
+        uint8_t left = i >= bytes_per_pixel ? dest[i - bytes_per_pixel] : 0;
+        uint8_t up = prev ? prev[i] : 0;
+        dest[i] = src[i] + (up + left) / 2;
+      }
+      return;
+    case kPngFilterPaeth:
+      for (size_t i = begin; i < size; ++i) {
+        uint8_t left = i >= bytes_per_pixel ? dest[i - bytes_per_pixel] : 0;
+        uint8_t up = prev ? prev[i] : 0;
+        uint8_t upper_left =
+            i >= bytes_per_pixel && prev ? prev[i - bytes_per_pixel] : 0;
+        dest[i] = src[i] + PaethPredictor(left, up, upper_left);
+      }
+      return;
+    default:
+      if (begin < size)
+        memmove(dest + begin, src + begin, size - begin);
+      return;
+  }
+}
+
+void TiffUnpredictBytes(uint8_t* row,
+                        uint32_t bytes_per_pixel,
+                        size_t begin,
+                        size_t size) {
+  for (size_t i = std::max<size_t>(begin, bytes_per_pixel); i < size; ++i)
+    row[i] += row[i - bytes_per_pixel];
+}
+
+#if defined(PREDICTOR_USE_SSE2)
+
+// The PNG filters other than Up depend on the previous pixel, so these work
+// on one pixel of 3 or 4 bytes at a time, with one byte per SIMD lane.
+
+template <uint32_t kBytesPerPixel>
+__m128i LoadPixel(const uint8_t* p) {
+  uint32_t pixel = 0;
+  memcpy(&pixel, p, kBytesPerPixel);
+  return _mm_cvtsi32_si128(static_cast<int>(pixel));
+}
+
+template <uint32_t kBytesPerPixel>
+void StorePixel(uint8_t* p, __m128i v) {
+  uint32_t pixel = static_cast<uint32_t>(_mm_cvtsi128_si32(v));
+  memcpy(p, &pixel, kBytesPerPixel);
+}
+
+// Returns the number of bytes unfiltered, which excludes a partial pixel at
+// the end of the row.
+template <uint32_t kBytesPerPixel>
+size_t UnfilterSubSse2(const uint8_t* src, uint8_t* dest, size_t size) {
+  __m128i left = _mm_setzero_si128();
+  size_t i = 0;
+  for (; i + kBytesPerPixel <= size; i += kBytesPerPixel) {
+    left = _mm_add_epi8(left, LoadPixel<kBytesPerPixel>(src + i));
+    StorePixel<kBytesPerPixel>(dest + i, left);
+  }
+  return i;
+}
+
+size_t UnfilterUpSse2(const uint8_t* src,
+                      const uint8_t* prev,
+                      uint8_t* dest,
+                      size_t size) {
+  size_t i = 0;
+  for (; i + 16 <= size; i += 16) {
+    __m128i raw = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    __m128i up = _mm_loadu_si128(reinterpret_cast<const __m128i*>(prev + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i),
+                     _mm_add_epi8(raw, up));
+  }
+  return i;
+}
+
+template <uint32_t kBytesPerPixel>
+size_t UnfilterAverageSse2(const uint8_t* src,
+                           const uint8_t* prev,
+                           uint8_t* dest,
+                           size_t size) {
+  const __m128i one = _mm_set1_epi8(1);
+  __m128i left = _mm_setzero_si128();
+  size_t i = 0;
+  for (; i + kBytesPerPixel <= size; i += kBytesPerPixel) {
+    __m128i up = LoadPixel<kBytesPerPixel>(prev + i);
+    // _mm_avg_epu8() rounds up, so subtract the low bit when the sum is odd.
+    __m128i average = _mm_sub_epi8(_mm_avg_epu8(left, up),
+                                   _mm_and_si128(_mm_xor_si128(left, up), one));
+    left = _mm_add_epi8(LoadPixel<kBytesPerPixel>(src + i), average);
+    StorePixel<kBytesPerPixel>(dest + i, left);
+  }
+  return i;
+}
+
+__m128i Abs16(__m128i v) {
+  __m128i sign = _mm_srai_epi16(v, 15);
+  return _mm_sub_epi16(_mm_xor_si128(v, sign), sign);
+}
+
+__m128i Select(__m128i mask, __m128i if_true, __m128i if_false) {
+  return _mm_or_si128(_mm_and_si128(mask, if_true),
+                      _mm_andnot_si128(mask, if_false));
+}
+
+template <uint32_t kBytesPerPixel>
+size_t UnfilterPaethSse2(const uint8_t* src,
+                         const uint8_t* prev,
+                         uint8_t* dest,
+                         size_t size) {
+  // Work on 16-bit lanes, so the differences below cannot overflow.
+  const __m128i zero = _mm_setzero_si128();
+  __m128i left = zero;
+  __m128i upper_left = zero;
+  size_t i = 0;
+  for (; i + kBytesPerPixel <= size; i += kBytesPerPixel) {
+    __m128i up = _mm_unpacklo_epi8(LoadPixel<kBytesPerPixel>(prev + i), zero);
+    // With p = left + up - upper_left, these are p - left, p - up and
+    // p - upper_left.
+    __m128i pa = _mm_sub_epi16(up, upper_left);
+    __m128i pb = _mm_sub_epi16(left, upper_left);
+    __m128i pc = _mm_add_epi16(pa, pb);
+    pa = Abs16(pa);
+    pb = Abs16(pb);
+    pc = Abs16(pc);
+    __m128i smallest = _mm_min_epi16(pc, _mm_min_epi16(pa, pb));
+    // Ties favor left, then up, like PaethPredictor().
+    __m128i nearest =
+        Select(_mm_cmpeq_epi16(smallest, pa), left,
+               Select(_mm_cmpeq_epi16(smallest, pb), up, upper_left));
+    // Adding bytes wraps around within each lane's low byte, and leaves the
+    // high byte zero.
+    left = _mm_add_epi8(
+        _mm_unpacklo_epi8(LoadPixel<kBytesPerPixel>(src + i), zero), nearest);
+    StorePixel<kBytesPerPixel>(dest + i, _mm_packus_epi16(left, left));
+    upper_left = up;
+  }
+  return i;
+}
+
+// Returns the number of bytes unfiltered with SSE2.
+size_t PngUnfilterRowSse2(uint8_t filter_type,
+                          const uint8_t* src,
+                          const uint8_t* prev,
+                          uint32_t bytes_per_pixel,
+                          uint8_t* dest,
+                          size_t size) {
+  if (filter_type == kPngFilterSub) {
+    if (bytes_per_pixel == 3)
+      return UnfilterSubSse2<3>(src, dest, size);
+    if (bytes_per_pixel == 4)
+      return UnfilterSubSse2<4>(src, dest, size);
+    return 0;
+  }
+
+  // The first row is rare enough to leave to the scalar code.
+  if (!prev)
+    return 0;
+
+  switch (filter_type) {
+    case kPngFilterUp:
+      return UnfilterUpSse2(src, prev, dest, size);
+    case kPngFilterAverage:
+      if (bytes_per_pixel == 3)
+        return UnfilterAverageSse2<3>(src, prev, dest, size);
+      if (bytes_per_pixel == 4)
+        return UnfilterAverageSse2<4>(src, prev, dest, size);
+      return 0;
+    case kPngFilterPaeth:
+      if (bytes_per_pixel == 3)
+        return UnfilterPaethSse2<3>(src, prev, dest, size);
+      if (bytes_per_pixel == 4)
+        return UnfilterPaethSse2<4>(src, prev, dest, size);
+      return 0;
+    default:
+      return 0;
+  }
+}
+
+#endif  // defined(PREDICTOR_USE_SSE2)
+
+void CheckRowSizes(pdfium::span<const uint8_t> src,
+                   pdfium::span<const uint8_t> prev,
+                   pdfium::span<uint8_t> dest) {
+  CHECK(dest.size() >= src.size());
+  CHECK(prev.empty() || prev.size() >= src.size());
+}
+
+}  // namespace
+
+void PngUnfilterRow(uint8_t filter_type,
+                    pdfium::span<const uint8_t> src,
+                    pdfium::span<const uint8_t> prev,
+                    uint32_t bytes_per_pixel,
+                    pdfium::span<uint8_t> dest) {
+  CheckRowSizes(src, prev, dest);
+  const uint8_t* prev_data = prev.empty() ? nullptr : prev.data();
+  size_t done = 0;
+#if defined(PREDICTOR_USE_SSE2)
+  done = PngUnfilterRowSse2(filter_type, src.data(), prev_data,
+                            bytes_per_pixel, dest.data(), src.size());
+#endif
+  PngUnfilterBytes(filter_type, src.data(), prev_data, bytes_per_pixel,
+                   dest.data(), done, src.size());
+}
+
+void TiffUnpredictRow8(pdfium::span<uint8_t> row, uint32_t bytes_per_pixel) {
+  size_t done = 0;
+#if defined(PREDICTOR_USE_SSE2)
+  // This is PNG's Sub filter, in place.
+  if (bytes_per_pixel == 3)
+    done = UnfilterSubSse2<3>(row.data(), row.data(), row.size());
+  else if (bytes_per_pixel == 4)
+    done = UnfilterSubSse2<4>(row.data(), row.data(), row.size());
+#endif
+  TiffUnpredictBytes(row.data(), bytes_per_pixel, done, row.size());
+}
+
+void PngUnfilterRowScalarForTesting(uint8_t filter_type,
+                                    pdfium::span<const uint8_t> src,
+                                    pdfium::span<const uint8_t> prev,
+                                    uint32_t bytes_per_pixel,
+                                    pdfium::span<uint8_t> dest) {
+  CheckRowSizes(src, prev, dest);
+  PngUnfilterBytes(filter_type, src.data(),
+                   prev.empty() ? nullptr : prev.data(), bytes_per_pixel,
+                   dest.data(), 0, src.size());
+}
+
+void TiffUnpredictRow8ScalarForTesting(pdfium::span<uint8_t> row,
+                                       uint32_t bytes_per_pixel) {
+  TiffUnpredictBytes(row.data(), bytes_per_pixel, 0, row.size());
+}
+
+}  // namespace fxcodec
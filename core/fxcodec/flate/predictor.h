@@ -0,0 +1,39 @@
+// Copyright 2021 PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FXCODEC_FLATE_PREDICTOR_H_
+#define CORE_FXCODEC_FLATE_PREDICTOR_H_
+
+#include <stdint.h>
+
+#include "third_party/base/span.h"
+
+namespace fxcodec {
+
+// Reverses the PNG filter |filter_type| for one row. |src| holds the filtered
+// bytes of the row, without the filter type byte, and |dest| receives as many
+// unfiltered bytes. |prev| holds the unfiltered previous row, at least as long
+// as |src|, or is empty for the first row. Unknown filter types copy the row.
+// Uses SIMD instructions for common pixel sizes where available.
+void PngUnfilterRow(uint8_t filter_type,
+                    pdfium::span<const uint8_t> src,
+                    pdfium::span<const uint8_t> prev,
+                    uint32_t bytes_per_pixel,
+                    pdfium::span<uint8_t> dest);
+
+// Reverses TIFF predictor 2 in place for one row of 8-bit components.
+void TiffUnpredictRow8(pdfium::span<uint8_t> row, uint32_t bytes_per_pixel);
+
+// Versions of the above that never use SIMD instructions, for testing.
+void PngUnfilterRowScalarForTesting(uint8_t filter_type,
+                                    pdfium::span<const uint8_t> src,
+                                    pdfium::span<const uint8_t> prev,
+                                    uint32_t bytes_per_pixel,
+                                    pdfium::span<uint8_t> dest);
+void TiffUnpredictRow8ScalarForTesting(pdfium::span<uint8_t> row,
+                                       uint32_t bytes_per_pixel);
+
+}  // namespace fxcodec
+
+#endif  // CORE_FXCODEC_FLATE_PREDICTOR_H_
@@ -0,0 +1,95 @@
+// Copyright 2021 PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxcodec/flate/predictor.h"
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace fxcodec {
+
+namespace {
+
+std::vector<uint8_t> MakeRow(size_t size, uint32_t seed) {
+  std::vector<uint8_t> row(size);
+  for (size_t i = 0; i < size; ++i) {
+    seed = seed * 1103515245 + 12345;
+    row[i] = static_cast<uint8_t>(seed >> 16);
+  }
+  return row;
+}
+
+}  // namespace
+
+TEST(Predictor, PngUnfilterRow) {
+  const uint8_t kSrc[] = {10, 20, 30, 40, 250, 250};
+  const uint8_t kPrev[] = {1, 2, 3, 4, 5, 6};
+  uint8_t dest[6];
+
+  PngUnfilterRow(0, kSrc, kPrev, 2, dest);
+  EXPECT_EQ(std::vector<uint8_t>({10, 20, 30, 40, 250, 250}),
+            std::vector<uint8_t>(dest, dest + 6));
+
+  PngUnfilterRow(1, kSrc, kPrev, 2, dest);
+  EXPECT_EQ(std::vector<uint8_t>({10, 20, 40, 60, 34, 54}),
+            std::vector<uint8_t>(dest, dest + 6));
+
+  PngUnfilterRow(2, kSrc, kPrev, 2, dest);
+  EXPECT_EQ(std::vector<uint8_t>({11, 22, 33, 44, 255, 0}),
+            std::vector<uint8_t>(dest, dest + 6));
+
+  // Without a previous row, Up copies the row.
+  PngUnfilterRow(2, kSrc, {}, 2, dest);
+  EXPECT_EQ(std::vector<uint8_t>({10, 20, 30, 40, 250, 250}),
+            std::vector<uint8_t>(dest, dest + 6));
+
+  PngUnfilterRow(3, kSrc, kPrev, 2, dest);
+  EXPECT_EQ(std::vector<uint8_t>({10, 21, 36, 52, 14, 23}),
+            std::vector<uint8_t>(dest, dest + 6));
+
+  PngUnfilterRow(4, kSrc, kPrev, 2, dest);
+  EXPECT_EQ(std::vector<uint8_t>({11, 22, 41, 62, 35, 56}),
+            std::vector<uint8_t>(dest, dest + 6));
+}
+
+TEST(Predictor, PngUnfilterRowMatchesScalar) {
+  for (uint8_t filter_type = 0; filter_type <= 5; ++filter_type) {
+    for (uint32_t bpp = 1; bpp <= 8; ++bpp) {
+      for (size_t size : {0, 1, 3, 4, 15, 16, 17, 33, 100, 1027}) {
+        SCOPED_TRACE(testing::Message() << "filter " << int{filter_type}
+                                        << ", bpp " << bpp << ", size "
+                                        << size);
+        std::vector<uint8_t> src = MakeRow(size, size + bpp);
+        std::vector<uint8_t> prev = MakeRow(size, filter_type);
+        std::vector<uint8_t> dest(size);
+        std::vector<uint8_t> expected(size);
+        PngUnfilterRow(filter_type, src, prev, bpp, dest);
+        PngUnfilterRowScalarForTesting(filter_type, src, prev, bpp, expected);
+        EXPECT_EQ(expected, dest);
+
+        PngUnfilterRow(filter_type, src, {}, bpp, dest);
+        PngUnfilterRowScalarForTesting(filter_type, src, {}, bpp, expected);
+        EXPECT_EQ(expected, dest);
+      }
+    }
+  }
+}
+
+TEST(Predictor, TiffUnpredictRow8MatchesScalar) {
+  for (uint32_t bpp = 1; bpp <= 8; ++bpp) {
+    for (size_t size : {0, 1, 3, 4, 15, 16, 17, 33, 100, 1027}) {
+      SCOPED_TRACE(testing::Message() << "bpp " << bpp << ", size " << size);
+      std::vector<uint8_t> row = MakeRow(size, bpp);
+      std::vector<uint8_t> expected = row;
+      TiffUnpredictRow8(row, bpp);
+      TiffUnpredictRow8ScalarForTesting(expected, bpp);
+      EXPECT_EQ(expected, row);
+    }
+  }
+}
+
+}  // namespace fxcodec
@@ -0,0 +1,88 @@
+// Copyright 2021 PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxcrt/cfx_mappedfilestream_posix.h"
+
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "core/fxcrt/fx_safe_types.h"
+
+#ifndef O_BINARY
+#define O_BINARY 0
+#endif  // O_BINARY
+
+#ifndef O_LARGEFILE
+#define O_LARGEFILE 0
+#endif  // O_LARGEFILE
+
+// static
+RetainPtr<CFX_MappedFileStream_Posix> CFX_MappedFileStream_Posix::Create(
+    const char* filename) {
+  int fd = open(filename, O_RDONLY | O_BINARY | O_LARGEFILE);
+  if (fd < 0)
+    return nullptr;
+
+  // Only map files that are unlikely to change underneath the mapping.
+  // Anything but a regular file, e.g. a pipe or a device, may not even have a
+  // stable size, and a file that anyone may write to could be truncated at
+  // any time.
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) < 0 || !S_ISREG(file_stat.st_mode) ||
+      (file_stat.st_mode & S_IWOTH) || file_stat.st_size <= 0) {
+    close(fd);
+    return nullptr;
+  }
+
+  FX_SAFE_SIZE_T safe_size = file_stat.st_size;
+  if (!safe_size.IsValid()) {
+    close(fd);
+    return nullptr;
+  }
+
+  const size_t size = safe_size.ValueOrDie();
+  void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  // The mapping holds its own reference to the file.
+  close(fd);
+  if (data == MAP_FAILED)
+    return nullptr;
+
+  return pdfium::MakeRetain<CFX_MappedFileStream_Posix>(
+      pdfium::make_span(static_cast<const uint8_t*>(data), size));
+}
+
+CFX_MappedFileStream_Posix::CFX_MappedFileStream_Posix(
+    pdfium::span<const uint8_t> mapping)
+    : m_Mapping(mapping) {}
+
+CFX_MappedFileStream_Posix::~CFX_MappedFileStream_Posix() {
+  munmap(const_cast<uint8_t*>(m_Mapping.data()), m_Mapping.size());
+}
+
+FX_FILESIZE CFX_MappedFileStream_Posix::GetSize() {
+  return pdfium::base::checked_cast<FX_FILESIZE>(m_Mapping.size());
+}
+
+pdfium::span<const uint8_t> CFX_MappedFileStream_Posix::GetSpan() {
+  return m_Mapping;
+}
+
+bool CFX_MappedFileStream_Posix::ReadBlockAtOffset(void* buffer,
+                                                   FX_FILESIZE offset,
+                                                   size_t size) {
+  if (!buffer || offset < 0 || size == 0)
+    return false;
+
+  FX_SAFE_SIZE_T pos = size;
+  pos += offset;
+  if (!pos.IsValid() || pos.ValueOrDie() > m_Mapping.size())
+    return false;
+
+  auto copy_span = m_Mapping.subspan(offset, size);
+  memcpy(buffer, copy_span.data(), copy_span.size());
+  return true;
+}
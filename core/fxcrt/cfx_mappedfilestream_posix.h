@@ -0,0 +1,47 @@
+// Copyright 2021 PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FXCRT_CFX_MAPPEDFILESTREAM_POSIX_H_
+#define CORE_FXCRT_CFX_MAPPEDFILESTREAM_POSIX_H_
+
+#include "build/build_config.h"
+#include "core/fxcrt/fx_stream.h"
+#include "core/fxcrt/retain_ptr.h"
+#include "third_party/base/span.h"
+
+#if !defined(OS_POSIX)
+#error "Included on the wrong platform"
+#endif
+
+// Read-only stream over a file mapped into memory. Reads are plain copies out
+// of the mapping, and GetSpan() exposes the mapping itself so that parsers
+// can consume file bytes without copying them at all.
+//
+// The file must not be truncated while the stream is alive, as reading past
+// its new end raises SIGBUS. Use IFX_SeekableReadStream::CreateFromFilename()
+// unless the caller knows the file stays put.
+class CFX_MappedFileStream_Posix final : public IFX_SeekableReadStream {
+ public:
+  // Returns nullptr if |filename| cannot be opened or mapped, e.g. because it
+  // is empty or too large for the address space, or should not be mapped
+  // because it is not a regular file or is world-writable.
+  static RetainPtr<CFX_MappedFileStream_Posix> Create(const char* filename);
+
+  CONSTRUCT_VIA_MAKE_RETAIN;
+
+  // IFX_SeekableReadStream:
+  FX_FILESIZE GetSize() override;
+  pdfium::span<const uint8_t> GetSpan() override;
+  bool ReadBlockAtOffset(void* buffer,
+                         FX_FILESIZE offset,
+                         size_t size) override;
+
+ private:
+  explicit CFX_MappedFileStream_Posix(pdfium::span<const uint8_t> mapping);
+  ~CFX_MappedFileStream_Posix() override;
+
+  const pdfium::span<const uint8_t> m_Mapping;
+};
+
+#endif  // CORE_FXCRT_CFX_MAPPEDFILESTREAM_POSIX_H_
@@ -0,0 +1,92 @@
+// Copyright 2021 PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxcrt/cfx_mappedfilestream_posix.h"
+
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "core/fxcrt/fx_stream.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/utils/path_service.h"
+
+TEST(CFX_MappedFileStream_Posix, ReadMatchesFileStream) {
+  std::string path;
+  ASSERT_TRUE(PathService::GetTestFilePath("hello_world.pdf", &path));
+
+  RetainPtr<CFX_MappedFileStream_Posix> mapped =
+      CFX_MappedFileStream_Posix::Create(path.c_str());
+  ASSERT_TRUE(mapped);
+  RetainPtr<IFX_SeekableStream> file =
+      IFX_SeekableStream::CreateFromFilename(path.c_str(),
+                                             FX_FILEMODE_ReadOnly);
+  ASSERT_TRUE(file);
+  ASSERT_EQ(file->GetSize(), mapped->GetSize());
+
+  const size_t size = static_cast<size_t>(file->GetSize());
+  std::vector<uint8_t> expected(size);
+  ASSERT_TRUE(file->ReadBlockAtOffset(expected.data(), 0, size));
+
+  pdfium::span<const uint8_t> span = mapped->GetSpan();
+  EXPECT_EQ(expected, std::vector<uint8_t>(span.begin(), span.end()));
+
+  std::vector<uint8_t> buf(10);
+  ASSERT_TRUE(mapped->ReadBlockAtOffset(buf.data(), size - 10, 10));
+  EXPECT_TRUE(std::equal(buf.begin(), buf.end(), expected.end() - 10));
+  EXPECT_FALSE(mapped->ReadBlockAtOffset(buf.data(), size - 9, 10));
+  EXPECT_FALSE(mapped->ReadBlockAtOffset(buf.data(), -1, 1));
+}
+
+TEST(CFX_MappedFileStream_Posix, CreateFailures) {
+  EXPECT_FALSE(CFX_MappedFileStream_Posix::Create("no_such_file.pdf"));
+
+  std::string path;
+  ASSERT_TRUE(PathService::GetTestDataDir(&path));
+  EXPECT_FALSE(CFX_MappedFileStream_Posix::Create(path.c_str()));
+}
+
+TEST(CFX_MappedFileStream_Posix, RejectsWorldWritableFiles) {
+  char path[] = "/tmp/pdfium_mapped_XXXXXX";
+  int fd = mkstemp(path);
+  ASSERT_GE(fd, 0);
+  static const char kData[] = "%PDF-1.7";
+  ASSERT_EQ(static_cast<ssize_t>(sizeof(kData)),
+            write(fd, kData, sizeof(kData)));
+  close(fd);
+
+  ASSERT_EQ(0, chmod(path, 0600));
+  EXPECT_TRUE(CFX_MappedFileStream_Posix::Create(path));
+
+  ASSERT_EQ(0, chmod(path, 0666));
+  EXPECT_FALSE(CFX_MappedFileStream_Posix::Create(path));
+
+  // The mapped factory falls back to reading such files.
+  RetainPtr<IFX_SeekableReadStream> stream =
+      IFX_SeekableReadStream::CreateMappedFromFilename(path);
+  ASSERT_TRUE(stream);
+  EXPECT_TRUE(stream->GetSpan().empty());
+  EXPECT_EQ(static_cast<FX_FILESIZE>(sizeof(kData)), stream->GetSize());
+
+  unlink(path);
+}
+
+TEST(CFX_MappedFileStream_Posix, NotUsedByDefault) {
+  std::string path;
+  ASSERT_TRUE(PathService::GetTestFilePath("hello_world.pdf", &path));
+
+  RetainPtr<IFX_SeekableReadStream> stream =
+      IFX_SeekableReadStream::CreateFromFilename(path.c_str());
+  ASSERT_TRUE(stream);
+  EXPECT_TRUE(stream->GetSpan().empty());
+
+  stream = IFX_SeekableReadStream::CreateMappedFromFilename(path.c_str());
+  ASSERT_TRUE(stream);
+  EXPECT_EQ(stream->GetSize(),
+            static_cast<FX_FILESIZE>(stream->GetSpan().size()));
+}
@@ -25,6 +25,10 @@ FX_FILESIZE CFX_ReadOnlyMemoryStream::GetSize() {
   return pdfium::base::checked_cast<FX_FILESIZE>(m_span.size());
 }
 
+pdfium::span<const uint8_t> CFX_ReadOnlyMemoryStream::GetSpan() {
+  return m_span;
+}
+
 bool CFX_ReadOnlyMemoryStream::ReadBlockAtOffset(void* buffer,
                                                  FX_FILESIZE offset,
                                                  size_t size) {
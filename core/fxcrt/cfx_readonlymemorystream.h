@@ -20,6 +20,7 @@ class CFX_ReadOnlyMemoryStream final : public IFX_SeekableReadStream {
 
   // IFX_SeekableReadStream:
   FX_FILESIZE GetSize() override;
+  pdfium::span<const uint8_t> GetSpan() override;
   bool ReadBlockAtOffset(void* buffer,
                          FX_FILESIZE offset,
                          size_t size) override;
@@ -0,0 +1,211 @@
+// Copyright 2021 PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FXCRT_FLAT_INDEX_MAP_H_
+#define CORE_FXCRT_FLAT_INDEX_MAP_H_
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "third_party/base/check.h"
+
+namespace fxcrt {
+
+// An ordered map keyed by small unsigned integers, such as PDF object
+// numbers. Keys that are reasonably densely packed live in a vector indexed
+// by key, so lookups are O(1) and there is no per-entry node allocation.
+// Keys that would make the vector too sparse fall back to a std::map. All
+// keys in the sparse part are larger than any index in the dense part, so
+// iteration visits keys in ascending order.
+//
+// Unlike std::map, references to values are invalidated by insertion.
+template <typename V>
+class FlatIndexMap {
+ public:
+  // The dense part may always grow to at least this many slots, regardless
+  // of how many entries are present.
+  static constexpr uint32_t kMinDenseSize = 1024;
+
+  class const_iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = std::pair<uint32_t, const V&>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = value_type;
+
+    value_type operator*() const {
+      if (dense_index_ < map_->dense_.size())
+        return value_type(dense_index_, map_->dense_[dense_index_]);
+      return value_type(sparse_it_->first, sparse_it_->second);
+    }
+
+    const_iterator& operator++() {
+      if (dense_index_ < map_->dense_.size()) {
+        ++dense_index_;
+        SkipAbsent();
+      } else {
+        ++sparse_it_;
+      }
+      return *this;
+    }
+
+    bool operator==(const const_iterator& that) const {
+      return dense_index_ == that.dense_index_ && sparse_it_ == that.sparse_it_;
+    }
+    bool operator!=(const const_iterator& that) const {
+      return !(*this == that);
+    }
+
+   private:
+    friend class FlatIndexMap;
+
+    const_iterator(const FlatIndexMap* map,
+                   size_t dense_index,
+                   typename std::map<uint32_t, V>::const_iterator sparse_it)
+        : map_(map), dense_index_(dense_index), sparse_it_(sparse_it) {
+      SkipAbsent();
+    }
+
+    void SkipAbsent() {
+      while (dense_index_ < map_->present_.size() &&
+             !map_->present_[dense_index_]) {
+        ++dense_index_;
+      }
+    }
+
+    const FlatIndexMap* map_;
+    size_t dense_index_;
+    typename std::map<uint32_t, V>::const_iterator sparse_it_;
+  };
+
+  FlatIndexMap() = default;
+  FlatIndexMap(const FlatIndexMap& that) = default;
+  FlatIndexMap(FlatIndexMap&& that) noexcept = default;
+  ~FlatIndexMap() = default;
+
+  FlatIndexMap& operator=(const FlatIndexMap& that) = default;
+  FlatIndexMap& operator=(FlatIndexMap&& that) noexcept = default;
+
+  const_iterator begin() const {
+    return const_iterator(this, 0, sparse_.begin());
+  }
+  const_iterator end() const {
+    return const_iterator(this, dense_.size(), sparse_.end());
+  }
+
+  bool empty() const { return size() == 0; }
+  size_t size() const { return dense_count_ + sparse_.size(); }
+
+  bool Contains(uint32_t key) const { return !!Find(key); }
+
+  const V* Find(uint32_t key) const {
+    if (key < dense_.size())
+      return present_[key] ? &dense_[key] : nullptr;
+    auto it = sparse_.find(key);
+    return it != sparse_.end() ? &it->second : nullptr;
+  }
+
+  V* Find(uint32_t key) {
+    return const_cast<V*>(static_cast<const FlatIndexMap*>(this)->Find(key));
+  }
+
+  // Returns the value for |key|, inserting a default-constructed value if
+  // there is none yet.
+  V& operator[](uint32_t key) {
+    if (key >= dense_.size() && ShouldGrowDenseTo(key))
+      GrowDenseTo(key);
+    if (key < dense_.size()) {
+      if (!present_[key]) {
+        present_[key] = true;
+        ++dense_count_;
+      }
+      return dense_[key];
+    }
+    return sparse_[key];
+  }
+
+  void Erase(uint32_t key) {
+    if (key >= dense_.size()) {
+      sparse_.erase(key);
+      return;
+    }
+    if (!present_[key])
+      return;
+    present_[key] = false;
+    dense_[key] = V();
+    --dense_count_;
+    TrimDense();
+  }
+
+  // Erases all entries with keys greater than or equal to |key|.
+  void EraseFrom(uint32_t key) {
+    sparse_.erase(sparse_.lower_bound(key), sparse_.end());
+    if (key >= dense_.size())
+      return;
+    dense_count_ -= std::count(present_.begin() + key, present_.end(), true);
+    dense_.resize(key);
+    present_.resize(key);
+    TrimDense();
+  }
+
+  void clear() {
+    dense_.clear();
+    present_.clear();
+    dense_count_ = 0;
+    sparse_.clear();
+  }
+
+  // Returns the largest key in the map, which must not be empty.
+  uint32_t GetLastKey() const {
+    DCHECK(!empty());
+    if (!sparse_.empty())
+      return sparse_.rbegin()->first;
+    return static_cast<uint32_t>(dense_.size() - 1);
+  }
+
+ private:
+  // Keep the dense part at least half full once it is past its minimum size.
+  bool ShouldGrowDenseTo(uint32_t key) const {
+    return key < std::max<size_t>(kMinDenseSize, 2 * (size() + 1));
+  }
+
+  void GrowDenseTo(uint32_t key) {
+    const size_t new_size = static_cast<size_t>(key) + 1;
+    dense_.resize(new_size);
+    present_.resize(new_size);
+    while (!sparse_.empty() && sparse_.begin()->first < new_size) {
+      auto it = sparse_.begin();
+      dense_[it->first] = std::move(it->second);
+      present_[it->first] = true;
+      ++dense_count_;
+      sparse_.erase(it);
+    }
+  }
+
+  // Drops absent slots from the end, so the last dense slot, if any, is
+  // always present.
+  void TrimDense() {
+    while (!present_.empty() && !present_.back()) {
+      dense_.pop_back();
+      present_.pop_back();
+    }
+  }
+
+  std::vector<V> dense_;
+  std::vector<bool> present_;
+  size_t dense_count_ = 0;
+  std::map<uint32_t, V> sparse_;
+};
+
+}  // namespace fxcrt
+
+using fxcrt::FlatIndexMap;
+
+#endif  // CORE_FXCRT_FLAT_INDEX_MAP_H_
@@ -0,0 +1,128 @@
+// Copyright 2021 PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxcrt/flat_index_map.h"
+
+#include <utility>
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace fxcrt {
+
+namespace {
+
+std::vector<std::pair<uint32_t, int>> ToVector(const FlatIndexMap<int>& map) {
+  std::vector<std::pair<uint32_t, int>> result;
+  for (const auto& entry : map)
+    result.emplace_back(entry.first, entry.second);
+  return result;
+}
+
+}  // namespace
+
+TEST(FlatIndexMap, Empty) {
+  FlatIndexMap<int> map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(0u, map.size());
+  EXPECT_FALSE(map.Contains(0));
+  EXPECT_FALSE(map.Find(1));
+  EXPECT_EQ(map.begin(), map.end());
+}
+
+TEST(FlatIndexMap, InsertAndFind) {
+  FlatIndexMap<int> map;
+  map[3] = 30;
+  map[1] = 10;
+  EXPECT_FALSE(map.empty());
+  EXPECT_EQ(2u, map.size());
+  EXPECT_FALSE(map.Contains(0));
+  EXPECT_FALSE(map.Contains(2));
+  ASSERT_TRUE(map.Find(1));
+  EXPECT_EQ(10, *map.Find(1));
+  ASSERT_TRUE(map.Find(3));
+  EXPECT_EQ(30, *map.Find(3));
+  EXPECT_EQ(3u, map.GetLastKey());
+
+  // Default-constructed values still count as present.
+  map[2];
+  EXPECT_EQ(3u, map.size());
+  ASSERT_TRUE(map.Find(2));
+  EXPECT_EQ(0, *map.Find(2));
+}
+
+TEST(FlatIndexMap, SparseKeys) {
+  FlatIndexMap<int> map;
+  map[5] = 50;
+  map[4000000000u] = 1;
+  map[70000] = 2;
+  EXPECT_EQ(3u, map.size());
+  EXPECT_EQ(4000000000u, map.GetLastKey());
+  ASSERT_TRUE(map.Find(70000));
+  EXPECT_EQ(2, *map.Find(70000));
+
+  std::vector<std::pair<uint32_t, int>> expected = {
+      {5, 50}, {70000, 2}, {4000000000u, 1}};
+  EXPECT_EQ(expected, ToVector(map));
+}
+
+TEST(FlatIndexMap, SparseKeysMigrateWhenDense) {
+  FlatIndexMap<int> map;
+  map[3000] = 3000;
+  for (uint32_t i = 0; i < 2000; ++i)
+    map[i] = i;
+  EXPECT_EQ(2001u, map.size());
+  EXPECT_EQ(3000u, map.GetLastKey());
+
+  std::vector<std::pair<uint32_t, int>> result = ToVector(map);
+  ASSERT_EQ(2001u, result.size());
+  for (uint32_t i = 0; i < 2000; ++i)
+    EXPECT_EQ(std::make_pair(i, static_cast<int>(i)), result[i]);
+  EXPECT_EQ(std::make_pair(3000u, 3000), result[2000]);
+}
+
+TEST(FlatIndexMap, Erase) {
+  FlatIndexMap<int> map;
+  map[1] = 10;
+  map[2] = 20;
+  map[100000] = 30;
+  map.Erase(2);
+  map.Erase(7);
+  map.Erase(100000);
+  EXPECT_EQ(1u, map.size());
+  EXPECT_FALSE(map.Contains(2));
+  EXPECT_FALSE(map.Contains(100000));
+  EXPECT_EQ(1u, map.GetLastKey());
+
+  // Re-inserting an erased key yields a fresh value.
+  EXPECT_EQ(0, map[2]);
+}
+
+TEST(FlatIndexMap, EraseFrom) {
+  FlatIndexMap<int> map;
+  map[1] = 10;
+  map[5] = 50;
+  map[9] = 90;
+  map[100000] = 1;
+  map.EraseFrom(5);
+  EXPECT_EQ(1u, map.size());
+  EXPECT_TRUE(map.Contains(1));
+  EXPECT_FALSE(map.Contains(5));
+  EXPECT_FALSE(map.Contains(9));
+  EXPECT_FALSE(map.Contains(100000));
+
+  map.EraseFrom(0);
+  EXPECT_TRUE(map.empty());
+}
+
+TEST(FlatIndexMap, Clear) {
+  FlatIndexMap<int> map;
+  map[1] = 10;
+  map[100000] = 1;
+  map.clear();
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.begin(), map.end());
+}
+
+}  // namespace fxcrt
@@ -15,6 +15,10 @@
 #include "core/fxcrt/fx_safe_types.h"
 #include "core/fxcrt/unowned_ptr.h"
 
+#if defined(OS_POSIX)
+#include "core/fxcrt/cfx_mappedfilestream_posix.h"
+#endif
+
 #if defined(OS_WIN)
 #include <direct.h>
 
@@ -96,6 +100,18 @@ RetainPtr<IFX_SeekableReadStream> IFX_SeekableReadStream::CreateFromFilename(
   return IFX_SeekableStream::CreateFromFilename(filename, FX_FILEMODE_ReadOnly);
 }
 
+// static
+RetainPtr<IFX_SeekableReadStream>
+IFX_SeekableReadStream::CreateMappedFromFilename(const char* filename) {
+#if defined(OS_POSIX)
+  RetainPtr<IFX_SeekableReadStream> mapped =
+      CFX_MappedFileStream_Posix::Create(filename);
+  if (mapped)
+    return mapped;
+#endif
+  return CreateFromFilename(filename);
+}
+
 bool IFX_SeekableWriteStream::WriteBlock(const void* pData, size_t size) {
   return WriteBlockAtOffset(pData, GetSize(), size);
 }
@@ -112,6 +128,15 @@ size_t IFX_SeekableReadStream::ReadBlock(void* buffer, size_t size) {
   return 0;
 }
 
+pdfium::span<const uint8_t> IFX_SeekableReadStream::GetSpan() {
+  return {};
+}
+
+bool IFX_SeekableReadStream::NeedToWaitForData(FX_FILESIZE offset,
+                                               size_t size) {
+  return false;
+}
+
 bool IFX_SeekableStream::WriteBlock(const void* buffer, size_t size) {
   return WriteBlockAtOffset(buffer, GetSize(), size);
 }
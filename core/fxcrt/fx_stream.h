@@ -11,6 +11,7 @@
 #include "core/fxcrt/fx_system.h"
 #include "core/fxcrt/retain_ptr.h"
 #include "third_party/base/compiler_specific.h"
+#include "third_party/base/span.h"
 
 struct FX_FolderHandle;
 
@@ -70,10 +71,29 @@ class IFX_SeekableReadStream : virtual public Retainable,
   static RetainPtr<IFX_SeekableReadStream> CreateFromFilename(
       const char* filename);
 
+  // Same as CreateFromFilename(), but maps the file into memory where the
+  // platform supports it, so GetSpan() can expose its contents. Only use this
+  // for files that nothing truncates while the stream is alive: touching a
+  // mapped page past the new end of the file is a fatal SIGBUS on POSIX.
+  // Falls back to CreateFromFilename() for files that cannot be mapped safely.
+  static RetainPtr<IFX_SeekableReadStream> CreateMappedFromFilename(
+      const char* filename);
+
   virtual bool IsEOF();
   virtual FX_FILESIZE GetPosition();
   virtual size_t ReadBlock(void* buffer, size_t size);
 
+  // Returns the entire contents of the stream when they are directly
+  // addressable, e.g. for in-memory or memory-mapped streams, so callers can
+  // avoid copying. Returns an empty span otherwise. The span remains valid
+  // for the lifetime of the stream.
+  virtual pdfium::span<const uint8_t> GetSpan();
+
+  // Returns true if reading |size| bytes at |offset| has to wait for data the
+  // stream loads asynchronously, after requesting that data. Returns false if
+  // the read can be made right away, whether or not it succeeds.
+  virtual bool NeedToWaitForData(FX_FILESIZE offset, size_t size);
+
   virtual bool ReadBlockAtOffset(void* buffer,
                                  FX_FILESIZE offset,
                                  size_t size) WARN_UNUSED_RESULT = 0;
@@ -0,0 +1,204 @@
+// Copyright 2021 PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FXCRT_SMALL_FLAT_MAP_H_
+#define CORE_FXCRT_SMALL_FLAT_MAP_H_
+
+#include <stddef.h>
+
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace fxcrt {
+
+// An ordered map for containers that are usually small, such as PDF
+// dictionaries. Up to |kMaxFlatSize| entries live in a sorted vector, so
+// there is no per-entry node allocation and lookups are a binary search over
+// contiguous memory. A map that grows past that switches to a std::map and
+// stays there. Either way, iteration visits keys in ascending order.
+//
+// Unlike std::map, insertion and erasure invalidate all iterators and
+// references into the map.
+template <typename K, typename V, size_t kMaxFlatSize = 16>
+class SmallFlatMap {
+ private:
+  using FlatStorage = std::vector<std::pair<K, V>>;
+  using TreeStorage = std::map<K, V>;
+
+  template <bool kIsConst>
+  class Iterator {
+   public:
+    using MappedRef = typename std::conditional<kIsConst, const V&, V&>::type;
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = std::pair<const K&, MappedRef>;
+    using difference_type = std::ptrdiff_t;
+    using reference = value_type;
+
+    class pointer {
+     public:
+      explicit pointer(const value_type& value) : value_(value) {}
+      const value_type* operator->() const { return &value_; }
+
+     private:
+      value_type value_;
+    };
+
+    Iterator() = default;
+
+    value_type operator*() const {
+      if (in_tree_)
+        return value_type(tree_it_->first, tree_it_->second);
+      return value_type(flat_it_->first, flat_it_->second);
+    }
+
+    pointer operator->() const { return pointer(**this); }
+
+    Iterator& operator++() {
+      if (in_tree_)
+        ++tree_it_;
+      else
+        ++flat_it_;
+      return *this;
+    }
+
+    bool operator==(const Iterator& that) const {
+      return in_tree_ == that.in_tree_ && flat_it_ == that.flat_it_ &&
+             tree_it_ == that.tree_it_;
+    }
+    bool operator!=(const Iterator& that) const { return !(*this == that); }
+
+   private:
+    friend class SmallFlatMap;
+
+    using FlatIterator =
+        typename std::conditional<kIsConst,
+                                  typename FlatStorage::const_iterator,
+                                  typename FlatStorage::iterator>::type;
+    using TreeIterator =
+        typename std::conditional<kIsConst,
+                                  typename TreeStorage::const_iterator,
+                                  typename TreeStorage::iterator>::type;
+
+    explicit Iterator(FlatIterator flat_it) : flat_it_(flat_it) {}
+    explicit Iterator(TreeIterator tree_it)
+        : in_tree_(true), tree_it_(tree_it) {}
+
+    bool in_tree_ = false;
+    FlatIterator flat_it_{};
+    TreeIterator tree_it_{};
+  };
+
+ public:
+  using iterator = Iterator<false>;
+  using const_iterator = Iterator<true>;
+
+  SmallFlatMap() = default;
+  SmallFlatMap(const SmallFlatMap& that) = delete;
+  SmallFlatMap(SmallFlatMap&& that) noexcept = default;
+  ~SmallFlatMap() = default;
+
+  SmallFlatMap& operator=(const SmallFlatMap& that) = delete;
+  SmallFlatMap& operator=(SmallFlatMap&& that) noexcept = default;
+
+  iterator begin() {
+    return tree_ ? iterator(tree_->begin()) : iterator(flat_.begin());
+  }
+  iterator end() {
+    return tree_ ? iterator(tree_->end()) : iterator(flat_.end());
+  }
+  const_iterator begin() const {
+    return tree_ ? const_iterator(tree_->cbegin())
+                 : const_iterator(flat_.cbegin());
+  }
+  const_iterator end() const {
+    return tree_ ? const_iterator(tree_->cend()) : const_iterator(flat_.cend());
+  }
+
+  bool empty() const { return size() == 0; }
+  size_t size() const { return tree_ ? tree_->size() : flat_.size(); }
+  bool IsFlatForTesting() const { return !tree_; }
+
+  bool Contains(const K& key) const { return !!Find(key); }
+
+  const V* Find(const K& key) const {
+    if (tree_) {
+      auto it = tree_->find(key);
+      return it != tree_->end() ? &it->second : nullptr;
+    }
+    auto it = FlatLowerBound(key);
+    return it != flat_.end() && !(key < it->first) ? &it->second : nullptr;
+  }
+
+  V* Find(const K& key) {
+    return const_cast<V*>(static_cast<const SmallFlatMap*>(this)->Find(key));
+  }
+
+  // Returns the value for |key|, inserting a default-constructed value if
+  // there is none yet.
+  V& operator[](const K& key) {
+    if (tree_)
+      return (*tree_)[key];
+
+    auto it = FlatLowerBound(key);
+    if (it != flat_.end() && !(key < it->first))
+      return it->second;
+
+    if (flat_.size() < kMaxFlatSize)
+      return flat_.emplace(it, key, V())->second;
+
+    MoveToTree();
+    return (*tree_)[key];
+  }
+
+  // Returns whether there was an entry for |key|.
+  bool Erase(const K& key) {
+    if (tree_)
+      return tree_->erase(key) > 0;
+
+    auto it = FlatLowerBound(key);
+    if (it == flat_.end() || key < it->first)
+      return false;
+    flat_.erase(it);
+    return true;
+  }
+
+  void clear() {
+    flat_.clear();
+    tree_.reset();
+  }
+
+ private:
+  static bool EntryKeyLess(const std::pair<K, V>& entry, const K& key) {
+    return entry.first < key;
+  }
+
+  typename FlatStorage::const_iterator FlatLowerBound(const K& key) const {
+    return std::lower_bound(flat_.begin(), flat_.end(), key, EntryKeyLess);
+  }
+
+  typename FlatStorage::iterator FlatLowerBound(const K& key) {
+    return std::lower_bound(flat_.begin(), flat_.end(), key, EntryKeyLess);
+  }
+
+  void MoveToTree() {
+    tree_ = std::make_unique<TreeStorage>();
+    for (auto& entry : flat_)
+      tree_->emplace_hint(tree_->end(), std::move(entry));
+    FlatStorage().swap(flat_);
+  }
+
+  FlatStorage flat_;
+  std::unique_ptr<TreeStorage> tree_;
+};
+
+}  // namespace fxcrt
+
+using fxcrt::SmallFlatMap;
+
+#endif  // CORE_FXCRT_SMALL_FLAT_MAP_H_
@@ -0,0 +1,141 @@
+// Copyright 2021 PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxcrt/small_flat_map.h"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace fxcrt {
+
+namespace {
+
+using TestMap = SmallFlatMap<int, int, 4>;
+
+std::vector<std::pair<int, int>> ToVector(const TestMap& map) {
+  std::vector<std::pair<int, int>> result;
+  for (const auto& entry : map)
+    result.emplace_back(entry.first, entry.second);
+  return result;
+}
+
+}  // namespace
+
+TEST(SmallFlatMap, Empty) {
+  TestMap map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(0u, map.size());
+  EXPECT_FALSE(map.Contains(0));
+  EXPECT_FALSE(map.Find(1));
+  EXPECT_FALSE(map.Erase(1));
+  EXPECT_EQ(map.begin(), map.end());
+}
+
+TEST(SmallFlatMap, InsertAndFind) {
+  TestMap map;
+  map[3] = 30;
+  map[1] = 10;
+  EXPECT_TRUE(map.IsFlatForTesting());
+  EXPECT_EQ(2u, map.size());
+  EXPECT_FALSE(map.Contains(2));
+  ASSERT_TRUE(map.Find(1));
+  EXPECT_EQ(10, *map.Find(1));
+  ASSERT_TRUE(map.Find(3));
+  EXPECT_EQ(30, *map.Find(3));
+
+  map[1] = 11;
+  EXPECT_EQ(2u, map.size());
+  EXPECT_EQ(11, *map.Find(1));
+}
+
+TEST(SmallFlatMap, IterationIsOrdered) {
+  TestMap map;
+  map[5] = 50;
+  map[2] = 20;
+  map[7] = 70;
+  EXPECT_TRUE(map.IsFlatForTesting());
+  EXPECT_EQ((std::vector<std::pair<int, int>>{{2, 20}, {5, 50}, {7, 70}}),
+            ToVector(map));
+
+  map[1] = 10;
+  map[6] = 60;
+  EXPECT_FALSE(map.IsFlatForTesting());
+  EXPECT_EQ((std::vector<std::pair<int, int>>{
+                {1, 10}, {2, 20}, {5, 50}, {6, 60}, {7, 70}}),
+            ToVector(map));
+}
+
+TEST(SmallFlatMap, MoveToTree) {
+  TestMap map;
+  for (int i = 4; i > 0; --i)
+    map[i] = i * 10;
+  EXPECT_TRUE(map.IsFlatForTesting());
+
+  // Existing keys do not grow the map.
+  map[2] = 21;
+  EXPECT_TRUE(map.IsFlatForTesting());
+
+  map[0] = 0;
+  EXPECT_FALSE(map.IsFlatForTesting());
+  EXPECT_EQ(5u, map.size());
+  for (int i = 0; i < 5; ++i) {
+    ASSERT_TRUE(map.Find(i));
+    EXPECT_EQ(i == 2 ? 21 : i * 10, *map.Find(i));
+  }
+
+  // Shrinking keeps the tree.
+  EXPECT_TRUE(map.Erase(0));
+  EXPECT_FALSE(map.IsFlatForTesting());
+  EXPECT_EQ(4u, map.size());
+}
+
+TEST(SmallFlatMap, Erase) {
+  TestMap map;
+  map[1] = 10;
+  map[2] = 20;
+  map[3] = 30;
+  EXPECT_TRUE(map.Erase(2));
+  EXPECT_FALSE(map.Erase(2));
+  EXPECT_EQ((std::vector<std::pair<int, int>>{{1, 10}, {3, 30}}),
+            ToVector(map));
+
+  map.clear();
+  EXPECT_TRUE(map.empty());
+  EXPECT_TRUE(map.IsFlatForTesting());
+}
+
+TEST(SmallFlatMap, MutableIteration) {
+  TestMap map;
+  for (int i = 0; i < 8; ++i)
+    map[i] = i;
+  for (auto entry : map)
+    entry.second *= 2;
+  for (int i = 0; i < 8; ++i)
+    EXPECT_EQ(2 * i, *map.Find(i));
+}
+
+TEST(SmallFlatMap, IteratorArrow) {
+  TestMap map;
+  map[1] = 10;
+  TestMap::const_iterator it;
+  it = static_cast<const TestMap&>(map).begin();
+  EXPECT_EQ(1, it->first);
+  EXPECT_EQ(10, it->second);
+  ++it;
+  EXPECT_EQ(static_cast<const TestMap&>(map).end(), it);
+}
+
+TEST(SmallFlatMap, MoveOnlyValues) {
+  SmallFlatMap<int, std::unique_ptr<int>, 2> map;
+  for (int i = 0; i < 4; ++i)
+    map[i] = std::make_unique<int>(i);
+  EXPECT_FALSE(map.IsFlatForTesting());
+  for (int i = 0; i < 4; ++i)
+    EXPECT_EQ(i, **map.Find(i));
+}
+
+}  // namespace fxcrt
@@ -1916,6 +1916,11 @@ void CPDFSDK_AppStream::Write(const ByteString& sAPType,
   pStreamDict->SetMatrixFor("Matrix", widget_->GetMatrix());
   pStreamDict->SetRectFor("BBox", widget_->GetRotatedRect());
   pStream->SetDataAndRemoveFilter(sContents.raw_span());
+
+  CPDF_Document* doc = widget_->GetPageView()->GetPDFDocument();
+  doc->MarkIndirectObjectDirty(pStream->GetObjNum());
+  doc->MarkIndirectObjectDirty(pParentDict->GetObjNum());
+  doc->MarkIndirectObjectDirty(dict_->GetObjNum());
 }
 
 void CPDFSDK_AppStream::Remove(const ByteString& sAPType) {
@@ -6,6 +6,9 @@
 
 #include "fpdfsdk/cpdfsdk_helpers.h"
 
+#include <memory>
+#include <vector>
+
 #include "build/build_config.h"
 #include "constants/form_fields.h"
 #include "constants/stream_dict_common.h"
@@ -13,20 +16,27 @@
 #include "core/fpdfapi/parser/cpdf_array.h"
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
 #include "core/fpdfapi/parser/cpdf_document.h"
+#include "core/fpdfapi/parser/cpdf_stream.h"
 #include "core/fpdfapi/parser/cpdf_stream_acc.h"
 #include "core/fpdfapi/render/cpdf_renderoptions.h"
 #include "core/fpdfdoc/cpdf_annot.h"
 #include "core/fpdfdoc/cpdf_interactiveform.h"
 #include "core/fpdfdoc/cpdf_metadata.h"
+#include "core/fxcodec/chunked_decoder.h"
+#include "core/fxcrt/fx_memory_wrappers.h"
+#include "core/fxcrt/fx_safe_types.h"
 #include "core/fxcrt/unowned_ptr.h"
 #include "fpdfsdk/cpdfsdk_formfillenvironment.h"
 #include "third_party/base/check.h"
 #include "third_party/base/numerics/safe_conversions.h"
+#include "third_party/base/optional.h"
 
 namespace {
 
 constexpr char kQuadPoints[] = "QuadPoints";
 
+constexpr size_t kDecodeChunkSize = 64 * 1024;
+
 // 0 bit: FPDF_POLICY_MACHINETIME_ACCESS
 uint32_t g_sandbox_policy = 0xFFFFFFFF;
 
@@ -51,6 +61,48 @@ bool DocHasXFA(const CPDF_Document* doc) {
   return form && form->GetArrayFor("XFA");
 }
 
+// Decodes |stream| a chunk at a time in a single pass. Without a |buffer|,
+// the decoded data is only measured and never held in memory. Otherwise it is
+// kept for as long as it fits in |buflen|, since |buffer| must be left alone if
+// it turns out to be too small, so copying it out briefly takes twice its
+// size. Returns pdfium::nullopt if the stream has to be decoded by
+// CPDF_StreamAcc instead.
+Optional<unsigned long> DecodeStreamInChunks(const CPDF_StreamAcc* stream_acc,
+                                             void* buffer,
+                                             unsigned long buflen) {
+  std::unique_ptr<fxcodec::ChunkedDecoder> decoder =
+      stream_acc->CreateFilteredDecoder();
+  if (!decoder)
+    return pdfium::nullopt;
+
+  std::vector<uint8_t, FxAllocAllocator<uint8_t>> chunk(kDecodeChunkSize);
+  std::vector<uint8_t, FxAllocAllocator<uint8_t>> decoded;
+  bool fits = !!buffer;
+  FX_SAFE_SIZE_T safe_size = 0;
+  while (size_t read = decoder->Read(pdfium::make_span(chunk))) {
+    safe_size += read;
+    if (!fits)
+      continue;
+
+    if (!safe_size.IsValid() || safe_size.ValueOrDie() > buflen) {
+      fits = false;
+      decoded.clear();
+      decoded.shrink_to_fit();
+      continue;
+    }
+    decoded.insert(decoded.end(), chunk.begin(), chunk.begin() + read);
+  }
+  if (decoder->HasError() || !safe_size.IsValid() ||
+      !pdfium::base::IsValueInRangeForNumericType<unsigned long>(
+          safe_size.ValueOrDie())) {
+    return pdfium::nullopt;
+  }
+
+  if (fits && !decoded.empty())
+    memcpy(buffer, decoded.data(), decoded.size());
+  return safe_size.ValueOrDie();
+}
+
 unsigned long GetStreamMaybeCopyAndReturnLengthImpl(const CPDF_Stream* stream,
                                                     void* buffer,
                                                     unsigned long buflen,
@@ -58,6 +110,13 @@ unsigned long GetStreamMaybeCopyAndReturnLengthImpl(const CPDF_Stream* stream,
   DCHECK(stream);
   auto stream_acc = pdfium::MakeRetain<CPDF_StreamAcc>(stream);
 
+  if (decode && stream->HasFilter()) {
+    Optional<unsigned long> size =
+        DecodeStreamInChunks(stream_acc.Get(), buffer, buflen);
+    if (size.has_value())
+      return size.value();
+  }
+
   if (decode)
     stream_acc->LoadAllDataFiltered();
   else
@@ -648,6 +648,10 @@ void CPDFSDK_Widget::ResetAppearance(Optional<WideString> sValue,
       break;
   }
 
+  // The annotation dictionary holds the modification date and, usually, the
+  // appearance dictionary.
+  GetPageView()->GetPDFDocument()->MarkIndirectObjectDirty(
+      GetAnnotDict()->GetObjNum());
   m_pAnnot->ClearCachedAP();
 }
 
@@ -172,6 +172,7 @@ void UpdateContentStream(CPDF_Form* pForm, CPDF_Stream* pStream) {
   std::ostringstream buf;
   generator.ProcessPageObjects(&buf);
   pStream->SetDataFromStringstreamAndRemoveFilter(&buf);
+  pForm->GetDocument()->MarkIndirectObjectDirty(pStream->GetObjNum());
 }
 
 void SetQuadPointsAtIndex(CPDF_Array* array,
@@ -206,7 +207,7 @@ void AppendQuadPoints(CPDF_Array* array, const FS_QUADPOINTSF* quad_points) {
   array->AppendNew<CPDF_Number>(quad_points->y4);
 }
 
-void UpdateBBox(CPDF_Dictionary* annot_dict) {
+void UpdateBBox(CPDF_Document* pDoc, CPDF_Dictionary* annot_dict) {
   DCHECK(annot_dict);
   // Update BBox entry in appearance stream based on the bounding rectangle
   // of the annotation's quadpoints.
@@ -215,8 +216,10 @@ void UpdateBBox(CPDF_Dictionary* annot_dict) {
   if (pStream) {
     CFX_FloatRect boundingRect =
         CPDF_Annot::BoundingRectFromQuadPoints(annot_dict);
-    if (boundingRect.Contains(pStream->GetDict()->GetRectFor("BBox")))
+    if (boundingRect.Contains(pStream->GetDict()->GetRectFor("BBox"))) {
       pStream->GetDict()->SetRectFor("BBox", boundingRect);
+      pDoc->MarkIndirectObjectDirty(pStream->GetObjNum());
+    }
   }
 }
 
@@ -225,6 +228,40 @@ CPDF_Dictionary* GetAnnotDictFromFPDFAnnotation(FPDF_ANNOTATION annot) {
   return context ? context->GetAnnotDict() : nullptr;
 }
 
+// Records that the "Annots" array of |pPage| changed, so that incremental
+// saves write it, or the page dictionary if the array is a direct object.
+void MarkAnnotListDirty(CPDF_Page* pPage) {
+  CPDF_Dictionary* pPageDict = pPage->GetDict();
+  const CPDF_Array* pAnnots = pPageDict->GetArrayFor("Annots");
+  uint32_t objnum = pAnnots ? pAnnots->GetObjNum() : 0;
+  pPage->GetDocument()->MarkIndirectObjectDirty(
+      objnum ? objnum : pPageDict->GetObjNum());
+}
+
+// Records that |pObj|, which belongs to the document of |annot|, changed, so
+// that incremental saves write it.
+void MarkAnnotObjectDirty(FPDF_ANNOTATION annot, const CPDF_Object* pObj) {
+  CPDFAnnotContextFromFPDFAnnotation(annot)
+      ->GetPage()
+      ->GetDocument()
+      ->MarkIndirectObjectDirty(pObj->GetObjNum());
+}
+
+// Records that the dictionary of |annot| changed, so that incremental saves
+// write it. Direct annotation dictionaries are written with the page's
+// "Annots" array.
+void MarkAnnotDictDirty(FPDF_ANNOTATION annot) {
+  CPDF_AnnotContext* context = CPDFAnnotContextFromFPDFAnnotation(annot);
+  const CPDF_Dictionary* pAnnotDict = context->GetAnnotDict();
+  if (pAnnotDict->GetObjNum()) {
+    MarkAnnotObjectDirty(annot, pAnnotDict);
+    return;
+  }
+  CPDF_Page* pPage = context->GetPage()->AsPDFPage();
+  if (pPage)
+    MarkAnnotListDirty(pPage);
+}
+
 RetainPtr<CPDF_Dictionary> SetExtGStateInResourceDict(
     CPDF_Document* pDoc,
     const CPDF_Dictionary* pAnnotDict,
@@ -349,6 +386,7 @@ FPDFPage_CreateAnnot(FPDF_PAGE page, FPDF_ANNOTATION_SUBTYPE subtype) {
   if (!pAnnotList)
     pAnnotList = pPage->GetDict()->SetNewFor<CPDF_Array>("Annots");
   pAnnotList->Append(pDict);
+  MarkAnnotListDirty(pPage);
 
   // Caller takes ownership.
   return FPDFAnnotationFromCPDFAnnotContext(pNewAnnot.release());
@@ -425,6 +463,7 @@ FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV FPDFPage_RemoveAnnot(FPDF_PAGE page,
     return false;
 
   pAnnots->RemoveAt(index);
+  MarkAnnotListDirty(pPage);
   return true;
 }
 
@@ -502,6 +541,7 @@ FPDF_EXPORT int FPDF_CALLCONV FPDFAnnot_AddInkStroke(FPDF_ANNOTATION annot,
     ink_coord_list->AppendNew<CPDF_Number>(points[i].x);
     ink_coord_list->AppendNew<CPDF_Number>(points[i].y);
   }
+  MarkAnnotDictDirty(annot);
 
   return static_cast<int>(inklist->size() - 1);
 }
@@ -514,6 +554,7 @@ FPDFAnnot_RemoveInkList(FPDF_ANNOTATION annot) {
   CPDF_Dictionary* annot_dict =
       CPDFAnnotContextFromFPDFAnnotation(annot)->GetAnnotDict();
   annot_dict->RemoveFor("InkList");
+  MarkAnnotDictDirty(annot);
   return true;
 }
 
@@ -538,6 +579,7 @@ FPDFAnnot_AppendObject(FPDF_ANNOTATION annot, FPDF_PAGEOBJECT obj) {
     pStream = GetAnnotAP(pAnnotDict, CPDF_Annot::AppearanceMode::Normal);
     if (!pStream)
       return false;
+    MarkAnnotDictDirty(annot);
   }
 
   // Get the annotation's corresponding form object for parsing its AP stream.
@@ -656,6 +698,7 @@ FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV FPDFAnnot_SetColor(FPDF_ANNOTATION annot,
   pColor->AppendNew<CPDF_Number>(G / 255.f);
   pColor->AppendNew<CPDF_Number>(B / 255.f);
 
+  MarkAnnotDictDirty(annot);
   return true;
 }
 
@@ -746,7 +789,10 @@ FPDFAnnot_SetAttachmentPoints(FPDF_ANNOTATION annot,
     return false;
 
   SetQuadPointsAtIndex(pQuadPointsArray, quad_index, quad_points);
-  UpdateBBox(pAnnotDict);
+  UpdateBBox(
+      CPDFAnnotContextFromFPDFAnnotation(annot)->GetPage()->GetDocument(),
+      pAnnotDict);
+  MarkAnnotDictDirty(annot);
   return true;
 }
 
@@ -762,7 +808,10 @@ FPDFAnnot_AppendAttachmentPoints(FPDF_ANNOTATION annot,
   if (!pQuadPointsArray)
     pQuadPointsArray = AddQuadPointsArrayToDictionary(pAnnotDict);
   AppendQuadPoints(pQuadPointsArray, quad_points);
-  UpdateBBox(pAnnotDict);
+  UpdateBBox(
+      CPDFAnnotContextFromFPDFAnnotation(annot)->GetPage()->GetDocument(),
+      pAnnotDict);
+  MarkAnnotDictDirty(annot);
   return true;
 }
 
@@ -803,6 +852,7 @@ FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV FPDFAnnot_SetRect(FPDF_ANNOTATION annot,
 
   // Update the "Rect" entry in the annotation dictionary.
   pAnnotDict->SetRectFor(pdfium::annotation::kRect, newRect);
+  MarkAnnotDictDirty(annot);
 
   // If the annotation's appearance stream is defined, the annotation is of a
   // type that does not have quadpoints, and the new rectangle is bigger than
@@ -814,8 +864,10 @@ FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV FPDFAnnot_SetRect(FPDF_ANNOTATION annot,
 
   CPDF_Stream* pStream =
       GetAnnotAP(pAnnotDict, CPDF_Annot::AppearanceMode::Normal);
-  if (pStream && newRect.Contains(pStream->GetDict()->GetRectFor("BBox")))
+  if (pStream && newRect.Contains(pStream->GetDict()->GetRectFor("BBox"))) {
     pStream->GetDict()->SetRectFor("BBox", newRect);
+    MarkAnnotObjectDirty(annot, pStream);
+  }
   return true;
 }
 
@@ -930,6 +982,7 @@ FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV FPDFAnnot_SetBorder(FPDF_ANNOTATION annot,
   border->AppendNew<CPDF_Number>(horizontal_radius);
   border->AppendNew<CPDF_Number>(vertical_radius);
   border->AppendNew<CPDF_Number>(border_width);
+  MarkAnnotDictDirty(annot);
   return true;
 }
 
@@ -981,6 +1034,7 @@ FPDFAnnot_SetStringValue(FPDF_ANNOTATION annot,
     return false;
 
   pAnnotDict->SetNewFor<CPDF_String>(key, WideStringFromFPDFWideString(value));
+  MarkAnnotDictDirty(annot);
   return true;
 }
 
@@ -1088,6 +1142,9 @@ FPDFAnnot_SetAP(FPDF_ANNOTATION annot,
     }
   }
 
+  MarkAnnotDictDirty(annot);
+  if (pApDict)
+    MarkAnnotObjectDirty(annot, pApDict);
   return true;
 }
 
@@ -1141,6 +1198,7 @@ FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV FPDFAnnot_SetFlags(FPDF_ANNOTATION annot,
     return false;
 
   pAnnotDict->SetNewFor<CPDF_Number>(pdfium::annotation::kF, flags);
+  MarkAnnotDictDirty(annot);
   return true;
 }
 
@@ -1396,5 +1454,6 @@ FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV FPDFAnnot_SetURI(FPDF_ANNOTATION annot,
   action->SetNewFor<CPDF_Name>("Type", "Action");
   action->SetNewFor<CPDF_Name>("S", "URI");
   action->SetNewFor<CPDF_String>("URI", uri, /*bHex=*/false);
+  MarkAnnotDictDirty(annot);
   return true;
 }
@@ -23,6 +23,7 @@
 #include "public/cpp/fpdf_scopers.h"
 #include "public/fpdf_edit.h"
 #include "public/fpdf_formfill.h"
+#include "public/fpdf_save.h"
 #include "public/fpdfview.h"
 #include "testing/embedder_test.h"
 #include "testing/embedder_test_constants.h"
@@ -1517,6 +1518,69 @@ TEST_F(FPDFAnnotEmbedderTest, AddAndModifyText) {
   UnloadPage(page);
 }
 
+TEST_F(FPDFAnnotEmbedderTest, IncrementalSaveKeepsAnnotationEdits) {
+  // Open a file with 3 annotations on its first page.
+  ASSERT_TRUE(OpenDocument("annotation_ink_multiple.pdf"));
+  FPDF_PAGE page = LoadPageNoEvents(0);
+  ASSERT_TRUE(page);
+  EXPECT_EQ(3, FPDFPage_GetAnnotCount(page));
+
+  // Edit the first annotation, remove the second one and add a new one.
+  static const wchar_t kNewDate[] = L"D:201706282359Z00'00'";
+  {
+    ScopedFPDFAnnotation annot(FPDFPage_GetAnnot(page, 0));
+    ASSERT_TRUE(annot);
+    ScopedFPDFWideString text = GetFPDFWideString(kNewDate);
+    EXPECT_TRUE(FPDFAnnot_SetStringValue(annot.get(), pdfium::annotation::kM,
+                                         text.get()));
+  }
+  EXPECT_TRUE(FPDFPage_RemoveAnnot(page, 1));
+  {
+    ScopedFPDFAnnotation annot(FPDFPage_CreateAnnot(page, FPDF_ANNOT_SQUARE));
+    ASSERT_TRUE(annot);
+    const FS_RECTF rect = {100.f, 200.f, 150.f, 150.f};
+    EXPECT_TRUE(FPDFAnnot_SetRect(annot.get(), &rect));
+  }
+  EXPECT_EQ(3, FPDFPage_GetAnnotCount(page));
+
+  EXPECT_TRUE(FPDF_SaveAsCopy(document(), this, FPDF_INCREMENTAL));
+  UnloadPageNoEvents(page);
+
+  // Check that all three edits survive a reload. Form fill events would move
+  // the annotations, so load the page without them.
+  FPDF_DOCUMENT saved_doc = OpenSavedDocument();
+  ASSERT_TRUE(saved_doc);
+  FPDF_PAGE saved_page = FPDF_LoadPage(saved_doc, 0);
+  ASSERT_TRUE(saved_page);
+  EXPECT_EQ(3, FPDFPage_GetAnnotCount(saved_page));
+  {
+    ScopedFPDFAnnotation annot(FPDFPage_GetAnnot(saved_page, 0));
+    ASSERT_TRUE(annot);
+    unsigned long length_bytes = FPDFAnnot_GetStringValue(
+        annot.get(), pdfium::annotation::kM, nullptr, 0);
+    ASSERT_EQ(44u, length_bytes);
+    std::vector<FPDF_WCHAR> buf = GetFPDFWideStringBuffer(length_bytes);
+    EXPECT_EQ(44u, FPDFAnnot_GetStringValue(annot.get(), pdfium::annotation::kM,
+                                            buf.data(), length_bytes));
+    EXPECT_EQ(kNewDate, GetPlatformWString(buf.data()));
+  }
+  {
+    // The original third annotation is now the second one.
+    ScopedFPDFAnnotation annot(FPDFPage_GetAnnot(saved_page, 1));
+    ASSERT_TRUE(annot);
+    FS_RECTF rect;
+    ASSERT_TRUE(FPDFAnnot_GetRect(annot.get(), &rect));
+    EXPECT_NEAR(351.8204f, rect.left, 0.001f);
+  }
+  {
+    ScopedFPDFAnnotation annot(FPDFPage_GetAnnot(saved_page, 2));
+    ASSERT_TRUE(annot);
+    EXPECT_EQ(FPDF_ANNOT_SQUARE, FPDFAnnot_GetSubtype(annot.get()));
+  }
+  FPDF_ClosePage(saved_page);
+  CloseSavedDocument();
+}
+
 TEST_F(FPDFAnnotEmbedderTest, GetSetStringValue) {
   // Open a file with four annotations and load its first page.
   ASSERT_TRUE(OpenDocument("annotation_stamp_with_ap.pdf"));
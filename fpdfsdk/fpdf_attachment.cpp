@@ -30,6 +30,7 @@
 namespace {
 
 constexpr char kChecksumKey[] = "CheckSum";
+constexpr int kNameTreeMaxRecursion = 32;
 
 ByteString CFXByteStringHexDecode(const ByteString& bsHex) {
   std::unique_ptr<uint8_t, FxFreeDeleter> result;
@@ -48,6 +49,58 @@ ByteString GenerateMD5Base16(const void* contents, const unsigned long len) {
   return ByteString(buf, 32);
 }
 
+void MarkNameTreeNodeDirty(CPDF_Document* pDoc,
+                           const CPDF_Dictionary* pNode,
+                           int nLevel) {
+  if (!pNode || nLevel > kNameTreeMaxRecursion)
+    return;
+
+  pDoc->MarkIndirectObjectDirty(pNode->GetObjNum());
+  for (const char* key : {"Names", "Limits"}) {
+    const CPDF_Array* pArray = pNode->GetArrayFor(key);
+    if (pArray)
+      pDoc->MarkIndirectObjectDirty(pArray->GetObjNum());
+  }
+  const CPDF_Array* pKids = pNode->GetArrayFor("Kids");
+  if (!pKids)
+    return;
+
+  pDoc->MarkIndirectObjectDirty(pKids->GetObjNum());
+  for (size_t i = 0; i < pKids->size(); ++i)
+    MarkNameTreeNodeDirty(pDoc, pKids->GetDictAt(i), nLevel + 1);
+}
+
+// Records that the "EmbeddedFiles" name tree of |pDoc| changed, so that
+// incremental saves write it. CPDF_NameTree does not say which nodes an edit
+// touched, so this marks all of them, along with the dictionaries leading to
+// the tree, which may have just been created.
+void MarkEmbeddedFilesDirty(CPDF_Document* pDoc) {
+  const CPDF_Dictionary* pRoot = pDoc->GetRoot();
+  if (!pRoot)
+    return;
+
+  pDoc->MarkIndirectObjectDirty(pRoot->GetObjNum());
+  const CPDF_Dictionary* pNames = pRoot->GetDictFor("Names");
+  if (!pNames)
+    return;
+
+  pDoc->MarkIndirectObjectDirty(pNames->GetObjNum());
+  MarkNameTreeNodeDirty(pDoc, pNames->GetDictFor("EmbeddedFiles"), 0);
+}
+
+// Records that the filespec |pFile| and its embedded file stream may change.
+// FPDFAttachment_SetStringValue() edits them without access to the document,
+// so every attachment handed out is treated as changed by incremental saves.
+void MarkAttachmentDirty(CPDF_Document* pDoc, CPDF_Object* pFile) {
+  if (!pFile)
+    return;
+
+  pDoc->MarkIndirectObjectDirty(pFile->GetObjNum());
+  const CPDF_Stream* pFileStream = CPDF_FileSpec(pFile).GetFileStream();
+  if (pFileStream)
+    pDoc->MarkIndirectObjectDirty(pFileStream->GetObjNum());
+}
+
 }  // namespace
 
 FPDF_EXPORT int FPDF_CALLCONV
@@ -85,6 +138,7 @@ FPDFDoc_AddAttachment(FPDF_DOCUMENT document, FPDF_WIDESTRING name) {
   if (!name_tree->AddValueAndName(pFile->MakeReference(pDoc), wsName))
     return nullptr;
 
+  MarkEmbeddedFilesDirty(pDoc);
   return FPDFAttachmentFromCPDFObject(pFile);
 }
 
@@ -99,8 +153,9 @@ FPDFDoc_GetAttachment(FPDF_DOCUMENT document, int index) {
     return nullptr;
 
   WideString csName;
-  return FPDFAttachmentFromCPDFObject(
-      name_tree->LookupValueAndName(index, &csName));
+  CPDF_Object* pFile = name_tree->LookupValueAndName(index, &csName);
+  MarkAttachmentDirty(pDoc, pFile);
+  return FPDFAttachmentFromCPDFObject(pFile);
 }
 
 FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV
@@ -113,7 +168,11 @@ FPDFDoc_DeleteAttachment(FPDF_DOCUMENT document, int index) {
   if (!name_tree || static_cast<size_t>(index) >= name_tree->GetCount())
     return false;
 
-  return name_tree->DeleteValueAndName(index);
+  if (!name_tree->DeleteValueAndName(index))
+    return false;
+
+  MarkEmbeddedFilesDirty(pDoc);
+  return true;
 }
 
 FPDF_EXPORT unsigned long FPDF_CALLCONV
@@ -244,6 +303,7 @@ FPDFAttachment_SetFile(FPDF_ATTACHMENT attachment,
   CPDF_Dictionary* pEFDict =
       pFile->AsDictionary()->SetNewFor<CPDF_Dictionary>("EF");
   pEFDict->SetNewFor<CPDF_Reference>("F", pDoc, pFileStream->GetObjNum());
+  pDoc->MarkIndirectObjectDirty(pFile->GetObjNum());
   return true;
 }
 
@@ -7,6 +7,7 @@
 #include <vector>
 
 #include "public/fpdf_attachment.h"
+#include "public/fpdf_save.h"
 #include "public/fpdfview.h"
 #include "testing/embedder_test.h"
 #include "testing/fx_string_testhelpers.h"
@@ -368,3 +369,59 @@ TEST_F(FPDFAttachmentEmbedderTest, DeleteAttachment) {
   EXPECT_EQ(26u, FPDFAttachment_GetName(attachment, buf.data(), length_bytes));
   EXPECT_EQ(L"attached.pdf", GetPlatformWString(buf.data()));
 }
+
+TEST_F(FPDFAttachmentEmbedderTest, IncrementalSaveKeepsAttachmentEdits) {
+  // Open a file with two attachments.
+  ASSERT_TRUE(OpenDocument("embedded_attachments.pdf"));
+  EXPECT_EQ(2, FPDFDoc_GetAttachmentCount(document()));
+
+  // Edit the parameters of an existing attachment. Only the attachment handle
+  // is passed to FPDFAttachment_SetStringValue().
+  FPDF_ATTACHMENT attachment = FPDFDoc_GetAttachment(document(), 0);
+  ASSERT_TRUE(attachment);
+  constexpr wchar_t kDateW[] = L"D:20200101120000";
+  ScopedFPDFWideString ws_date = GetFPDFWideString(kDateW);
+  EXPECT_TRUE(
+      FPDFAttachment_SetStringValue(attachment, kDateKey, ws_date.get()));
+
+  // Add a new attachment, which changes the EmbeddedFiles name tree.
+  ScopedFPDFWideString file_name = GetFPDFWideString(L"z.txt");
+  attachment = FPDFDoc_AddAttachment(document(), file_name.get());
+  ASSERT_TRUE(attachment);
+  constexpr char kContents[] = "World!";
+  EXPECT_TRUE(FPDFAttachment_SetFile(attachment, document(), kContents,
+                                     strlen(kContents)));
+
+  // Save incrementally and check that both edits survive a reload.
+  EXPECT_TRUE(FPDF_SaveAsCopy(document(), this, FPDF_INCREMENTAL));
+  FPDF_DOCUMENT saved_doc = OpenSavedDocument();
+  ASSERT_TRUE(saved_doc);
+  EXPECT_EQ(3, FPDFDoc_GetAttachmentCount(saved_doc));
+
+  attachment = FPDFDoc_GetAttachment(saved_doc, 0);
+  ASSERT_TRUE(attachment);
+  unsigned long length_bytes =
+      FPDFAttachment_GetStringValue(attachment, kDateKey, nullptr, 0);
+  ASSERT_EQ(34u, length_bytes);
+  std::vector<FPDF_WCHAR> buf = GetFPDFWideStringBuffer(length_bytes);
+  EXPECT_EQ(34u, FPDFAttachment_GetStringValue(attachment, kDateKey,
+                                               buf.data(), length_bytes));
+  EXPECT_EQ(kDateW, GetPlatformWString(buf.data()));
+
+  attachment = FPDFDoc_GetAttachment(saved_doc, 2);
+  ASSERT_TRUE(attachment);
+  length_bytes = FPDFAttachment_GetName(attachment, nullptr, 0);
+  ASSERT_EQ(12u, length_bytes);
+  buf = GetFPDFWideStringBuffer(length_bytes);
+  EXPECT_EQ(12u, FPDFAttachment_GetName(attachment, buf.data(), length_bytes));
+  EXPECT_EQ(L"z.txt", GetPlatformWString(buf.data()));
+
+  ASSERT_TRUE(FPDFAttachment_GetFile(attachment, nullptr, 0, &length_bytes));
+  std::vector<char> content_buf(length_bytes);
+  unsigned long actual_length_bytes;
+  ASSERT_TRUE(FPDFAttachment_GetFile(attachment, content_buf.data(),
+                                     length_bytes, &actual_length_bytes));
+  ASSERT_EQ(6u, actual_length_bytes);
+  EXPECT_EQ(std::string(kContents), std::string(content_buf.data(), 6));
+  CloseSavedDocument();
+}
@@ -10,11 +10,13 @@
 #include <utility>
 
 #include "core/fpdfapi/page/cpdf_docpagedata.h"
+#include "core/fpdfapi/page/cpdf_page.h"
 #include "core/fpdfapi/parser/cpdf_data_avail.h"
 #include "core/fpdfapi/parser/cpdf_document.h"
 #include "core/fpdfapi/render/cpdf_docrenderdata.h"
 #include "core/fxcrt/fx_safe_types.h"
 #include "core/fxcrt/fx_stream.h"
+#include "core/fxcrt/pauseindicator_iface.h"
 #include "core/fxcrt/retain_ptr.h"
 #include "core/fxcrt/unowned_ptr.h"
 #include "fpdfsdk/cpdfsdk_helpers.h"
@@ -50,6 +52,12 @@ static_assert(CPDF_DataAvail::FormNotExist == PDF_FORM_NOTEXIST,
 
 namespace {
 
+// Lets progressive parsing run until it has to wait for data.
+class NeverPauseIndicator final : public PauseIndicatorIface {
+ public:
+  bool NeedToPauseNow() override { return false; }
+};
+
 class FPDF_FileAvailContext final : public CPDF_DataAvail::FileAvail {
  public:
   explicit FPDF_FileAvailContext(FX_FILEAVAIL* avail) : avail_(avail) {}
@@ -122,7 +130,19 @@ class FPDF_AvailContext {
 
   CPDF_DataAvail* data_avail() { return data_avail_.get(); }
 
+  void SetAsyncDownloadHints(FX_DOWNLOADHINTS* hints) {
+    if (!hints) {
+      data_avail_->SetAsyncDownloadHints(nullptr);
+      async_hints_.reset();
+      return;
+    }
+    auto async_hints = std::make_unique<FPDF_DownloadHintsContext>(hints);
+    data_avail_->SetAsyncDownloadHints(async_hints.get());
+    async_hints_ = std::move(async_hints);
+  }
+
  private:
+  std::unique_ptr<FPDF_DownloadHintsContext> async_hints_;
   std::unique_ptr<FPDF_FileAvailContext> const file_avail_;
   RetainPtr<FPDF_FileAccessContext> const file_read_;
   std::unique_ptr<CPDF_DataAvail> const data_avail_;
@@ -190,6 +210,34 @@ FPDF_EXPORT int FPDF_CALLCONV FPDFAvail_IsPageAvail(FPDF_AVAIL avail,
   return avail_context->data_avail()->IsPageAvail(page_index, &hints_context);
 }
 
+FPDF_EXPORT void FPDF_CALLCONV FPDFAvail_SetPrefetchPageCount(FPDF_AVAIL avail,
+                                                              int page_count) {
+  auto* avail_context = FPDFAvailContextFromFPDFAvail(avail);
+  if (!avail_context || page_count < 0)
+    return;
+  avail_context->data_avail()->SetPrefetchPageCount(page_count);
+}
+
+FPDF_EXPORT void FPDF_CALLCONV
+FPDFAvail_SetAsyncDownloadHints(FPDF_AVAIL avail, FX_DOWNLOADHINTS* hints) {
+  auto* avail_context = FPDFAvailContextFromFPDFAvail(avail);
+  if (avail_context)
+    avail_context->SetAsyncDownloadHints(hints);
+}
+
+FPDF_EXPORT int FPDF_CALLCONV FPDFAvail_ContinueParsePage(FPDF_PAGE page) {
+  CPDF_Page* pPage = CPDFPageFromFPDFPage(page);
+  if (!pPage)
+    return PDF_DATA_ERROR;
+
+  pPage->StartParseContent();
+  NeverPauseIndicator pause;
+  pPage->ContinueParse(&pause);
+  return pPage->GetParseState() == CPDF_PageObjectHolder::ParseState::kParsed
+             ? PDF_DATA_AVAIL
+             : PDF_DATA_NOTAVAIL;
+}
+
 FPDF_EXPORT int FPDF_CALLCONV FPDFAvail_IsFormAvail(FPDF_AVAIL avail,
                                                     FX_DOWNLOADHINTS* hints) {
   auto* avail_context = FPDFAvailContextFromFPDFAvail(avail);
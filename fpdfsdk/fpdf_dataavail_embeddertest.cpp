@@ -10,6 +10,9 @@
 
 #include "core/fxcrt/bytestring.h"
 #include "core/fxcrt/widestring.h"
+#include "public/cpp/fpdf_scopers.h"
+#include "public/fpdf_edit.h"
+#include "public/fpdf_progressive.h"
 #include "public/fpdfview.h"
 #include "testing/embedder_test.h"
 #include "testing/gtest/include/gtest/gtest.h"
@@ -32,6 +35,17 @@ class MockDownloadHints final : public FX_DOWNLOADHINTS {
   ~MockDownloadHints() = default;
 };
 
+class NeverPause final : public IFSDK_PAUSE {
+ public:
+  static FPDF_BOOL SNeedToPauseNow(IFSDK_PAUSE* pThis) { return false; }
+
+  NeverPause() {
+    IFSDK_PAUSE::version = 1;
+    IFSDK_PAUSE::user = nullptr;
+    IFSDK_PAUSE::NeedToPauseNow = SNeedToPauseNow;
+  }
+};
+
 class TestAsyncLoader final : public FX_DOWNLOADHINTS, FX_FILEAVAIL {
  public:
   explicit TestAsyncLoader(const std::string& file_name) {
@@ -81,6 +95,11 @@ class TestAsyncLoader final : public FX_DOWNLOADHINTS, FX_FILEAVAIL {
                : available_ranges_.ranges().rbegin()->second;
   }
 
+  // Makes all data overlapping [start, end) unavailable until
+  // ReleaseWithheldData() is called, whether it is new or not.
+  void WithholdData(size_t start, size_t end) { withheld_range_ = {start, end}; }
+  void ReleaseWithheldData() { withheld_range_ = {0, 0}; }
+
   void FlushRequestedData() {
     for (const auto& it : requested_segments_) {
       SetDataAvailable(it.first, it.second);
@@ -120,6 +139,10 @@ class TestAsyncLoader final : public FX_DOWNLOADHINTS, FX_FILEAVAIL {
   bool IsDataAvailImpl(size_t offset, size_t size) {
     if (offset + size > file_length_)
       return false;
+    if (offset < withheld_range_.second &&
+        offset + size > withheld_range_.first) {
+      return false;
+    }
     if (is_new_data_available_) {
       SetDataAvailable(offset, size);
       return true;
@@ -151,12 +174,17 @@ class TestAsyncLoader final : public FX_DOWNLOADHINTS, FX_FILEAVAIL {
   std::vector<std::pair<size_t, size_t>> requested_segments_;
   size_t max_requested_bound_ = 0;
   bool is_new_data_available_ = true;
+  std::pair<size_t, size_t> withheld_range_;
 
   RangeSet available_ranges_;
 };
 
 }  // namespace
 
+// Object 40 in feature_linearized_loading.pdf.
+constexpr size_t kFirstPageContentStart = 1300;
+constexpr size_t kFirstPageContentEnd = 1420;
+
 class FPDFDataAvailEmbedderTest : public EmbedderTest {};
 
 TEST_F(FPDFDataAvailEmbedderTest, TrailerUnterminated) {
@@ -273,6 +301,32 @@ TEST_F(FPDFDataAvailEmbedderTest, LoadSecondPageIfLinearizedWithHints) {
   EXPECT_TRUE(page);
 }
 
+TEST_F(FPDFDataAvailEmbedderTest, LoadSecondPageWithPrefetch) {
+  TestAsyncLoader loader("feature_linearized_loading.pdf");
+  avail_ = FPDFAvail_Create(loader.file_avail(), loader.file_access());
+  FPDFAvail_SetPrefetchPageCount(avail_, 4);
+  ASSERT_EQ(PDF_DATA_AVAIL, FPDFAvail_IsDocAvail(avail_, loader.hints()));
+  document_ = FPDFAvail_GetDocument(avail_, nullptr);
+  ASSERT_TRUE(document_);
+
+  static constexpr uint32_t kSecondPageNum = 1;
+
+  loader.set_is_new_data_available(false);
+  loader.ClearRequestedSegments();
+
+  // This is the last page, so there is nothing to prefetch along with it.
+  int status = PDF_DATA_NOTAVAIL;
+  while (status == PDF_DATA_NOTAVAIL) {
+    loader.FlushRequestedData();
+    status = FPDFAvail_IsPageAvail(avail_, kSecondPageNum, loader.hints());
+  }
+  EXPECT_EQ(PDF_DATA_AVAIL, status);
+
+  loader.set_is_new_data_available(false);
+  ScopedFPDFPage page(FPDF_LoadPage(document(), kSecondPageNum));
+  EXPECT_TRUE(page);
+}
+
 TEST_F(FPDFDataAvailEmbedderTest, LoadInfoAfterReceivingWholeDocument) {
   TestAsyncLoader loader("linearized.pdf");
   loader.set_is_new_data_available(false);
@@ -382,6 +436,8 @@ TEST_F(FPDFDataAvailEmbedderTest, BadInputsToAPIs) {
   EXPECT_EQ(PDF_DATA_ERROR, FPDFAvail_IsPageAvail(nullptr, 0, nullptr));
   EXPECT_EQ(PDF_FORM_ERROR, FPDFAvail_IsFormAvail(nullptr, nullptr));
   EXPECT_EQ(PDF_LINEARIZATION_UNKNOWN, FPDFAvail_IsLinearized(nullptr));
+  FPDFAvail_SetAsyncDownloadHints(nullptr, nullptr);
+  EXPECT_EQ(PDF_DATA_ERROR, FPDFAvail_ContinueParsePage(nullptr));
 }
 
 TEST_F(FPDFDataAvailEmbedderTest, NegativePageIndex) {
@@ -391,3 +447,92 @@ TEST_F(FPDFDataAvailEmbedderTest, NegativePageIndex) {
   EXPECT_EQ(PDF_DATA_NOTAVAIL,
             FPDFAvail_IsPageAvail(avail_, -1, loader.hints()));
 }
+
+TEST_F(FPDFDataAvailEmbedderTest, RenderPageWhileContentArrives) {
+  TestAsyncLoader loader("feature_linearized_loading.pdf");
+  ScopedFPDFDocument reference_doc(FPDF_LoadMemDocument(
+      loader.file_contents(), loader.file_length(), nullptr));
+  ASSERT_TRUE(reference_doc);
+  ScopedFPDFPage reference_page(FPDF_LoadPage(reference_doc.get(), 0));
+  ASSERT_TRUE(reference_page);
+  const int width = static_cast<int>(FPDF_GetPageWidthF(reference_page.get()));
+  const int height =
+      static_cast<int>(FPDF_GetPageHeightF(reference_page.get()));
+  ScopedFPDFBitmap reference_bitmap(FPDFBitmap_Create(width, height, 0));
+  FPDFBitmap_FillRect(reference_bitmap.get(), 0, 0, width, height, 0xFFFFFFFF);
+  FPDF_RenderPageBitmap(reference_bitmap.get(), reference_page.get(), 0, 0,
+                        width, height, 0, 0);
+  const int object_count = FPDFPage_CountObjects(reference_page.get());
+  ASSERT_GT(object_count, 0);
+
+  avail_ = FPDFAvail_Create(loader.file_avail(), loader.file_access());
+  ASSERT_EQ(PDF_DATA_AVAIL, FPDFAvail_IsDocAvail(avail_, loader.hints()));
+  document_ = FPDFAvail_GetDocument(avail_, nullptr);
+  ASSERT_TRUE(document_);
+
+  // The end of the content stream of the first page has not arrived yet.
+  loader.WithholdData(kFirstPageContentStart, kFirstPageContentEnd);
+  FPDFAvail_SetAsyncDownloadHints(avail_, loader.hints());
+  ScopedFPDFPage page(FPDF_LoadPage(document(), 0));
+  ASSERT_TRUE(page);
+  loader.ClearRequestedSegments();
+
+  ScopedFPDFBitmap bitmap(FPDFBitmap_Create(width, height, 0));
+  FPDFBitmap_FillRect(bitmap.get(), 0, 0, width, height, 0xFFFFFFFF);
+  NeverPause pause;
+  int status = FPDF_RenderPageBitmap_Start(bitmap.get(), page.get(), 0, 0,
+                                           width, height, 0, 0, &pause);
+  ASSERT_EQ(FPDF_RENDER_TOBECONTINUED, status);
+  EXPECT_FALSE(loader.requested_segments().empty());
+
+  // The page is still parsing, so it cannot be edited.
+  EXPECT_EQ(PDF_DATA_NOTAVAIL, FPDFAvail_ContinueParsePage(page.get()));
+  EXPECT_EQ(0, FPDFPage_CountObjects(page.get()));
+  EXPECT_FALSE(FPDFPage_GenerateContent(page.get()));
+
+  // The rest of the file arrives.
+  loader.ReleaseWithheldData();
+  while (status == FPDF_RENDER_TOBECONTINUED)
+    status = FPDF_RenderPage_Continue(page.get(), &pause);
+  EXPECT_EQ(FPDF_RENDER_DONE, status);
+  FPDF_RenderPage_Close(page.get());
+  EXPECT_EQ(HashBitmap(reference_bitmap.get()), HashBitmap(bitmap.get()));
+
+  EXPECT_EQ(PDF_DATA_AVAIL, FPDFAvail_ContinueParsePage(page.get()));
+  EXPECT_EQ(object_count, FPDFPage_CountObjects(page.get()));
+  EXPECT_TRUE(FPDFPage_GenerateContent(page.get()));
+}
+
+TEST_F(FPDFDataAvailEmbedderTest, ContinueParsePageWhileContentArrives) {
+  TestAsyncLoader loader("feature_linearized_loading.pdf");
+  avail_ = FPDFAvail_Create(loader.file_avail(), loader.file_access());
+  ASSERT_EQ(PDF_DATA_AVAIL, FPDFAvail_IsDocAvail(avail_, loader.hints()));
+  document_ = FPDFAvail_GetDocument(avail_, nullptr);
+  ASSERT_TRUE(document_);
+  loader.WithholdData(kFirstPageContentStart, kFirstPageContentEnd);
+  FPDFAvail_SetAsyncDownloadHints(avail_, loader.hints());
+  ScopedFPDFPage page(FPDF_LoadPage(document(), 0));
+  ASSERT_TRUE(page);
+  loader.ClearRequestedSegments();
+  EXPECT_EQ(0, FPDFPage_CountObjects(page.get()));
+
+  int status = FPDFAvail_ContinueParsePage(page.get());
+  EXPECT_EQ(PDF_DATA_NOTAVAIL, status);
+  loader.ReleaseWithheldData();
+  loader.set_is_new_data_available(false);
+  while (status == PDF_DATA_NOTAVAIL) {
+    ASSERT_FALSE(loader.requested_segments().empty());
+    loader.FlushRequestedData();
+    status = FPDFAvail_ContinueParsePage(page.get());
+  }
+  EXPECT_EQ(PDF_DATA_AVAIL, status);
+  EXPECT_GT(FPDFPage_CountObjects(page.get()), 0);
+}
+
+TEST_F(FPDFDataAvailEmbedderTest, ContinueParsePageOfFullyLoadedPage) {
+  ASSERT_TRUE(OpenDocument("hello_world.pdf"));
+  FPDF_PAGE page = LoadPage(0);
+  ASSERT_TRUE(page);
+  EXPECT_EQ(PDF_DATA_AVAIL, FPDFAvail_ContinueParsePage(page));
+  UnloadPage(page);
+}
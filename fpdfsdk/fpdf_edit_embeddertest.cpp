@@ -12,6 +12,7 @@
 #include "core/fpdfapi/page/cpdf_formobject.h"
 #include "core/fpdfapi/page/cpdf_page.h"
 #include "core/fpdfapi/page/cpdf_pageobject.h"
+#include "core/fpdfapi/page/cpdf_textobject.h"
 #include "core/fpdfapi/parser/cpdf_array.h"
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
 #include "core/fpdfapi/parser/cpdf_number.h"
@@ -310,6 +311,56 @@ TEST_F(FPDFEditEmbedderTest, EmptyCreation) {
   FPDF_ClosePage(page);
 }
 
+TEST_F(FPDFEditEmbedderTest, GetObjectsInRect) {
+  EXPECT_TRUE(CreateEmptyDocument());
+  FPDF_PAGE page = FPDFPage_New(document(), 0, 612.0, 792.0);
+  ASSERT_TRUE(page);
+
+  // Add enough rectangles in a 10x10 layout for the page to use a grid.
+  constexpr int kSide = 10;
+  for (int row = 0; row < kSide; ++row) {
+    for (int col = 0; col < kSide; ++col) {
+      FPDF_PAGEOBJECT rect =
+          FPDFPageObj_CreateNewRect(col * 50, row * 50, 40, 40);
+      EXPECT_TRUE(FPDFPath_SetDrawMode(rect, FPDF_FILLMODE_ALTERNATE, 0));
+      FPDFPage_InsertObject(page, rect);
+    }
+  }
+
+  // Only the rectangle from (50, 50) to (90, 90) is in this region.
+  const FS_RECTF region = {45, 95, 95, 45};
+  EXPECT_EQ(0u, FPDFPage_GetObjectsInRect(nullptr, &region, nullptr, 0));
+  EXPECT_EQ(0u, FPDFPage_GetObjectsInRect(page, nullptr, nullptr, 0));
+  ASSERT_EQ(1u, FPDFPage_GetObjectsInRect(page, &region, nullptr, 0));
+
+  FPDF_PAGEOBJECT found[2] = {nullptr, nullptr};
+  ASSERT_EQ(1u, FPDFPage_GetObjectsInRect(page, &region, found, 2));
+  EXPECT_EQ(FPDFPage_GetObject(page, kSide + 1), found[0]);
+
+  // Moving the first rectangle into the region makes it show up first.
+  FPDF_PAGEOBJECT first = FPDFPage_GetObject(page, 0);
+  FPDFPageObj_Transform(first, 1, 0, 0, 1, 60, 60);
+  ASSERT_EQ(2u, FPDFPage_GetObjectsInRect(page, &region, found, 2));
+  EXPECT_EQ(first, found[0]);
+  EXPECT_EQ(FPDFPage_GetObject(page, kSide + 1), found[1]);
+
+  // Too small a buffer is left alone.
+  found[0] = nullptr;
+  EXPECT_EQ(2u, FPDFPage_GetObjectsInRect(page, &region, found, 1));
+  EXPECT_FALSE(found[0]);
+
+  // Once removed, the rectangle can move without involving the page.
+  ASSERT_TRUE(FPDFPage_RemoveObject(page, first));
+  ASSERT_EQ(1u, FPDFPage_GetObjectsInRect(page, &region, found, 2));
+  EXPECT_EQ(FPDFPage_GetObject(page, kSide), found[0]);
+  FPDFPageObj_Transform(first, 1, 0, 0, 1, -60, -60);
+  FPDFPageObj_Destroy(first);
+  ASSERT_EQ(1u, FPDFPage_GetObjectsInRect(page, &region, found, 2));
+  EXPECT_EQ(FPDFPage_GetObject(page, kSide), found[0]);
+
+  FPDF_ClosePage(page);
+}
+
 // Regression test for https://crbug.com/667012
 TEST_F(FPDFEditEmbedderTest, RasterizePDF) {
   const char kAllBlackMd5sum[] = "5708fc5c4a8bd0abde99c8e8f0390615";
@@ -669,6 +720,12 @@ TEST_F(FPDFEditEmbedderTest, SetText) {
   FPDF_PAGE page = LoadPage(0);
   ASSERT_TRUE(page);
 
+  // Render first, so the change below has to replace cached glyphs.
+  {
+    ScopedFPDFBitmap page_bitmap = RenderPage(page);
+    CompareBitmap(page_bitmap.get(), 200, 200, kHelloWorldChecksum);
+  }
+
   // Get the "Hello, world!" text object and change it.
   ASSERT_EQ(2, FPDFPage_CountObjects(page));
   FPDF_PAGEOBJECT page_object = FPDFPage_GetObject(page, 0);
@@ -720,6 +777,94 @@ TEST_F(FPDFEditEmbedderTest, SetText) {
   CloseSavedDocument();
 }
 
+TEST_F(FPDFEditEmbedderTest, CachedGlyphsRebuiltAfterTextChanges) {
+  ASSERT_TRUE(OpenDocument("hello_world.pdf"));
+  FPDF_PAGE page = LoadPage(0);
+  ASSERT_TRUE(page);
+
+  FPDF_PAGEOBJECT page_object = FPDFPage_GetObject(page, 0);
+  CPDF_TextObject* text_object =
+      CPDFPageObjectFromFPDFPageObject(page_object)->AsText();
+  ASSERT_TRUE(text_object);
+  {
+    ScopedFPDFBitmap page_bitmap = RenderPage(page);
+    CompareBitmap(page_bitmap.get(), 200, 200, kHelloWorldChecksum);
+  }
+  const std::vector<TextCharPos>* char_pos_list =
+      text_object->GetCachedCharPosList();
+  ASSERT_TRUE(char_pos_list);
+  EXPECT_EQ(13u, char_pos_list->size());
+
+  ScopedFPDFWideString text = GetFPDFWideString(L"Changed for SetText test");
+  ASSERT_TRUE(FPDFText_SetText(page_object, text.get()));
+  EXPECT_FALSE(text_object->GetCachedCharPosList());
+  {
+    ScopedFPDFBitmap page_bitmap = RenderPage(page);
+    EXPECT_NE(kHelloWorldChecksum, HashBitmap(page_bitmap.get()));
+  }
+  char_pos_list = text_object->GetCachedCharPosList();
+  ASSERT_TRUE(char_pos_list);
+  ASSERT_EQ(24u, char_pos_list->size());
+  EXPECT_EQ(static_cast<wchar_t>('C'), (*char_pos_list)[0].m_Unicode);
+
+  // Kerning between segments does not produce glyphs of its own.
+  const ByteString segments[] = {"ab", "cd"};
+  text_object->SetSegments(segments, {-100.0f}, 2);
+  EXPECT_FALSE(text_object->GetCachedCharPosList());
+  ASSERT_TRUE(RenderPage(page));
+  char_pos_list = text_object->GetCachedCharPosList();
+  ASSERT_TRUE(char_pos_list);
+  ASSERT_EQ(4u, char_pos_list->size());
+  EXPECT_EQ(static_cast<wchar_t>('a'), (*char_pos_list)[0].m_Unicode);
+  EXPECT_EQ(static_cast<wchar_t>('d'), (*char_pos_list)[3].m_Unicode);
+
+  UnloadPage(page);
+}
+
+TEST_F(FPDFEditEmbedderTest, CachedGlyphsRebuiltAfterTextStateChanges) {
+  ASSERT_TRUE(OpenDocument("hello_world.pdf"));
+  FPDF_PAGE page = LoadPage(0);
+  ASSERT_TRUE(page);
+
+  CPDF_PageObject* page_object =
+      CPDFPageObjectFromFPDFPageObject(FPDFPage_GetObject(page, 0));
+  ASSERT_TRUE(page_object);
+  const CPDF_TextObject* text_object = page_object->AsText();
+  ASSERT_TRUE(text_object);
+  EXPECT_FALSE(text_object->GetCachedCharPosList());
+
+  {
+    ScopedFPDFBitmap page_bitmap = RenderPage(page);
+    CompareBitmap(page_bitmap.get(), 200, 200, kHelloWorldChecksum);
+  }
+  const std::vector<TextCharPos>* char_pos_list =
+      text_object->GetCachedCharPosList();
+  ASSERT_TRUE(char_pos_list);
+  EXPECT_EQ(text_object->GetCharCodes().size(), char_pos_list->size());
+
+  // The font size lives in the text state, which can change without going
+  // through the text object. The glyphs laid out for the old size are stale.
+  const float font_size = text_object->GetFontSize();
+  page_object->m_TextState.SetFontSize(font_size * 2);
+  EXPECT_FALSE(text_object->GetCachedCharPosList());
+
+  {
+    ScopedFPDFBitmap page_bitmap = RenderPage(page);
+    EXPECT_NE(kHelloWorldChecksum, HashBitmap(page_bitmap.get()));
+  }
+  ASSERT_TRUE(text_object->GetCachedCharPosList());
+
+  // Going back to the old size does not revive the old layout either.
+  page_object->m_TextState.SetFontSize(font_size);
+  EXPECT_FALSE(text_object->GetCachedCharPosList());
+  {
+    ScopedFPDFBitmap page_bitmap = RenderPage(page);
+    CompareBitmap(page_bitmap.get(), 200, 200, kHelloWorldChecksum);
+  }
+
+  UnloadPage(page);
+}
+
 TEST_F(FPDFEditEmbedderTest, SetTextKeepClippingPath) {
   // Load document with some text, with parts clipped.
   ASSERT_TRUE(OpenDocument("bug_1558.pdf"));
@@ -69,6 +69,13 @@ bool IsPageObject(CPDF_Page* pPage) {
   return pName && pName->GetString() == "Page";
 }
 
+// Pages of documents whose data arrives asynchronously may still be parsing.
+// Editing them would lose the content that is not parsed yet.
+bool IsEditablePageObject(CPDF_Page* pPage) {
+  return IsPageObject(pPage) &&
+         pPage->GetParseState() == CPDF_PageObjectHolder::ParseState::kParsed;
+}
+
 void CalcBoundingBox(CPDF_PageObject* pPageObj) {
   switch (pPageObj->GetType()) {
     case CPDF_PageObject::TEXT: {
@@ -241,7 +248,7 @@ FPDF_EXPORT void FPDF_CALLCONV FPDFPage_InsertObject(FPDF_PAGE page,
 
   std::unique_ptr<CPDF_PageObject> pPageObjHolder(pPageObj);
   CPDF_Page* pPage = CPDFPageFromFPDFPage(page);
-  if (!IsPageObject(pPage))
+  if (!IsEditablePageObject(pPage))
     return;
 
   pPageObj->SetDirty(true);
@@ -256,7 +263,7 @@ FPDFPage_RemoveObject(FPDF_PAGE page, FPDF_PAGEOBJECT page_obj) {
     return false;
 
   CPDF_Page* pPage = CPDFPageFromFPDFPage(page);
-  if (!IsPageObject(pPage))
+  if (!IsEditablePageObject(pPage))
     return false;
 
   return pPage->RemovePageObject(pPageObj);
@@ -279,6 +286,25 @@ FPDF_EXPORT FPDF_PAGEOBJECT FPDF_CALLCONV FPDFPage_GetObject(FPDF_PAGE page,
   return FPDFPageObjectFromCPDFPageObject(pPage->GetPageObjectByIndex(index));
 }
 
+FPDF_EXPORT unsigned long FPDF_CALLCONV
+FPDFPage_GetObjectsInRect(FPDF_PAGE page,
+                          const FS_RECTF* rect,
+                          FPDF_PAGEOBJECT* objects,
+                          unsigned long length) {
+  CPDF_Page* pPage = CPDFPageFromFPDFPage(page);
+  if (!IsPageObject(pPage) || !rect)
+    return 0;
+
+  CFX_FloatRect region = CFXFloatRectFromFSRectF(*rect);
+  region.Normalize();
+  std::vector<CPDF_PageObject*> found = pPage->GetPageObjectsInRect(region);
+  if (objects && length >= found.size()) {
+    for (size_t i = 0; i < found.size(); ++i)
+      objects[i] = FPDFPageObjectFromCPDFPageObject(found[i]);
+  }
+  return found.size();
+}
+
 FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV FPDFPage_HasTransparency(FPDF_PAGE page) {
   CPDF_Page* pPage = CPDFPageFromFPDFPage(page);
   return pPage && pPage->BackgroundAlphaNeeded();
@@ -379,7 +405,7 @@ FPDFPageObjMark_GetParamKey(FPDF_PAGEOBJECTMARK mark,
     return false;
 
   CPDF_DictionaryLocker locker(pParams);
-  for (auto& it : locker) {
+  for (const auto& it : locker) {
     if (index == 0) {
       *out_buflen = Utf16EncodeMaybeCopyAndReturnLength(
           WideString::FromUTF8(it.first.AsStringView()), buffer, buflen);
@@ -590,7 +616,7 @@ FPDF_EXPORT int FPDF_CALLCONV FPDFPageObj_GetType(FPDF_PAGEOBJECT page_object) {
 
 FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV FPDFPage_GenerateContent(FPDF_PAGE page) {
   CPDF_Page* pPage = CPDFPageFromFPDFPage(page);
-  if (!IsPageObject(pPage))
+  if (!IsEditablePageObject(pPage))
     return false;
 
   CPDF_PageContentGenerator CG(pPage);
@@ -668,6 +694,7 @@ FPDF_EXPORT void FPDF_CALLCONV FPDFPage_SetRotation(FPDF_PAGE page,
   rotate %= 4;
   pPage->GetDict()->SetNewFor<CPDF_Number>(pdfium::page_object::kRotate,
                                            rotate * 90);
+  pPage->GetDocument()->MarkIndirectObjectDirty(pPage->GetDict()->GetObjNum());
   pPage->UpdateDimensions();
 }
 
@@ -208,6 +208,7 @@ void SetPageContents(const ByteString& key,
         0, NewIndirectContentsStream(pDocument, "q")->MakeReference(pDocument));
     pContentsArray->Append(
         NewIndirectContentsStream(pDocument, "Q")->MakeReference(pDocument));
+    pDocument->MarkIndirectObjectDirty(pContentsArray->GetObjNum());
   } else {
     ByteString sStream = "q\n";
     {
@@ -217,6 +218,7 @@ void SetPageContents(const ByteString& key,
       sStream += "\nQ";
     }
     pContentsStream->SetDataAndRemoveFilter(sStream.raw_span());
+    pDocument->MarkIndirectObjectDirty(pContentsStream->GetObjNum());
     pContentsArray = pDocument->NewIndirect<CPDF_Array>();
     pContentsArray->AppendNew<CPDF_Reference>(pDocument,
                                               pContentsStream->GetObjNum());
@@ -320,11 +322,14 @@ FPDF_EXPORT int FPDF_CALLCONV FPDFPage_Flatten(FPDF_PAGE page, int nFlag) {
   }
 
   SetPageContents(key, pPageDict, pDocument);
+  pDocument->MarkIndirectObjectDirty(pPageDict->GetObjNum());
+  pDocument->MarkIndirectObjectDirty(pRes->GetObjNum());
 
   CPDF_Dictionary* pNewXORes = nullptr;
   if (!key.IsEmpty()) {
     pPageXObject->SetNewFor<CPDF_Reference>(key, pDocument,
                                             pNewXObject->GetObjNum());
+    pDocument->MarkIndirectObjectDirty(pPageXObject->GetObjNum());
 
     CPDF_Dictionary* pNewOXbjectDic = pNewXObject->GetDict();
     pNewXORes = pNewOXbjectDic->SetNewFor<CPDF_Dictionary>("Resources");
@@ -403,6 +408,7 @@ FPDF_EXPORT int FPDF_CALLCONV FPDFPage_Flatten(FPDF_PAGE page, int nFlag) {
     ByteString sFormName = ByteString::Format("F%d", i);
     pXObject->SetNewFor<CPDF_Reference>(sFormName, pDocument,
                                         pObj->GetObjNum());
+    pDocument->MarkIndirectObjectDirty(pObj->GetObjNum());
 
     ByteString sStream;
     {
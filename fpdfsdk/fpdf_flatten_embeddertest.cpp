@@ -3,7 +3,9 @@
 // found in the LICENSE file.
 
 #include "build/build_config.h"
+#include "public/fpdf_annot.h"
 #include "public/fpdf_flatten.h"
+#include "public/fpdf_save.h"
 #include "public/fpdfview.h"
 #include "testing/embedder_test.h"
 #include "testing/gtest/include/gtest/gtest.h"
@@ -150,3 +152,26 @@ TEST_F(FPDFFlattenEmbedderTest, BUG_896366) {
 
   VerifySavedDocument(612, 792, kChecksum);
 }
+
+TEST_F(FPDFFlattenEmbedderTest, FlatPrintAndIncrementalSave) {
+#if defined(_SKIA_SUPPORT_) || defined(_SKIA_SUPPORT_PATHS_)
+  static constexpr char kChecksum[] = "c3cccfadc4c5249e6aa0675e511fa4c3";
+#else
+  static constexpr char kChecksum[] = "f71ab085c52c8445ae785eca3ec858b1";
+#endif
+  ASSERT_TRUE(OpenDocument("bug_896366.pdf"));
+  FPDF_PAGE page = LoadPage(0);
+  ASSERT_TRUE(page);
+  EXPECT_EQ(FLATTEN_SUCCESS, FPDFPage_Flatten(page, FLAT_PRINT));
+  EXPECT_TRUE(FPDF_SaveAsCopy(document(), this, FPDF_INCREMENTAL));
+  UnloadPage(page);
+
+  // The page keeps the flattened content and loses its annotations.
+  ASSERT_TRUE(OpenSavedDocument());
+  FPDF_PAGE saved_page = LoadSavedPage(0);
+  ASSERT_TRUE(saved_page);
+  EXPECT_EQ(0, FPDFPage_GetAnnotCount(saved_page));
+  VerifySavedRendering(saved_page, 612, 792, kChecksum);
+  CloseSavedPage(saved_page);
+  CloseSavedDocument();
+}
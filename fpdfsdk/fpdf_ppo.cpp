@@ -761,5 +761,6 @@ FPDF_CopyViewerPreferences(FPDF_DOCUMENT dest_doc, FPDF_DOCUMENT src_doc) {
     return false;
 
   pDstDict->SetFor("ViewerPreferences", pSrcDict->CloneDirectObject());
+  pDstDoc->MarkIndirectObjectDirty(pDstDict->GetObjNum());
   return true;
 }
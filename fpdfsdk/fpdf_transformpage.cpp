@@ -36,6 +36,7 @@ void SetBoundingBox(CPDF_Page* page,
     return;
 
   page->GetDict()->SetRectFor(key, rect);
+  page->GetDocument()->MarkIndirectObjectDirty(page->GetDict()->GetObjNum());
   page->UpdateDimensions();
 }
 
@@ -243,6 +244,7 @@ FPDFPage_TransFormWithClip(FPDF_PAGE page,
   if (CPDF_Array* pContentArray = ToArray(pContentObj)) {
     pContentArray->InsertNewAt<CPDF_Reference>(0, pDoc, pStream->GetObjNum());
     pContentArray->AppendNew<CPDF_Reference>(pDoc, pEndStream->GetObjNum());
+    pDoc->MarkIndirectObjectDirty(pContentArray->GetObjNum());
   } else if (pContentObj->IsStream() && !pContentObj->IsInline()) {
     pContentArray = pDoc->NewIndirect<CPDF_Array>();
     pContentArray->AppendNew<CPDF_Reference>(pDoc, pStream->GetObjNum());
@@ -251,6 +253,7 @@ FPDFPage_TransFormWithClip(FPDF_PAGE page,
     pPageDict->SetNewFor<CPDF_Reference>(pdfium::page_object::kContents, pDoc,
                                          pContentArray->GetObjNum());
   }
+  pDoc->MarkIndirectObjectDirty(pPageDict->GetObjNum());
 
   // Need to transform the patterns as well.
   CPDF_Dictionary* pRes =
@@ -279,6 +282,10 @@ FPDFPage_TransFormWithClip(FPDF_PAGE page,
     if (matrix) {
       CFX_Matrix m = CFXMatrixFromFSMatrix(*matrix);
       pDict->SetMatrixFor("Matrix", pDict->GetMatrixFor("Matrix") * m);
+      // Direct patterns live in the first indirect object that holds them.
+      pDoc->MarkIndirectObjectDirty(pObj->GetObjNum());
+      pDoc->MarkIndirectObjectDirty(pPatternDict->GetObjNum());
+      pDoc->MarkIndirectObjectDirty(pRes->GetObjNum());
     }
   }
 
@@ -417,6 +424,7 @@ FPDF_EXPORT void FPDF_CALLCONV FPDFPage_InsertClipPath(FPDF_PAGE page,
 
   if (CPDF_Array* pArray = ToArray(pContentObj)) {
     pArray->InsertNewAt<CPDF_Reference>(0, pDoc, pStream->GetObjNum());
+    pDoc->MarkIndirectObjectDirty(pArray->GetObjNum());
   } else if (pContentObj->IsStream() && !pContentObj->IsInline()) {
     CPDF_Array* pContentArray = pDoc->NewIndirect<CPDF_Array>();
     pContentArray->AppendNew<CPDF_Reference>(pDoc, pStream->GetObjNum());
@@ -424,4 +432,5 @@ FPDF_EXPORT void FPDF_CALLCONV FPDFPage_InsertClipPath(FPDF_PAGE page,
     pPageDict->SetNewFor<CPDF_Reference>(pdfium::page_object::kContents, pDoc,
                                          pContentArray->GetObjNum());
   }
+  pDoc->MarkIndirectObjectDirty(pPageDict->GetObjNum());
 }
@@ -4,7 +4,10 @@
 
 #include "public/fpdf_transformpage.h"
 
+#include <string>
+
 #include "build/build_config.h"
+#include "public/fpdf_save.h"
 #include "testing/embedder_test.h"
 #include "testing/embedder_test_constants.h"
 
@@ -473,6 +476,50 @@ TEST_F(FPDFTransformEmbedderTest, TransFormWithClipAndSave) {
   }
 }
 
+TEST_F(FPDFTransformEmbedderTest, TransFormWithClipAndIncrementalSave) {
+  ASSERT_TRUE(OpenDocument("rectangles.pdf"));
+  FPDF_PAGE page = LoadPage(0);
+  ASSERT_TRUE(page);
+  const FS_MATRIX half_matrix{0.5, 0, 0, 0.5, 0, 0};
+  EXPECT_TRUE(FPDFPage_TransFormWithClip(page, &half_matrix, nullptr));
+  UnloadPage(page);
+
+  // The new content streams are only reachable through the edited page.
+  EXPECT_TRUE(FPDF_SaveAsCopy(document(), this, FPDF_INCREMENTAL));
+  VerifySavedDocument(200, 300, kShrunkMD5);
+}
+
+TEST_F(FPDFTransformEmbedderTest, ClipPathAndIncrementalSave) {
+  ASSERT_TRUE(OpenDocument("rectangles.pdf"));
+  FPDF_PAGE page = LoadPage(0);
+  ASSERT_TRUE(page);
+  {
+    ScopedFPDFClipPath clip(FPDF_CreateClipPath(10.0f, 10.0f, 90.0f, 90.0f));
+    ASSERT_TRUE(clip);
+    FPDFPage_InsertClipPath(page, clip.get());
+  }
+  UnloadPage(page);
+
+  // Render the clipped page after a full save.
+  std::string full_save_md5;
+  EXPECT_TRUE(FPDF_SaveAsCopy(document(), this, 0));
+  {
+    ASSERT_TRUE(OpenSavedDocument());
+    FPDF_PAGE saved_page = LoadSavedPage(0);
+    ASSERT_TRUE(saved_page);
+    ScopedFPDFBitmap bitmap = RenderSavedPageWithFlags(saved_page, FPDF_ANNOT);
+    full_save_md5 = HashBitmap(bitmap.get());
+    EXPECT_NE(kRectanglesChecksum, full_save_md5);
+    CloseSavedPage(saved_page);
+    CloseSavedDocument();
+  }
+
+  // An incremental save renders the same.
+  ClearString();
+  EXPECT_TRUE(FPDF_SaveAsCopy(document(), this, FPDF_INCREMENTAL));
+  VerifySavedDocument(200, 300, full_save_md5.c_str());
+}
+
 #if defined(OS_LINUX) || defined(OS_CHROMEOS) || defined(OS_FUCHSIA)
 TEST_F(FPDFTransformEmbedderTest, TransFormWithClipAndSaveWithLocale) {
   pdfium::base::ScopedLocale scoped_locale("da_DK.UTF-8");
@@ -32,6 +32,7 @@
 #include "core/fpdfapi/render/cpdf_renderoptions.h"
 #include "core/fpdfdoc/cpdf_nametree.h"
 #include "core/fpdfdoc/cpdf_viewerpreferences.h"
+#include "core/fxcodec/flate/flatemodule.h"
 #include "core/fxcrt/cfx_readonlymemorystream.h"
 #include "core/fxcrt/fx_safe_types.h"
 #include "core/fxcrt/fx_stream.h"
@@ -140,7 +141,9 @@ std::vector<XFAPacket> GetXFAPackets(const CPDF_Object* xfa_object) {
 
 FPDF_DOCUMENT LoadDocumentImpl(
     const RetainPtr<IFX_SeekableReadStream>& pFileAccess,
-    FPDF_BYTESTRING password) {
+    FPDF_BYTESTRING password,
+    pdfium::span<const uint8_t> xref_cache = {},
+    bool use_object_arena = false) {
   if (!pFileAccess) {
     ProcessParseError(CPDF_Parser::FILE_ERROR);
     return nullptr;
@@ -149,8 +152,14 @@ FPDF_DOCUMENT LoadDocumentImpl(
   auto pDocument =
       std::make_unique<CPDF_Document>(std::make_unique<CPDF_DocRenderData>(),
                                       std::make_unique<CPDF_DocPageData>());
-
-  CPDF_Parser::Error error = pDocument->LoadDoc(pFileAccess, password);
+  if (use_object_arena)
+    pDocument->EnableObjectArena();
+
+  CPDF_Parser::Error error =
+      xref_cache.empty()
+          ? pDocument->LoadDoc(pFileAccess, password)
+          : pDocument->LoadDocWithCrossRefCache(pFileAccess, password,
+                                                xref_cache);
   if (error != CPDF_Parser::SUCCESS) {
     ProcessParseError(error);
     return nullptr;
@@ -184,6 +193,14 @@ FPDF_InitLibraryWithConfig(const FPDF_LIBRARY_CONFIG* config) {
     IJS_Runtime::Initialize(config->m_v8EmbedderSlot, config->m_pIsolate,
                             platform);
   }
+  if (config && config->version >= 4) {
+    CPDF_DocPageData::SetDecodedStreamCacheLimit(
+        config->m_DecodedStreamCacheLimit);
+  }
+  if (config && config->version >= 5) {
+    FlateModule::SetParallelDecodeEnabled(
+        !!config->m_EnableParallelFlateDecode);
+  }
   g_bLibraryInitialized = true;
 }
 
@@ -198,6 +215,9 @@ FPDF_EXPORT void FPDF_CALLCONV FPDF_DestroyLibrary() {
   CPDF_PageModule::Destroy();
   CFX_GEModule::Destroy();
   IJS_Runtime::Destroy();
+  FlateModule::SetParallelDecodeEnabled(false);
+  CPDF_DocPageData::SetDecodedStreamCacheLimit(
+      CPDF_DocPageData::kDefaultDecodedStreamCacheLimit);
 
   g_bLibraryInitialized = false;
 }
@@ -236,6 +256,63 @@ FPDF_LoadDocument(FPDF_STRING file_path, FPDF_BYTESTRING password) {
                           password);
 }
 
+FPDF_EXPORT FPDF_DOCUMENT FPDF_CALLCONV
+FPDF_LoadDocumentWithXRefCache(FPDF_STRING file_path,
+                               FPDF_BYTESTRING password,
+                               const void* cache,
+                               unsigned long cache_size) {
+  return LoadDocumentImpl(
+      IFX_SeekableReadStream::CreateFromFilename(file_path), password,
+      pdfium::make_span(static_cast<const uint8_t*>(cache),
+                        cache ? cache_size : 0));
+}
+
+FPDF_EXPORT FPDF_DOCUMENT FPDF_CALLCONV
+FPDF_LoadDocumentWithObjectArena(FPDF_STRING file_path,
+                                 FPDF_BYTESTRING password) {
+  return LoadDocumentImpl(IFX_SeekableReadStream::CreateFromFilename(file_path),
+                          password, {}, /*use_object_arena=*/true);
+}
+
+FPDF_EXPORT FPDF_DOCUMENT FPDF_CALLCONV
+FPDF_LoadMappedDocument(FPDF_STRING file_path, FPDF_BYTESTRING password) {
+  return LoadDocumentImpl(
+      IFX_SeekableReadStream::CreateMappedFromFilename(file_path), password);
+}
+
+FPDF_EXPORT unsigned long FPDF_CALLCONV
+FPDF_GetXRefCache(FPDF_DOCUMENT document, void* buffer, unsigned long buflen) {
+  CPDF_Document* pDoc = CPDFDocumentFromFPDFDocument(document);
+  if (!pDoc || !pDoc->GetParser())
+    return 0;
+
+  std::vector<uint8_t> cache = pDoc->GetParser()->SerializeCrossRefCache();
+  const unsigned long cache_size = pdfium::CollectionSize<unsigned long>(cache);
+  if (buffer && buflen >= cache_size && !cache.empty())
+    memcpy(buffer, cache.data(), cache_size);
+  return cache_size;
+}
+
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV
+FPDF_GetDecodedStreamCacheStats(FPDF_DOCUMENT document,
+                                unsigned long* hits,
+                                unsigned long* misses) {
+  CPDF_Document* pDoc = CPDFDocumentFromFPDFDocument(document);
+  if (!pDoc)
+    return false;
+
+  const CPDF_DocPageData* pPageData = CPDF_DocPageData::FromDocument(pDoc);
+  if (hits) {
+    *hits = pdfium::base::saturated_cast<unsigned long>(
+        pPageData->GetDecodedStreamCacheHits());
+  }
+  if (misses) {
+    *misses = pdfium::base::saturated_cast<unsigned long>(
+        pPageData->GetDecodedStreamCacheMisses());
+  }
+  return true;
+}
+
 FPDF_EXPORT int FPDF_CALLCONV FPDF_GetFormType(FPDF_DOCUMENT document) {
   const CPDF_Document* pDoc = CPDFDocumentFromFPDFDocument(document);
   if (!pDoc)
@@ -369,7 +446,12 @@ FPDF_EXPORT FPDF_PAGE FPDF_CALLCONV FPDF_LoadPage(FPDF_DOCUMENT document,
 
   auto pPage = pdfium::MakeRetain<CPDF_Page>(pDoc, pDict);
   pPage->SetRenderCache(std::make_unique<CPDF_PageRenderCache>(pPage.Get()));
-  pPage->ParseContent();
+  // Progressive rendering parses the content of pages whose data arrives
+  // asynchronously, since it can wait for the data.
+  if (pDoc->GetParser() && pDoc->GetParser()->IsDataLoadedAsynchronously())
+    pPage->StartParseContent();
+  else
+    pPage->ParseContent();
   return FPDFPageFromIPDFPage(pPage.Leak());
 }
 
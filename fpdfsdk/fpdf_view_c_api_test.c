@@ -117,6 +117,7 @@ int CheckPDFiumCApi() {
     CHK(FPDFCatalog_IsTagged);
 
     // fpdf_dataavail.h
+    CHK(FPDFAvail_ContinueParsePage);
     CHK(FPDFAvail_Create);
     CHK(FPDFAvail_Destroy);
     CHK(FPDFAvail_GetDocument);
@@ -125,6 +126,8 @@ int CheckPDFiumCApi() {
     CHK(FPDFAvail_IsFormAvail);
     CHK(FPDFAvail_IsLinearized);
     CHK(FPDFAvail_IsPageAvail);
+    CHK(FPDFAvail_SetAsyncDownloadHints);
+    CHK(FPDFAvail_SetPrefetchPageCount);
 
     // fpdf_doc.h
     CHK(FPDFAction_GetDest);
@@ -211,6 +214,7 @@ int CheckPDFiumCApi() {
     CHK(FPDFPage_Delete);
     CHK(FPDFPage_GenerateContent);
     CHK(FPDFPage_GetObject);
+    CHK(FPDFPage_GetObjectsInRect);
     CHK(FPDFPage_GetRotation);
     CHK(FPDFPage_HasTransparency);
     CHK(FPDFPage_InsertObject);
@@ -441,6 +445,7 @@ int CheckPDFiumCApi() {
 #ifdef PDF_ENABLE_V8
     CHK(FPDF_GetArrayBufferAllocatorSharedInstance);
 #endif
+    CHK(FPDF_GetDecodedStreamCacheStats);
     CHK(FPDF_GetDocPermissions);
     CHK(FPDF_GetFileVersion);
     CHK(FPDF_GetLastError);
@@ -462,10 +467,14 @@ int CheckPDFiumCApi() {
     CHK(FPDF_GetXFAPacketContent);
     CHK(FPDF_GetXFAPacketCount);
     CHK(FPDF_GetXFAPacketName);
+    CHK(FPDF_GetXRefCache);
     CHK(FPDF_InitLibrary);
     CHK(FPDF_InitLibraryWithConfig);
     CHK(FPDF_LoadCustomDocument);
     CHK(FPDF_LoadDocument);
+    CHK(FPDF_LoadDocumentWithObjectArena);
+    CHK(FPDF_LoadDocumentWithXRefCache);
+    CHK(FPDF_LoadMappedDocument);
     CHK(FPDF_LoadMemDocument);
     CHK(FPDF_LoadMemDocument64);
     CHK(FPDF_LoadPage);
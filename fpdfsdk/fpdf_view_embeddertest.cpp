@@ -10,6 +10,7 @@
 
 #include "build/build_config.h"
 #include "core/fpdfapi/parser/cpdf_document.h"
+#include "core/fpdfapi/parser/cpdf_parser.h"
 #include "fpdfsdk/cpdfsdk_helpers.h"
 #include "fpdfsdk/fpdf_view_c_api_test.h"
 #include "public/cpp/fpdf_scopers.h"
@@ -359,6 +360,91 @@ TEST_F(FPDFViewEmbedderTest, LoadDocument64) {
   EXPECT_EQ(14, version);
 }
 
+TEST_F(FPDFViewEmbedderTest, LoadDocumentWithObjectArena) {
+  std::string file_path;
+  ASSERT_TRUE(PathService::GetTestFilePath("rectangles.pdf", &file_path));
+
+  ScopedFPDFDocument doc(
+      FPDF_LoadDocumentWithObjectArena(file_path.c_str(), nullptr));
+  ASSERT_TRUE(doc);
+  ASSERT_EQ(1, FPDF_GetPageCount(doc.get()));
+
+  {
+    ScopedFPDFPage page(FPDF_LoadPage(doc.get(), 0));
+    ASSERT_TRUE(page);
+    ScopedFPDFBitmap bitmap = RenderPage(page.get());
+    CompareBitmap(bitmap.get(), 200, 300, pdfium::kRectanglesChecksum);
+  }
+
+  // Closing the document releases the arena along with the objects in it.
+  doc.reset();
+}
+
+TEST_F(FPDFViewEmbedderTest, LoadDocumentWithXRefCache) {
+  std::string file_path;
+  ASSERT_TRUE(PathService::GetTestFilePath("rectangles.pdf", &file_path));
+
+  std::vector<uint8_t> cache;
+  {
+    ScopedFPDFDocument doc(FPDF_LoadDocument(file_path.c_str(), nullptr));
+    ASSERT_TRUE(doc);
+    unsigned long cache_size = FPDF_GetXRefCache(doc.get(), nullptr, 0);
+    ASSERT_GT(cache_size, 0u);
+    cache.resize(cache_size);
+    EXPECT_EQ(cache_size,
+              FPDF_GetXRefCache(doc.get(), cache.data(), cache.size()));
+  }
+
+  {
+    ScopedFPDFDocument doc(FPDF_LoadDocumentWithXRefCache(
+        file_path.c_str(), nullptr, cache.data(), cache.size()));
+    ASSERT_TRUE(doc);
+    EXPECT_TRUE(CPDFDocumentFromFPDFDocument(doc.get())
+                    ->GetParser()
+                    ->loaded_from_cross_ref_cache());
+    ASSERT_EQ(1, FPDF_GetPageCount(doc.get()));
+    ScopedFPDFPage page(FPDF_LoadPage(doc.get(), 0));
+    ASSERT_TRUE(page);
+    ScopedFPDFBitmap bitmap = RenderPage(page.get());
+    CompareBitmap(bitmap.get(), 200, 300, pdfium::kRectanglesChecksum);
+  }
+
+  // The cache does not match another file, which loads as usual.
+  std::string other_path;
+  ASSERT_TRUE(PathService::GetTestFilePath("hello_world.pdf", &other_path));
+  {
+    ScopedFPDFDocument doc(FPDF_LoadDocumentWithXRefCache(
+        other_path.c_str(), nullptr, cache.data(), cache.size()));
+    ASSERT_TRUE(doc);
+    EXPECT_FALSE(CPDFDocumentFromFPDFDocument(doc.get())
+                     ->GetParser()
+                     ->loaded_from_cross_ref_cache());
+    ScopedFPDFPage page(FPDF_LoadPage(doc.get(), 0));
+    ASSERT_TRUE(page);
+    ScopedFPDFBitmap bitmap = RenderPage(page.get());
+    CompareBitmap(bitmap.get(), 200, 200, pdfium::kHelloWorldChecksum);
+  }
+}
+
+TEST_F(FPDFViewEmbedderTest, LoadMappedDocument) {
+  std::string file_path;
+  ASSERT_TRUE(PathService::GetTestFilePath("rectangles.pdf", &file_path));
+
+  ScopedFPDFDocument doc(FPDF_LoadMappedDocument(file_path.c_str(), nullptr));
+  ASSERT_TRUE(doc);
+  ASSERT_EQ(1, FPDF_GetPageCount(doc.get()));
+
+  ScopedFPDFPage page(FPDF_LoadPage(doc.get(), 0));
+  ASSERT_TRUE(page);
+  ScopedFPDFBitmap bitmap = RenderPage(page.get());
+  CompareBitmap(bitmap.get(), 200, 300, pdfium::kRectanglesChecksum);
+}
+
+TEST_F(FPDFViewEmbedderTest, LoadNonexistentMappedDocument) {
+  EXPECT_FALSE(FPDF_LoadMappedDocument("nonexistent_document.pdf", ""));
+  EXPECT_EQ(static_cast<int>(FPDF_GetLastError()), FPDF_ERR_FILE);
+}
+
 TEST_F(FPDFViewEmbedderTest, LoadNonexistentDocument) {
   FPDF_DOCUMENT doc = FPDF_LoadDocument("nonexistent_document.pdf", "");
   ASSERT_FALSE(doc);
@@ -493,6 +579,36 @@ TEST_F(FPDFViewEmbedderTest, Page) {
   EXPECT_FALSE(LoadPage(1));
 }
 
+TEST_F(FPDFViewEmbedderTest, DecodedStreamCacheStats) {
+  unsigned long hits;
+  unsigned long misses;
+  EXPECT_FALSE(FPDF_GetDecodedStreamCacheStats(nullptr, &hits, &misses));
+
+  ASSERT_TRUE(OpenDocument("hello_world.pdf"));
+  ASSERT_TRUE(FPDF_GetDecodedStreamCacheStats(document(), &hits, &misses));
+  EXPECT_EQ(0u, hits);
+  EXPECT_EQ(0u, misses);
+
+  // Loading the page decodes its content stream.
+  FPDF_PAGE page = LoadPage(0);
+  ASSERT_TRUE(page);
+  UnloadPage(page);
+  ASSERT_TRUE(FPDF_GetDecodedStreamCacheStats(document(), &hits, &misses));
+  EXPECT_EQ(0u, hits);
+  EXPECT_EQ(1u, misses);
+
+  // Loading it again reuses the decoded content stream.
+  page = LoadPage(0);
+  ASSERT_TRUE(page);
+  UnloadPage(page);
+  ASSERT_TRUE(FPDF_GetDecodedStreamCacheStats(document(), &hits, &misses));
+  EXPECT_EQ(1u, hits);
+  EXPECT_EQ(1u, misses);
+
+  // Null out-parameters are allowed.
+  EXPECT_TRUE(FPDF_GetDecodedStreamCacheStats(document(), nullptr, nullptr));
+}
+
 TEST_F(FPDFViewEmbedderTest, ViewerRefDummy) {
   ASSERT_TRUE(OpenDocument("about_blank.pdf"));
   EXPECT_TRUE(FPDF_VIEWERREF_GetPrintScaling(document()));
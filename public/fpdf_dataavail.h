@@ -159,6 +159,63 @@ FPDF_EXPORT int FPDF_CALLCONV FPDFAvail_IsPageAvail(FPDF_AVAIL avail,
                                                     int page_index,
                                                     FX_DOWNLOADHINTS* hints);
 
+// Experimental API.
+// Set how many pages after the one passed to FPDFAvail_IsPageAvail() to
+// request data for as well.
+//
+//   avail      - handle to document availability provider.
+//   page_count - number of following pages to request. Zero, the default,
+//                turns prefetching off.
+//
+// Only applies to linearized documents with hint tables. For those, when the
+// page passed to FPDFAvail_IsPageAvail() is not yet available, its
+// |FX_DOWNLOADHINTS| also cover up to |page_count| following pages. Nearby
+// sections are merged into larger ones, and sections are reported in page
+// order, so applications fetching them one request at a time need fewer
+// requests to read through a document.
+FPDF_EXPORT void FPDF_CALLCONV FPDFAvail_SetPrefetchPageCount(FPDF_AVAIL avail,
+                                                              int page_count);
+
+// Experimental API.
+// Let pages of the document from FPDFAvail_GetDocument() load and render
+// before all of their data is available.
+//
+//   avail - handle to document availability provider.
+//   hints - download hints that receive requests for unavailable data from
+//           here on, whenever no other FPDFAvail_*() call is running, or
+//           NULL to turn this off. Must stay valid until |avail| is
+//           destroyed or this is called again.
+//
+// With |hints| set, FPDF_LoadPage() does not parse the page content. Instead,
+// FPDF_RenderPageBitmap_Start() and FPDF_RenderPage_Continue() parse it as
+// they render, and return FPDF_RENDER_TOBECONTINUED when the data of the next
+// content stream is not available, after requesting it through |hints|.
+// Applications should call FPDF_RenderPage_Continue() again once new data
+// arrives. Data other than content streams, like fonts and images, is
+// requested when first needed, but not waited for.
+//
+// Until the content of such a page is fully parsed, other functions only see
+// the page objects parsed so far, and functions that edit the page content
+// fail. Use FPDFAvail_ContinueParsePage() to parse pages that are not
+// rendered progressively.
+FPDF_EXPORT void FPDF_CALLCONV
+FPDFAvail_SetAsyncDownloadHints(FPDF_AVAIL avail, FX_DOWNLOADHINTS* hints);
+
+// Experimental API.
+// Parse as much of the content of |page| as the available data allows. Only
+// needed for pages loaded while async download hints were set with
+// FPDFAvail_SetAsyncDownloadHints(). FPDF_LoadPage() fully parses all other
+// pages.
+//
+//   page - handle to a page.
+//
+// Returns one of:
+//   PDF_DATA_ERROR: |page| is invalid.
+//   PDF_DATA_NOTAVAIL: Parsing waits for data that has been requested
+//                      through the hints. Call this again once it arrives.
+//   PDF_DATA_AVAIL: The page content is fully parsed.
+FPDF_EXPORT int FPDF_CALLCONV FPDFAvail_ContinueParsePage(FPDF_PAGE page);
+
 // Check if form data is ready for initialization, if not, get the
 // |FX_DOWNLOADHINTS|.
 //
@@ -150,6 +150,10 @@ FPDF_EXPORT void FPDF_CALLCONV FPDFPage_SetRotation(FPDF_PAGE page, int rotate);
 //   page     - handle to a page
 //   page_obj - handle to a page object. The |page_obj| will be automatically
 //              freed.
+//
+// Pages whose content is still being parsed, see
+// FPDFAvail_ContinueParsePage(), cannot be edited. |page_obj| is freed
+// without being inserted.
 FPDF_EXPORT void FPDF_CALLCONV FPDFPage_InsertObject(FPDF_PAGE page,
                                                      FPDF_PAGEOBJECT page_obj);
 
@@ -159,7 +163,8 @@ FPDF_EXPORT void FPDF_CALLCONV FPDFPage_InsertObject(FPDF_PAGE page,
 //   page     - handle to a page
 //   page_obj - handle to a page object to be removed.
 //
-// Returns TRUE on success.
+// Returns TRUE on success. Fails for pages whose content is still being
+// parsed, see FPDFAvail_ContinueParsePage().
 //
 // Ownership is transferred to the caller. Call FPDFPageObj_Destroy() to free
 // it.
@@ -182,6 +187,25 @@ FPDF_EXPORT int FPDF_CALLCONV FPDFPage_CountObjects(FPDF_PAGE page);
 FPDF_EXPORT FPDF_PAGEOBJECT FPDF_CALLCONV FPDFPage_GetObject(FPDF_PAGE page,
                                                              int index);
 
+// Experimental API.
+// Get the objects in |page| whose bounding boxes intersect |rect|, in the
+// order they are painted. On pages with many objects, this avoids checking
+// every object, which makes it suitable for hit-testing and for working on a
+// region of the page. If |length| is less than the returned count, or
+// |objects| is NULL, |objects| will not be modified.
+//
+//   page    - handle to a page.
+//   rect    - the region, in page coordinates.
+//   objects - buffer for holding the page object handles.
+//   length  - length of |objects| in page object handles.
+//
+// Returns the number of objects that intersect |rect|, or 0 on failure.
+FPDF_EXPORT unsigned long FPDF_CALLCONV
+FPDFPage_GetObjectsInRect(FPDF_PAGE page,
+                          const FS_RECTF* rect,
+                          FPDF_PAGEOBJECT* objects,
+                          unsigned long length);
+
 // Checks if |page| contains transparency.
 //
 //   page - handle to a page.
@@ -193,7 +217,8 @@ FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV FPDFPage_HasTransparency(FPDF_PAGE page);
 //
 //   page - handle to a page.
 //
-// Returns TRUE on success.
+// Returns TRUE on success. Fails for pages whose content is still being
+// parsed, see FPDFAvail_ContinueParsePage().
 //
 // Before you save the page to a file, or reload the page, you must call
 // |FPDFPage_GenerateContent| or any changes to |page| will be lost.
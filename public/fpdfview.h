@@ -247,6 +247,21 @@ typedef struct FPDF_LIBRARY_CONFIG_ {
   // Pointer to the V8::Platform to use.
   void* m_pPlatform;
 
+  // Version 4 - Experimental.
+
+  // Limit, in bytes, on the total size of the decoded content streams and
+  // form XObjects each document keeps for reuse across pages. 0 disables the
+  // cache. Versions below 4 use a default of 16 MiB.
+  unsigned long m_DecodedStreamCacheLimit;
+
+  // Version 5 - Experimental.
+
+  // Non-zero to let large Flate streams written with full flushes be
+  // decoded on several threads. This speeds up opening such streams on
+  // machines with at least 4 cores, at the cost of more total CPU time.
+  // Versions below 5 leave this off.
+  FPDF_BOOL m_EnableParallelFlateDecode;
+
 } FPDF_LIBRARY_CONFIG;
 
 // Function: FPDF_InitLibraryWithConfig
@@ -258,6 +273,13 @@ typedef struct FPDF_LIBRARY_CONFIG_ {
 // Comments:
 //          You have to call this function before you can call any PDF
 //          processing functions.
+//
+//          The library is not thread-safe. All calls, including calls on
+//          different documents, must be made from one thread at a time.
+//          Pages of one document share cached resources (fonts, images,
+//          color spaces) that are filled in lazily during rendering, so
+//          they cannot be rendered concurrently. To render many pages in
+//          parallel, run one instance of the library per process.
 FPDF_EXPORT void FPDF_CALLCONV
 FPDF_InitLibraryWithConfig(const FPDF_LIBRARY_CONFIG* config);
 
@@ -362,6 +384,123 @@ FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV FPDF_SetPrintMode(int mode);
 FPDF_EXPORT FPDF_DOCUMENT FPDF_CALLCONV
 FPDF_LoadDocument(FPDF_STRING file_path, FPDF_BYTESTRING password);
 
+// Experimental API.
+// Function: FPDF_LoadDocumentWithXRefCache
+//          Open and load a PDF document, reusing a cross-reference cache
+//          previously returned by FPDF_GetXRefCache() for the same file.
+// Parameters:
+//          file_path  -  Path to the PDF file (including extension).
+//          password   -  A string used as the password for the PDF file.
+//                        If no password is needed, empty or NULL can be used.
+//          cache      -  Pointer to the cross-reference cache, or NULL.
+//          cache_size -  Size of |cache| in bytes.
+// Return value:
+//          A handle to the loaded document, or NULL on failure.
+// Comments:
+//          The cache is checked against the file's size and a SHA-256 digest
+//          of its first and last bytes and of every cross-reference section
+//          the table was read from. If the table had to be rebuilt from a
+//          damaged file, the digest covers the whole file instead. If the cache
+//          does not match, or is malformed, the cross-reference table is parsed
+//          from the file as usual. Caches are not used for linearized
+//          documents.
+//
+//          The check does not cover the objects themselves. A file rewritten
+//          in place so that objects moved, while its size, its first and last
+//          bytes and its cross-reference sections stayed the same, would be
+//          read at stale offsets. Embedders that keep caches on disk should
+//          also key them on the file's identity and modification time.
+//
+//          See the comments for FPDF_LoadDocument() regarding the encoding for
+//          |password|.
+FPDF_EXPORT FPDF_DOCUMENT FPDF_CALLCONV
+FPDF_LoadDocumentWithXRefCache(FPDF_STRING file_path,
+                               FPDF_BYTESTRING password,
+                               const void* cache,
+                               unsigned long cache_size);
+
+// Experimental API.
+// Function: FPDF_LoadDocumentWithObjectArena
+//          Open and load a PDF document that will mostly be read, allocating
+//          the objects parsed from it out of a per-document arena.
+// Parameters:
+//          file_path  -  Path to the PDF file (including extension).
+//          password   -  A string used as the password for the PDF file.
+//                        If no password is needed, empty or NULL can be used.
+// Return value:
+//          A handle to the loaded document, or NULL on failure.
+// Comments:
+//          Parsed objects are packed into large blocks, which cuts the number
+//          of allocations and speeds up FPDF_CloseDocument(). Memory of
+//          objects that are removed or replaced while the document is open is
+//          only reclaimed once the rest of their block is gone, so documents
+//          that will be edited heavily should use FPDF_LoadDocument().
+//
+//          See the comments for FPDF_LoadDocument() regarding the encoding for
+//          |password|.
+FPDF_EXPORT FPDF_DOCUMENT FPDF_CALLCONV
+FPDF_LoadDocumentWithObjectArena(FPDF_STRING file_path,
+                                 FPDF_BYTESTRING password);
+
+// Experimental API.
+// Function: FPDF_LoadMappedDocument
+//          Open and load a PDF document by mapping the file into memory.
+// Parameters:
+//          file_path  -  Path to the PDF file (including extension).
+//          password   -  A string used as the password for the PDF file.
+//                        If no password is needed, empty or NULL can be used.
+// Return value:
+//          A handle to the loaded document, or NULL on failure.
+// Comments:
+//          Where the platform supports it, the parser reads the file straight
+//          out of the mapping instead of copying it into buffers, which saves
+//          system calls and memory for large files.
+//
+//          Only use this for files that are not modified until the document
+//          is closed. On POSIX systems, accessing a mapped file that has been
+//          truncated terminates the process with SIGBUS. Files that are not
+//          regular files, or that are world-writable, are read as with
+//          FPDF_LoadDocument() instead, as is every file on platforms without
+//          mapping support.
+//
+//          See the comments for FPDF_LoadDocument() regarding the encoding for
+//          |password|.
+FPDF_EXPORT FPDF_DOCUMENT FPDF_CALLCONV
+FPDF_LoadMappedDocument(FPDF_STRING file_path, FPDF_BYTESTRING password);
+
+// Experimental API.
+// Function: FPDF_GetXRefCache
+//          Serialize the resolved cross-reference table and trailer of a
+//          loaded document, for use with FPDF_LoadDocumentWithXRefCache().
+// Parameters:
+//          document -  Handle to a document loaded from a file or memory.
+//          buffer   -  A buffer for the cache. May be NULL.
+//          buflen   -  The length of |buffer| in bytes.
+// Return value:
+//          The number of bytes in the cache, or 0 on failure. |buffer| is only
+//          modified if |buflen| is at least the returned value.
+FPDF_EXPORT unsigned long FPDF_CALLCONV
+FPDF_GetXRefCache(FPDF_DOCUMENT document, void* buffer, unsigned long buflen);
+
+// Experimental API.
+// Function: FPDF_GetDecodedStreamCacheStats
+//          Get the number of lookups in a document's decoded stream cache.
+// Parameters:
+//          document -  Handle to a document.
+//          hits     -  Receives the number of decoded streams that were
+//                      reused. May be NULL.
+//          misses   -  Receives the number of cacheable streams that had to
+//                      be decoded. May be NULL.
+// Return value:
+//          True on success, false if |document| is invalid.
+// Comments:
+//          The cache limit is set by |m_DecodedStreamCacheLimit| in
+//          FPDF_LIBRARY_CONFIG.
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV
+FPDF_GetDecodedStreamCacheStats(FPDF_DOCUMENT document,
+                                unsigned long* hits,
+                                unsigned long* misses);
+
 // Function: FPDF_LoadMemDocument
 //          Open and load a PDF document from memory.
 // Parameters:
@@ -889,6 +1028,11 @@ FPDF_EXPORT void FPDF_CALLCONV FPDF_RenderPageBitmap(FPDF_BITMAP bitmap,
 //                          widget and popup annotations.
 // Return value:
 //          None. Note that behavior is undefined if det of |matrix| is 0.
+// Comments:
+//          Page objects that lie entirely outside |clipping| are skipped. A
+//          large page can therefore be rendered tile by tile: wrap each tile
+//          of the destination buffer with FPDFBitmap_CreateEx(), translate
+//          |matrix| by the negated tile origin, and clip to the tile bounds.
 FPDF_EXPORT void FPDF_CALLCONV
 FPDF_RenderPageBitmapWithMatrix(FPDF_BITMAP bitmap,
                                 FPDF_PAGE page,
@@ -0,0 +1,44 @@
+// Copyright 2021 The PDFium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <cstdint>
+#include <vector>
+
+#include "core/fxcodec/flate/predictor.h"
+#include "third_party/base/check.h"
+#include "third_party/base/span.h"
+
+// Checks that the SIMD predictor code matches the scalar code.
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+  static constexpr size_t kParameterSize = 3;
+  if (size < kParameterSize)
+    return 0;
+
+  const uint8_t filter_type = data[0] % 6;
+  const uint32_t bytes_per_pixel = data[1] % 8 + 1;
+  const bool has_prev = data[2] & 0x01;
+  pdfium::span<const uint8_t> input(data + kParameterSize,
+                                    size - kParameterSize);
+
+  // The first half of the input is the previous row, if any.
+  pdfium::span<const uint8_t> prev;
+  if (has_prev) {
+    prev = input.first(input.size() / 2);
+    input = input.subspan(prev.size(), prev.size());
+  }
+
+  std::vector<uint8_t> dest(input.size());
+  std::vector<uint8_t> expected(input.size());
+  fxcodec::PngUnfilterRow(filter_type, input, prev, bytes_per_pixel, dest);
+  fxcodec::PngUnfilterRowScalarForTesting(filter_type, input, prev,
+                                          bytes_per_pixel, expected);
+  CHECK(dest == expected);
+
+  dest.assign(input.begin(), input.end());
+  expected.assign(input.begin(), input.end());
+  fxcodec::TiffUnpredictRow8(dest, bytes_per_pixel);
+  fxcodec::TiffUnpredictRow8ScalarForTesting(expected, bytes_per_pixel);
+  CHECK(dest == expected);
+  return 0;
+}